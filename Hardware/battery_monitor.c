@@ -8,57 +8,41 @@
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "esp_adc/adc_oneshot.h"
-#include "esp_adc/adc_cali.h"
-#include "esp_adc/adc_cali_scheme.h"
-#include "adc_shared.h"
+#include "hal.h"
+#include "sensors.h"
 #include "esp_log.h"
+#include "trace.h"
 
 static const char *TAG = "BATTERY";
 
-static adc_oneshot_unit_handle_t S_ADC_HANDLE = NULL;
-static adc_cali_handle_t S_CALI_HANDLE = NULL;
-static adc_channel_t S_BATT_CH = ADC_CHANNEL_4;
+static int S_BATT_CH = 4;
 static float S_DIVIDER = 2.0f;
 static float S_VMIN = 3.0f;
 static float S_VMAX = 4.2f;
 static uint32_t S_INTERVAL_MS = 2000;
 
-void battery_monitor_init(adc_channel_t channel, float divider, float vmin, float vmax) {
+void battery_monitor_init(int channel, float divider, float vmin, float vmax) {
     ESP_LOGI(TAG, "初始化电池监控ADC");
     S_BATT_CH = channel;
     S_DIVIDER = divider;
     S_VMIN = vmin;
     S_VMAX = vmax;
     
-    // 复用全局 Oneshot ADC
-    adc_shared_init_unit();
-    S_ADC_HANDLE = adc_shared_unit();
-
-    adc_oneshot_chan_cfg_t chan_cfg = {
-        .bitwidth = ADC_BITWIDTH_DEFAULT,
-        .atten = ADC_ATTEN_DB_12,
-    };
-    adc_oneshot_config_channel(S_ADC_HANDLE, S_BATT_CH, &chan_cfg);
-
-    // 复用全局校准
-    adc_shared_init_cali();
-    S_CALI_HANDLE = adc_shared_cali();
+    // 复用全局 Oneshot ADC 与校准
+    hal_adc_channel_init(S_BATT_CH);
     
     ESP_LOGI(TAG, "电池监控ADC初始化完成");
 }
 
+float battery_voltage_from_mv(int mv) {
+    return (mv * S_DIVIDER) / 1000.0f;
+}
+
+// 已注册到采集服务时读缓存，否则（如自检阶段）直接采样
 float battery_read_voltage(void) {
-    int adc_raw = 0;
-    adc_oneshot_read(S_ADC_HANDLE, S_BATT_CH, &adc_raw);
-    int voltage_mv = 0;
-    if (S_CALI_HANDLE) {
-        adc_cali_raw_to_voltage(S_CALI_HANDLE, adc_raw, &voltage_mv);
-    } else {
-        voltage_mv = (int)((adc_raw * 3300) / 4095);
-    }
-    float battery_voltage = (voltage_mv * S_DIVIDER) / 1000.0f;
-    return battery_voltage;
+    sensor_reading_t r;
+    if (sensors_get(S_BATT_CH, &r)) return r.value;
+    return battery_voltage_from_mv(hal_adc_raw_to_mv(hal_adc_read_raw(S_BATT_CH)));
 }
 
 float battery_voltage_to_percentage(float voltage) {
@@ -70,25 +54,16 @@ float battery_voltage_to_percentage(float voltage) {
 
 void battery_monitor_task(void *pvParameters) {
     ESP_LOGI(TAG, "电池监控任务启动");
+    sensors_add_channel(S_BATT_CH, SENSOR_BATTERY, S_INTERVAL_MS);
     while (1) {
-        float voltage = battery_read_voltage();
-        float percentage = battery_voltage_to_percentage(voltage);
-        int adc_raw = 0;
-        adc_oneshot_read(S_ADC_HANDLE, S_BATT_CH, &adc_raw);
-        printf("=== 电池状态监控 ===\n");
-        printf("电池电压: %.2f V\n", voltage);
-        printf("电池电量: %.0f%%\n", percentage);
-        printf("ADC原始值: %d\n", adc_raw);
-        printf("-------------------\n");
-        ESP_LOGI(TAG, "电池电压: %.2fV, 电量: %.0f%%, ADC: %d", voltage, percentage, adc_raw);
-        if (percentage > 80) {
-            ESP_LOGI(TAG, "电池电量充足 ✓");
-        } else if (percentage > 50) {
-            ESP_LOGI(TAG, "电池电量良好");
-        } else if (percentage > 20) {
-            ESP_LOGW(TAG, "电池电量偏低 ⚠️");
-        } else {
-            ESP_LOGE(TAG, "电池电量严重不足！请立即充电 ⚠️⚠️⚠️");
+        sensor_reading_t r;
+        sensors_get(S_BATT_CH, &r);
+        float percentage = battery_voltage_to_percentage(r.value);
+        TRACE(BATT_SAMPLE, trace_f(r.value), trace_f(percentage), trace_i(r.raw));
+        if (percentage <= 20) {
+            TRACE(BATT_CRITICAL, trace_f(percentage));
+        } else if (percentage <= 50) {
+            TRACE(BATT_LOW, trace_f(percentage));
         }
         vTaskDelay(pdMS_TO_TICKS(S_INTERVAL_MS));
     }
@@ -1,10 +1,15 @@
 #ifndef BUZZER_H
 #define BUZZER_H
 
+#include <stdbool.h>
+
 // 初始化蜂鸣器（传入GPIO编号，例：7）
 void buzzer_init(int gpio);
 
-// 蜂鸣报警 (1s)
+// 蜂鸣报警 (1s，阻塞)
 void buzzer_alarm(void);
 
+// 直接开/关（非阻塞，供周期任务按节奏驱动）
+void buzzer_set(bool on);
+
 #endif
@@ -1,15 +1,17 @@
 #include "display.h"
 #include "esp_log.h"
-#include "driver/i2c.h"
+#include "hal.h"
+#include "display_font.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include <stdio.h>
+#include <stdbool.h>
 #include <string.h>
-#include <ctype.h>
 
 static const char *TAG = "DISPLAY";
 
 // ===== SSD1306 基本定义 =====
-static i2c_port_t S_I2C_PORT = I2C_NUM_0;
+static int S_I2C_PORT = 0;
 static int S_I2C_SDA_IO = -1;
 static int S_I2C_SCL_IO = -1;
 static uint32_t S_I2C_CLK_HZ = 400000;
@@ -18,204 +20,332 @@ static uint8_t S_OLED_I2C_ADDR = 0x3C;
 #define OLED_CMD            0x00
 #define OLED_DATA           0x40
 
+static volatile bool s_ready = false;      // display_init 完成（可在独立任务中执行）
+
+// 帧缓冲、影子缓冲与 I2C 刷新的互斥：控制任务仪表盘、HTTP /api/oled、外设基准可并发绘制
+// 递归锁：组合绘制（清屏+文字+刷新）整体持锁，内部再调用公开的绘制函数
+static SemaphoreHandle_t s_lock = NULL;
+static inline void disp_lock(void) { if (s_lock) xSemaphoreTakeRecursive(s_lock, portMAX_DELAY); }
+static inline void disp_unlock(void) { if (s_lock) xSemaphoreGiveRecursive(s_lock); }
+
 static inline esp_err_t i2c_write_cmd(uint8_t cmd) {
     uint8_t buf[2] = {OLED_CMD, cmd};
-    return i2c_master_write_to_device(S_I2C_PORT, S_OLED_I2C_ADDR, buf, sizeof(buf), 1000 / portTICK_PERIOD_MS);
-}
-
-static inline esp_err_t i2c_write_data(const uint8_t *data, size_t len) {
-    // 逐块写入，保证前缀 0x40
-    esp_err_t err = ESP_OK;
-    uint8_t block[17];
-    block[0] = OLED_DATA;
-    while (len) {
-        size_t n = len > 16 ? 16 : len;
-        memcpy(&block[1], data, n);
-        err = i2c_master_write_to_device(S_I2C_PORT, S_OLED_I2C_ADDR, block, n + 1, 1000 / portTICK_PERIOD_MS);
-        if (err != ESP_OK) return err;
-        data += n;
-        len -= n;
-    }
-    return err;
+    return hal_i2c_write(S_I2C_PORT, S_OLED_I2C_ADDR, buf, sizeof(buf), 1000);
 }
 
+// ===== 帧缓冲：绘制只改 RAM，display_flush 按页比较影子缓冲，只发送变化的列区间 =====
+static uint8_t s_fb[DISPLAY_PAGES][DISPLAY_WIDTH];      // 待显示内容
+static uint8_t s_panel[DISPLAY_PAGES][DISPLAY_WIDTH];   // 屏上已有内容（上次刷新结果）
+
 static void oled_set_pos(uint8_t x, uint8_t page) {
-    i2c_write_cmd(0xB0 | (page & 0x07));
-    i2c_write_cmd(0x00 | (x & 0x0F));
-    i2c_write_cmd(0x10 | ((x >> 4) & 0x0F));
+    uint8_t cmd[4] = { OLED_CMD, (uint8_t)(0xB0 | (page & 0x07)), (uint8_t)(0x00 | (x & 0x0F)), (uint8_t)(0x10 | ((x >> 4) & 0x0F)) };
+    hal_i2c_write(S_I2C_PORT, S_OLED_I2C_ADDR, cmd, sizeof(cmd), 1000);
 }
 
+// 整页写入一次事务：控制字节 + 最多 128 字节数据
+static void oled_write_span(uint8_t page, uint8_t x0, uint8_t x1) {
+    uint8_t buf[DISPLAY_WIDTH + 1];
+    size_t n = (size_t)(x1 - x0 + 1);
+    buf[0] = OLED_DATA;
+    memcpy(&buf[1], &s_fb[page][x0], n);
+    oled_set_pos(x0, page);
+    hal_i2c_write(S_I2C_PORT, S_OLED_I2C_ADDR, buf, n + 1, 1000);
+    // 影子缓冲记录实际发出的内容
+    memcpy(&s_panel[page][x0], &buf[1], n);
+}
+
+// 全屏清零（初始化用）：不经比较，保证屏与影子缓冲一致
 static void oled_clear_all(void) {
-    for (uint8_t page = 0; page < 8; page++) {
-        oled_set_pos(0, page);
-        uint8_t zeros[128] = {0};
-        i2c_write_data(zeros, sizeof(zeros));
-    }
+    memset(s_fb, 0, sizeof(s_fb));
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) oled_write_span(page, 0, DISPLAY_WIDTH - 1);
 }
 
-// 5x7 字模：覆盖数字、常用符号与全部大写字母，未知字符按空格处理
-static const uint8_t* glyph5x7(char c) {
-    // 数字
-    static const uint8_t d0[5] = {0x3E,0x51,0x49,0x45,0x3E};
-    static const uint8_t d1[5] = {0x00,0x42,0x7F,0x40,0x00};
-    static const uint8_t d2[5] = {0x42,0x61,0x51,0x49,0x46};
-    static const uint8_t d3[5] = {0x21,0x41,0x45,0x4B,0x31};
-    static const uint8_t d4[5] = {0x18,0x14,0x12,0x7F,0x10};
-    static const uint8_t d5[5] = {0x27,0x45,0x45,0x45,0x39};
-    static const uint8_t d6[5] = {0x3C,0x4A,0x49,0x49,0x30};
-    static const uint8_t d7[5] = {0x01,0x71,0x09,0x05,0x03};
-    static const uint8_t d8[5] = {0x36,0x49,0x49,0x49,0x36};
-    static const uint8_t d9[5] = {0x06,0x49,0x49,0x29,0x1E};
-    // 符号/空白
-    static const uint8_t sp[5] = {0x00,0x00,0x00,0x00,0x00};
-    static const uint8_t colon[5] = {0x00,0x36,0x36,0x00,0x00};
-    static const uint8_t dot[5] = {0x00,0x40,0x60,0x00,0x00};
-    static const uint8_t percent[5] = {0x62,0x64,0x08,0x13,0x23};
-    static const uint8_t minus_[5] = {0x08,0x08,0x08,0x08,0x08};
-    static const uint8_t excl_[5]  = {0x00,0x00,0x5F,0x00,0x00};
-    static const uint8_t ques_[5]  = {0x02,0x01,0x51,0x09,0x06};
-    static const uint8_t slash_[5] = {0x20,0x10,0x08,0x04,0x02};
-    // 大写 A-Z
-    static const uint8_t Aa[5] = {0x7E,0x09,0x09,0x09,0x7E};
-    static const uint8_t Bb[5] = {0x7F,0x49,0x49,0x49,0x36};
-    static const uint8_t Cc[5] = {0x3E,0x41,0x41,0x41,0x22};
-    static const uint8_t Dd[5] = {0x7F,0x41,0x41,0x22,0x1C};
-    static const uint8_t Ee[5] = {0x7F,0x49,0x49,0x49,0x41};
-    static const uint8_t Ff[5] = {0x7F,0x09,0x09,0x09,0x01};
-    static const uint8_t Gg[5] = {0x3E,0x41,0x49,0x49,0x7A};
-    static const uint8_t Hh[5] = {0x7F,0x08,0x08,0x08,0x7F};
-    static const uint8_t Ii[5] = {0x00,0x41,0x7F,0x41,0x00};
-    static const uint8_t Jj[5] = {0x20,0x40,0x41,0x3F,0x01};
-    static const uint8_t Kk[5] = {0x7F,0x08,0x14,0x22,0x41};
-    static const uint8_t Ll[5] = {0x7F,0x40,0x40,0x40,0x40};
-    static const uint8_t Mm[5] = {0x7F,0x02,0x04,0x02,0x7F};
-    static const uint8_t Nn[5] = {0x7F,0x04,0x08,0x10,0x7F};
-    static const uint8_t Oo[5] = {0x3E,0x41,0x41,0x41,0x3E};
-    static const uint8_t Pp[5] = {0x7F,0x09,0x09,0x09,0x06};
-    static const uint8_t Qq[5] = {0x3E,0x41,0x51,0x21,0x5E};
-    static const uint8_t Rr[5] = {0x7F,0x09,0x19,0x29,0x46};
-    static const uint8_t Ss[5] = {0x22,0x49,0x49,0x49,0x31};
-    static const uint8_t Tt[5] = {0x01,0x01,0x7F,0x01,0x01};
-    static const uint8_t Uu[5] = {0x7F,0x40,0x40,0x40,0x7F};
-    static const uint8_t Vv[5] = {0x3F,0x40,0x40,0x20,0x1F};
-    static const uint8_t Ww[5] = {0x7F,0x20,0x18,0x20,0x7F};
-    static const uint8_t Xx[5] = {0x63,0x14,0x08,0x14,0x63};
-    static const uint8_t Yy[5] = {0x07,0x08,0x70,0x08,0x07};
-    static const uint8_t Zz[5] = {0x61,0x51,0x49,0x45,0x43};
-
-    unsigned char uc = (unsigned char)c;
-    if (uc>='a' && uc<='z') uc = (unsigned char)toupper(uc);
-    switch (uc) {
-        case '0': return d0; case '1': return d1; case '2': return d2; case '3': return d3; case '4': return d4;
-        case '5': return d5; case '6': return d6; case '7': return d7; case '8': return d8; case '9': return d9;
-        case ' ': return sp; case ':': return colon; case '.': return dot; case '%': return percent; case '-': return minus_; case '!': return excl_; case '?': return ques_; case '/': return slash_;
-        case 'A': return Aa; case 'B': return Bb; case 'C': return Cc; case 'D': return Dd; case 'E': return Ee;
-        case 'F': return Ff; case 'G': return Gg; case 'H': return Hh; case 'I': return Ii; case 'J': return Jj;
-        case 'K': return Kk; case 'L': return Ll; case 'M': return Mm; case 'N': return Nn; case 'O': return Oo;
-        case 'P': return Pp; case 'Q': return Qq; case 'R': return Rr; case 'S': return Ss; case 'T': return Tt;
-        case 'U': return Uu; case 'V': return Vv; case 'W': return Ww; case 'X': return Xx; case 'Y': return Yy; case 'Z': return Zz;
-        default:  return sp;
+void display_flush(void) {
+    if (!s_ready) return;
+    disp_lock();
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) {
+        int x0 = 0, x1 = DISPLAY_WIDTH - 1;
+        while (x0 < DISPLAY_WIDTH && s_fb[page][x0] == s_panel[page][x0]) x0++;
+        if (x0 == DISPLAY_WIDTH) continue;
+        while (s_fb[page][x1] == s_panel[page][x1]) x1--;
+        oled_write_span(page, (uint8_t)x0, (uint8_t)x1);
     }
+    disp_unlock();
 }
 
-static void draw_char5x7(uint8_t x, uint8_t y, char c) {
-    const uint8_t *g = glyph5x7(c);
-    uint8_t page = y >> 3;      // 每页 8 像素
-    uint8_t offset = y & 0x07;  // 页内位移
+// 不经比较整屏重写（基准测试用），返回发送的 I2C 字节数（含寻址命令）；未就绪返回 0
+size_t display_flush_full(void) {
+    if (!s_ready) return 0;
+    disp_lock();
+    for (uint8_t page = 0; page < DISPLAY_PAGES; page++) oled_write_span(page, 0, DISPLAY_WIDTH - 1);
+    disp_unlock();
+    return (size_t)DISPLAY_PAGES * (4 + DISPLAY_WIDTH + 1);
+}
+
+static bool s_trend_drawn = false;          // 帧缓冲中的趋势区与历史一致
+
+void display_fb_clear(void) {
+    disp_lock();
+    memset(s_fb, 0, sizeof(s_fb));
+    s_trend_drawn = false;
+    disp_unlock();
+}
 
-    uint8_t lower[6];
-    uint8_t upper[6];
-    for (int i = 0; i < 5; i++) {
-        uint8_t raw = g[i];
-        lower[i] = raw << offset;
-        upper[i] = (offset == 0) ? 0x00 : (raw >> (8 - offset));
+// 按列写入字模：pages 页高的列数据（每页 w 字节连续存放），按 y 的页内偏移拆到相邻两页
+static void fb_blit(int x, int y, const uint8_t *cols, int w, int pages) {
+    int page = y >> 3, shift = y & 0x07;
+    for (int p = 0; p < pages; p++) {
+        const uint8_t *src = cols + p * w;
+        int pg = page + p;
+        for (int i = 0; i < w; i++) {
+            int cx = x + i;
+            if (cx < 0 || cx >= DISPLAY_WIDTH) continue;
+            if (pg >= 0 && pg < DISPLAY_PAGES) s_fb[pg][cx] |= (uint8_t)(src[i] << shift);
+            if (shift && pg + 1 < DISPLAY_PAGES) s_fb[pg + 1][cx] |= (uint8_t)(src[i] >> (8 - shift));
+        }
     }
-    lower[5] = 0x00;
-    upper[5] = 0x00;
-
-    oled_set_pos(x, page);
-    i2c_write_data(lower, 6);
-    if (offset && page < 7) {
-        oled_set_pos(x, page + 1);
-        i2c_write_data(upper, 6);
+}
+
+// 取下一个字符：ASCII 原样；'°'（UTF-8 C2 B0 或 Latin-1 B0）返回 0xB0；其余多字节字符整体按 '?' 处理
+static unsigned char next_char(const char **ps) {
+    const unsigned char *p = (const unsigned char *)*ps;
+    unsigned char c = *p++;
+    if (c == 0xC2 && *p == 0xB0) {
+        p++;
+        c = 0xB0;
+    } else if (c >= 0x80 && c != 0xB0) {
+        while ((*p & 0xC0) == 0x80) p++;
+        c = '?';
     }
+    *ps = (const char *)p;
+    return c;
 }
 
-static void draw_text(uint8_t x, uint8_t y, const char *s) {
-    while (*s) {
-        draw_char5x7(x, y, *s++);
-        x += 6; // 5 列字形 + 1 列间距
-        if (x > 122) break;
+static const uint8_t *glyph5x7(unsigned char c) {
+    if (c == 0xB0) return FONT5X7[FONT5X7_DEGREE - FONT5X7_FIRST];
+    if (c < FONT5X7_FIRST || c >= FONT5X7_DEGREE) c = '?';
+    return FONT5X7[c - FONT5X7_FIRST];
+}
+
+int display_draw_text(int x, int y, const char *s) {
+    disp_lock();
+    while (*s && x < DISPLAY_WIDTH) {
+        fb_blit(x, y, glyph5x7(next_char(&s)), FONT5X7_W, 1);
+        x += FONT5X7_W + 1;     // 5 列字形 + 1 列间距
+    }
+    disp_unlock();
+    return x;
+}
+
+int display_draw_large(int x, int y, const char *s) {
+    disp_lock();
+    while (*s && x < DISPLAY_WIDTH) {
+        unsigned char c = next_char(&s);
+        const char *hit = c ? strchr(FONT12X16_CHARS, (char)c) : NULL;
+        if (!hit) hit = strchr(FONT12X16_CHARS, ' ');
+        fb_blit(x, y, FONT12X16[hit - FONT12X16_CHARS], FONT12X16_W, 2);
+        x += font12x16_advance((char)c);
     }
+    disp_unlock();
+    return x;
 }
 
 void display_clear(void) {
-    oled_clear_all();
+    if (!s_ready) return;
+    disp_lock();
+    display_fb_clear();
+    display_flush();
+    disp_unlock();
 }
 
 void display_show_text(const char *line1, const char *line2, const char *line3) {
-    oled_clear_all();
-    if (line1) draw_text(0, 0, line1);
-    if (line2) draw_text(0, 16, line2);
-    if (line3) draw_text(0, 32, line3);
+    if (!s_ready) return;
+    disp_lock();
+    display_fb_clear();
+    if (line1) display_draw_text(0, 0, line1);
+    if (line2) display_draw_text(0, 16, line2);
+    if (line3) display_draw_text(0, 32, line3);
+    display_flush();
+    disp_unlock();
+}
+
+// ===== 趋势图：底部 DISPLAY_TREND_PAGES 页，扫描式逐列更新 =====
+// 不用 SSD1306 硬件滚动：其按帧周期连续移动、无法单步一列，且停止滚动后须重写显存。
+// 改为示波器式扫描：新样本写入光标列并擦除其右侧一列作为间隙，每个样本只改 2 列。
+#define TREND_Y0    ((DISPLAY_PAGES - DISPLAY_TREND_PAGES) * 8)
+#define TREND_H     (DISPLAY_TREND_PAGES * 8)
+
+static int16_t s_trend_t[DISPLAY_WIDTH];    // 温度历史（0.1°C，按列存放）
+static int16_t s_trend_sp[DISPLAY_WIDTH];   // 设定值历史
+static int s_trend_x = 0;                   // 下一个样本写入的列
+static int s_trend_n = 0;                   // 有效列数
+static int s_trend_lo = 0, s_trend_hi = 1;  // 纵轴范围（0.1°C）
+
+static void trend_clear_col(int x) {
+    for (int p = DISPLAY_PAGES - DISPLAY_TREND_PAGES; p < DISPLAY_PAGES; p++) s_fb[p][x] = 0;
+}
+
+static inline void fb_pixel(int x, int y) { s_fb[y >> 3][x] |= (uint8_t)(1u << (y & 0x07)); }
+
+static int trend_row(int v) {
+    int r = (v - s_trend_lo) * (TREND_H - 1) / (s_trend_hi - s_trend_lo);
+    if (r < 0) r = 0;
+    if (r > TREND_H - 1) r = TREND_H - 1;
+    return TREND_Y0 + TREND_H - 1 - r;
+}
+
+// 画一列：设定值为虚线，温度与前一列相连成竖线段
+static void trend_draw_col(int x) {
+    trend_clear_col(x);
+    if (x >= s_trend_n) return;
+    if (!(x & 1)) fb_pixel(x, trend_row(s_trend_sp[x]));
+    int y = trend_row(s_trend_t[x]);
+    int prev = x ? x - 1 : DISPLAY_WIDTH - 1;
+    // 光标列（最旧样本，即将被覆盖）的前一列是最新样本，不相连
+    int y0 = (prev < s_trend_n && x != s_trend_x) ? trend_row(s_trend_t[prev]) : y;
+    for (int r = (y0 < y ? y0 : y); r <= (y0 < y ? y : y0); r++) fb_pixel(x, r);
+}
+
+static void trend_redraw(void) {
+    for (int x = 0; x < DISPLAY_WIDTH; x++) trend_draw_col(x);
+    if (s_trend_n == DISPLAY_WIDTH) trend_clear_col(s_trend_x);
+    s_trend_drawn = true;
+}
+
+// 按历史数据确定纵轴：上下各留 1°C，跨度不小于 DISPLAY_TREND_MIN_SPAN_C；范围变化返回 true
+static bool trend_fit(void) {
+    int lo = INT16_MAX, hi = INT16_MIN;
+    for (int i = 0; i < s_trend_n; i++) {
+        int a = s_trend_t[i] < s_trend_sp[i] ? s_trend_t[i] : s_trend_sp[i];
+        int b = s_trend_t[i] < s_trend_sp[i] ? s_trend_sp[i] : s_trend_t[i];
+        if (a < lo) lo = a;
+        if (b > hi) hi = b;
+    }
+    lo -= 10;
+    hi += 10;
+    int min_span = (int)(DISPLAY_TREND_MIN_SPAN_C * 10);
+    if (hi - lo < min_span) {
+        int mid = (lo + hi) / 2;
+        lo = mid - min_span / 2;
+        hi = lo + min_span;
+    }
+    if (lo == s_trend_lo && hi == s_trend_hi) return false;
+    s_trend_lo = lo;
+    s_trend_hi = hi;
+    return true;
+}
+
+static int16_t to_decideg(float v) {
+    v *= 10.0f;
+    if (v > 30000.0f) v = 30000.0f;
+    if (v < -30000.0f) v = -30000.0f;
+    return (int16_t)(v < 0 ? v - 0.5f : v + 0.5f);
+}
+
+void display_trend_push(float temp, float setpoint) {
+    if (!s_ready) return;
+    disp_lock();
+    int x = s_trend_x;
+    s_trend_t[x] = to_decideg(temp);
+    s_trend_sp[x] = to_decideg(setpoint);
+    if (s_trend_n < DISPLAY_WIDTH) s_trend_n++;
+    s_trend_x = (x + 1) % DISPLAY_WIDTH;
+
+    // 超出纵轴或每扫完一屏时重新定标（仅此时整区重画）
+    int lo = s_trend_t[x] < s_trend_sp[x] ? s_trend_t[x] : s_trend_sp[x];
+    int hi = s_trend_t[x] < s_trend_sp[x] ? s_trend_sp[x] : s_trend_t[x];
+    bool refit = s_trend_n == 1 || lo < s_trend_lo || hi > s_trend_hi || s_trend_x == 0;
+    if ((refit && trend_fit()) || !s_trend_drawn) {
+        trend_redraw();
+    } else {
+        trend_draw_col(x);
+        if (s_trend_n == DISPLAY_WIDTH) trend_clear_col(s_trend_x);
+    }
+    disp_unlock();
+}
+
+void display_trend_reset(void) {
+    disp_lock();
+    s_trend_x = 0;
+    s_trend_n = 0;
+    s_trend_drawn = false;
+    disp_unlock();
+}
+
+void display_dashboard(const char *big, const char *line1, const char *line2, const char *line3) {
+    if (!s_ready) return;
+    disp_lock();
+    // 只清文字区；趋势区保留，被其它界面覆盖过时按历史重画
+    memset(s_fb, 0, sizeof(s_fb[0]) * (DISPLAY_PAGES - DISPLAY_TREND_PAGES));
+    if (!s_trend_drawn) trend_redraw();
+    if (big) display_draw_large(0, 0, big);
+    if (line1) display_draw_text(0, 16, line1);
+    if (line2) display_draw_text(0, 24, line2);
+    if (line3) display_draw_text(0, 32, line3);
+    display_flush();
+    disp_unlock();
 }
 
 // 初始化I2C和OLED（SSD1306）
-void display_init(i2c_port_t port, int sda_io, int scl_io, uint32_t clk_hz, uint8_t addr) {
+void display_init(int port, int sda_io, int scl_io, uint32_t clk_hz, uint8_t addr) {
     S_I2C_PORT = port;
     S_I2C_SDA_IO = sda_io;
     S_I2C_SCL_IO = scl_io;
     S_I2C_CLK_HZ = clk_hz;
     S_OLED_I2C_ADDR = addr;
+    if (!s_lock) s_lock = xSemaphoreCreateRecursiveMutex();
 
-    i2c_config_t conf = {
-        .mode = I2C_MODE_MASTER,
-        .sda_io_num = S_I2C_SDA_IO,
-        .scl_io_num = S_I2C_SCL_IO,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = S_I2C_CLK_HZ,
-    };
-    i2c_param_config(S_I2C_PORT, &conf);
-    i2c_driver_install(S_I2C_PORT, conf.mode, 0, 0, 0);
+    hal_i2c_master_init(S_I2C_PORT, S_I2C_SDA_IO, S_I2C_SCL_IO, S_I2C_CLK_HZ);
 
     // 发送 I2C START/STOP 探测设备是否在线（调试日志）
     uint8_t dummy = 0x00;
-    esp_err_t probe = i2c_master_write_to_device(S_I2C_PORT, S_OLED_I2C_ADDR, &dummy, 0, 100 / portTICK_PERIOD_MS);
+    esp_err_t probe = hal_i2c_write(S_I2C_PORT, S_OLED_I2C_ADDR, &dummy, 0, 100);
     if (probe != ESP_OK) {
         ESP_LOGW(TAG, "OLED 0x%02X 未响应，检查I2C连线/上拉/地址", S_OLED_I2C_ADDR);
     }
 
-    // SSD1306 初始化序列（兼容 128x64 常见模块）
-    i2c_write_cmd(0xAE);                    // display off
-    i2c_write_cmd(0xD5); i2c_write_cmd(0x80); // display clock divide
-    i2c_write_cmd(0xA8); i2c_write_cmd(0x3F); // multiplex ratio: 1/64
-    i2c_write_cmd(0xD3); i2c_write_cmd(0x00); // display offset
-    i2c_write_cmd(0x40);                    // start line = 0
-    i2c_write_cmd(0x8D); i2c_write_cmd(0x14); // charge pump enable
-    i2c_write_cmd(0x20); i2c_write_cmd(0x00); // memory mode: horizontal addressing
-    i2c_write_cmd(0xA1);                    // segment remap (flip X)
-    i2c_write_cmd(0xC8);                    // COM scan direction remap (flip Y)
-    i2c_write_cmd(0xDA); i2c_write_cmd(0x12); // COM pins hardware config
-    i2c_write_cmd(0x81); i2c_write_cmd(0x7F); // contrast
-    i2c_write_cmd(0xD9); i2c_write_cmd(0xF1); // pre-charge
-    i2c_write_cmd(0xDB); i2c_write_cmd(0x40); // VCOM detect
-    i2c_write_cmd(0xA4);                    // resume to RAM content display
-    i2c_write_cmd(0xA6);                    // normal display (not inverted)
-    i2c_write_cmd(0xAF);                    // display ON
+    // SSD1306 初始化序列（兼容 128x64 常见模块）：控制字节 0x00 后连续命令，一次事务写完
+    static const uint8_t init_seq[] = {
+        OLED_CMD,
+        0xAE,                   // display off
+        0xD5, 0x80,             // display clock divide
+        0xA8, 0x3F,             // multiplex ratio: 1/64
+        0xD3, 0x00,             // display offset
+        0x40,                   // start line = 0
+        0x8D, 0x14,             // charge pump enable
+        0x20, 0x02,             // memory mode: page addressing（B0~B7/列地址命令按页定位）
+        0xA1,                   // segment remap (flip X)
+        0xC8,                   // COM scan direction remap (flip Y)
+        0xDA, 0x12,             // COM pins hardware config
+        0x81, 0x7F,             // contrast
+        0xD9, 0xF1,             // pre-charge
+        0xDB, 0x40,             // VCOM detect
+        0xA4,                   // resume to RAM content display
+        0xA6,                   // normal display (not inverted)
+    };
+    hal_i2c_write(S_I2C_PORT, S_OLED_I2C_ADDR, init_seq, sizeof(init_seq), 1000);
 
+    // 先清显存再开显示，避免上电残影；清屏完成前其它显示调用直接返回
+    disp_lock();
     oled_clear_all();
+    i2c_write_cmd(0xAF);                    // display ON
+    s_ready = true;
+    disp_unlock();
     ESP_LOGI(TAG, "OLED initialized (SSD1306 @0x%02X)", S_OLED_I2C_ADDR);
 }
 
 // 更新显示：三行基本文本
 void display_update(float temp, float setpoint, float battery) {
     char line[32];
-    oled_clear_all();
-    snprintf(line, sizeof(line), "Temp: %.1fC", temp);
-    draw_text(0, 0, line);
-    snprintf(line, sizeof(line), "Set : %.1fC", setpoint);
-    draw_text(0, 16, line);
+    if (!s_ready) return;
+    disp_lock();
+    display_fb_clear();
+    snprintf(line, sizeof(line), "Temp: %.1f\xC2\xB0""C", temp);
+    display_draw_text(0, 0, line);
+    snprintf(line, sizeof(line), "Set : %.1f\xC2\xB0""C", setpoint);
+    display_draw_text(0, 16, line);
     snprintf(line, sizeof(line), "Batt: %.0f%%", battery);
-    draw_text(0, 32, line);
+    display_draw_text(0, 32, line);
+    display_flush();
+    disp_unlock();
 }
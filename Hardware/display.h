@@ -1,11 +1,11 @@
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
-// 需要 I2C 类型定义
-#include "driver/i2c.h"
+#include <stdint.h>
+#include <stddef.h>
 
-// 初始化OLED（I2C 端口/引脚/频率/设备地址）
-void display_init(i2c_port_t port, int sda_io, int scl_io, uint32_t clk_hz, uint8_t addr);
+// 初始化OLED（I2C 端口/引脚/频率/设备地址）；可在独立任务中调用，完成前其余显示函数为空操作
+void display_init(int port, int sda_io, int scl_io, uint32_t clk_hz, uint8_t addr);
 
 // 更新显示 (温度, 设定, 电池)
 void display_update(float temp, float setpoint, float battery);
@@ -13,7 +13,28 @@ void display_update(float temp, float setpoint, float battery);
 // 可选：清屏
 void display_clear(void);
 
-// 显示三行任意文本（超长自动截断到屏宽）
+// 显示三行任意文本（超长自动截断到屏宽）；支持 ASCII 可见字符与 '°'（UTF-8）
 void display_show_text(const char *line1, const char *line2, const char *line3);
 
+// 仪表盘：顶部 12x16 大号数字（如 "40.1°C"），下方三行 5x7 小字，底部为趋势图
+void display_dashboard(const char *big, const char *line1, const char *line2, const char *line3);
+
+// 趋势图（温度实线 / 设定虚线）：每个样本占一列，扫描式循环写入，纵轴按最近一屏数据自动定标
+#define DISPLAY_TREND_PAGES     3       // 占底部 3 页（24 像素行）
+#define DISPLAY_TREND_MIN_SPAN_C 4.0f   // 纵轴最小跨度 (°C)
+// 追加一个样本（只改帧缓冲，随下一次 display_dashboard/display_flush 写出）
+void display_trend_push(float temp, float setpoint);
+void display_trend_reset(void);
+
+// ===== 帧缓冲绘制：先在 RAM 中组合，display_flush 只把与屏上内容不同的列区间写出 =====
+#define DISPLAY_WIDTH 128
+#define DISPLAY_PAGES 8         // 每页 8 像素行
+void display_fb_clear(void);
+// 在 (x, y) 像素处绘制，y 可不按页对齐；返回结束后的 x
+int display_draw_text(int x, int y, const char *s);     // 5x7，6 像素步进
+int display_draw_large(int x, int y, const char *s);    // 12x16 数字/'.'/'-'/'°'/'C'/'%'
+void display_flush(void);
+// 整屏 8 页全部重写，返回 I2C 字节数（测量刷新耗时用）
+size_t display_flush_full(void);
+
 #endif
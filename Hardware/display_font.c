@@ -0,0 +1,132 @@
+#include "display_font.h"
+
+// 5x7 ASCII 0x20~0x7E，末项（0x7F 位置）为 '°'；每字 5 列，列字节低位在上
+const uint8_t FONT5X7[FONT5X7_COUNT][FONT5X7_W] = {
+    { 0x00,0x00,0x00,0x00,0x00 },  // ' '
+    { 0x00,0x00,0x5F,0x00,0x00 },  // '!'
+    { 0x00,0x07,0x00,0x07,0x00 },  // '"'
+    { 0x14,0x7F,0x14,0x7F,0x14 },  // '#'
+    { 0x24,0x2A,0x7F,0x2A,0x12 },  // '$'
+    { 0x62,0x64,0x08,0x13,0x23 },  // '%'
+    { 0x36,0x49,0x55,0x22,0x50 },  // '&'
+    { 0x00,0x05,0x03,0x00,0x00 },  // '\''
+    { 0x00,0x1C,0x22,0x41,0x00 },  // '('
+    { 0x00,0x41,0x22,0x1C,0x00 },  // ')'
+    { 0x08,0x2A,0x1C,0x2A,0x08 },  // '*'
+    { 0x08,0x08,0x3E,0x08,0x08 },  // '+'
+    { 0x00,0x50,0x30,0x00,0x00 },  // ','
+    { 0x08,0x08,0x08,0x08,0x08 },  // '-'
+    { 0x00,0x40,0x60,0x00,0x00 },  // '.'
+    { 0x20,0x10,0x08,0x04,0x02 },  // '/'
+    { 0x3E,0x51,0x49,0x45,0x3E },  // '0'
+    { 0x00,0x42,0x7F,0x40,0x00 },  // '1'
+    { 0x42,0x61,0x51,0x49,0x46 },  // '2'
+    { 0x21,0x41,0x45,0x4B,0x31 },  // '3'
+    { 0x18,0x14,0x12,0x7F,0x10 },  // '4'
+    { 0x27,0x45,0x45,0x45,0x39 },  // '5'
+    { 0x3C,0x4A,0x49,0x49,0x30 },  // '6'
+    { 0x01,0x71,0x09,0x05,0x03 },  // '7'
+    { 0x36,0x49,0x49,0x49,0x36 },  // '8'
+    { 0x06,0x49,0x49,0x29,0x1E },  // '9'
+    { 0x00,0x36,0x36,0x00,0x00 },  // ':'
+    { 0x00,0x56,0x36,0x00,0x00 },  // ';'
+    { 0x08,0x14,0x22,0x41,0x00 },  // '<'
+    { 0x14,0x14,0x14,0x14,0x14 },  // '='
+    { 0x00,0x41,0x22,0x14,0x08 },  // '>'
+    { 0x02,0x01,0x51,0x09,0x06 },  // '?'
+    { 0x32,0x49,0x79,0x41,0x3E },  // '@'
+    { 0x7E,0x09,0x09,0x09,0x7E },  // 'A'
+    { 0x7F,0x49,0x49,0x49,0x36 },  // 'B'
+    { 0x3E,0x41,0x41,0x41,0x22 },  // 'C'
+    { 0x7F,0x41,0x41,0x22,0x1C },  // 'D'
+    { 0x7F,0x49,0x49,0x49,0x41 },  // 'E'
+    { 0x7F,0x09,0x09,0x09,0x01 },  // 'F'
+    { 0x3E,0x41,0x49,0x49,0x7A },  // 'G'
+    { 0x7F,0x08,0x08,0x08,0x7F },  // 'H'
+    { 0x00,0x41,0x7F,0x41,0x00 },  // 'I'
+    { 0x20,0x40,0x41,0x3F,0x01 },  // 'J'
+    { 0x7F,0x08,0x14,0x22,0x41 },  // 'K'
+    { 0x7F,0x40,0x40,0x40,0x40 },  // 'L'
+    { 0x7F,0x02,0x04,0x02,0x7F },  // 'M'
+    { 0x7F,0x04,0x08,0x10,0x7F },  // 'N'
+    { 0x3E,0x41,0x41,0x41,0x3E },  // 'O'
+    { 0x7F,0x09,0x09,0x09,0x06 },  // 'P'
+    { 0x3E,0x41,0x51,0x21,0x5E },  // 'Q'
+    { 0x7F,0x09,0x19,0x29,0x46 },  // 'R'
+    { 0x22,0x49,0x49,0x49,0x31 },  // 'S'
+    { 0x01,0x01,0x7F,0x01,0x01 },  // 'T'
+    { 0x7F,0x40,0x40,0x40,0x7F },  // 'U'
+    { 0x3F,0x40,0x40,0x20,0x1F },  // 'V'
+    { 0x7F,0x20,0x18,0x20,0x7F },  // 'W'
+    { 0x63,0x14,0x08,0x14,0x63 },  // 'X'
+    { 0x07,0x08,0x70,0x08,0x07 },  // 'Y'
+    { 0x61,0x51,0x49,0x45,0x43 },  // 'Z'
+    { 0x00,0x00,0x7F,0x41,0x41 },  // '['
+    { 0x02,0x04,0x08,0x10,0x20 },  // '\\'
+    { 0x41,0x41,0x7F,0x00,0x00 },  // ']'
+    { 0x04,0x02,0x01,0x02,0x04 },  // '^'
+    { 0x40,0x40,0x40,0x40,0x40 },  // '_'
+    { 0x00,0x01,0x02,0x04,0x00 },  // '`'
+    { 0x20,0x54,0x54,0x54,0x78 },  // 'a'
+    { 0x7F,0x48,0x44,0x44,0x38 },  // 'b'
+    { 0x38,0x44,0x44,0x44,0x20 },  // 'c'
+    { 0x38,0x44,0x44,0x48,0x7F },  // 'd'
+    { 0x38,0x54,0x54,0x54,0x18 },  // 'e'
+    { 0x08,0x7E,0x09,0x01,0x02 },  // 'f'
+    { 0x08,0x14,0x54,0x54,0x3C },  // 'g'
+    { 0x7F,0x08,0x04,0x04,0x78 },  // 'h'
+    { 0x00,0x44,0x7D,0x40,0x00 },  // 'i'
+    { 0x20,0x40,0x44,0x3D,0x00 },  // 'j'
+    { 0x00,0x7F,0x10,0x28,0x44 },  // 'k'
+    { 0x00,0x41,0x7F,0x40,0x00 },  // 'l'
+    { 0x7C,0x04,0x18,0x04,0x78 },  // 'm'
+    { 0x7C,0x08,0x04,0x04,0x78 },  // 'n'
+    { 0x38,0x44,0x44,0x44,0x38 },  // 'o'
+    { 0x7C,0x14,0x14,0x14,0x08 },  // 'p'
+    { 0x08,0x14,0x14,0x18,0x7C },  // 'q'
+    { 0x7C,0x08,0x04,0x04,0x08 },  // 'r'
+    { 0x48,0x54,0x54,0x54,0x20 },  // 's'
+    { 0x04,0x3F,0x44,0x40,0x20 },  // 't'
+    { 0x3C,0x40,0x40,0x20,0x7C },  // 'u'
+    { 0x1C,0x20,0x40,0x20,0x1C },  // 'v'
+    { 0x3C,0x40,0x30,0x40,0x3C },  // 'w'
+    { 0x44,0x28,0x10,0x28,0x44 },  // 'x'
+    { 0x0C,0x50,0x50,0x50,0x3C },  // 'y'
+    { 0x44,0x64,0x54,0x4C,0x44 },  // 'z'
+    { 0x00,0x08,0x36,0x41,0x00 },  // '{'
+    { 0x00,0x00,0x7F,0x00,0x00 },  // '|'
+    { 0x00,0x41,0x36,0x08,0x00 },  // '}'
+    { 0x08,0x04,0x08,0x10,0x08 },  // '~'
+    { 0x00,0x06,0x09,0x09,0x06 },  // 0xB0 (°)
+};
+
+// 12x16 数字字体（10x13 字形 + 间距/边距），每字 24 字节：上页 12 列 + 下页 12 列
+const char FONT12X16_CHARS[] = "0123456789.- C\xB0%";
+const uint8_t FONT12X16[FONT12X16_COUNT][FONT12X16_W * 2] = {
+    { 0xF0,0xF8,0x1C,0x0C,0x0C,0x8C,0xCC,0x7C,0xF8,0xF0,0x00,0x00,0x1F,0x3F,0x7C,0x66,0x63,0x61,0x60,0x70,0x3F,0x1F,0x00,0x00 },  // '0'
+    { 0x00,0x20,0x30,0x18,0xFC,0xFC,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x60,0x60,0x60,0x7F,0x7F,0x60,0x60,0x60,0x00,0x00,0x00 },  // '1'
+    { 0x30,0x38,0x1C,0x0C,0x0C,0x0C,0x0C,0x9C,0xF8,0xF0,0x00,0x00,0x78,0x7C,0x6C,0x66,0x66,0x63,0x63,0x61,0x61,0x60,0x00,0x00 },  // '2'
+    { 0x10,0x18,0x1C,0x0C,0x8C,0x8C,0x8C,0x9C,0xF8,0x70,0x00,0x00,0x10,0x30,0x70,0x60,0x61,0x61,0x61,0x71,0x3F,0x1E,0x00,0x00 },  // '3'
+    { 0x00,0x80,0xC0,0x60,0x30,0x18,0x0C,0xFC,0xFC,0x00,0x00,0x00,0x07,0x07,0x06,0x06,0x06,0x06,0x06,0x7F,0x7F,0x06,0x00,0x00 },  // '4'
+    { 0xFC,0xFC,0xCC,0xCC,0xCC,0xCC,0xCC,0xCC,0x8C,0x0C,0x00,0x00,0x10,0x30,0x70,0x60,0x60,0x60,0x60,0x71,0x3F,0x1F,0x00,0x00 },  // '5'
+    { 0xE0,0xF0,0xB8,0x9C,0x8C,0x8C,0x8C,0x8C,0x00,0x00,0x00,0x00,0x1F,0x3F,0x73,0x61,0x61,0x61,0x61,0x73,0x3F,0x1E,0x00,0x00 },  // '6'
+    { 0x0C,0x0C,0x0C,0x0C,0x0C,0x8C,0xCC,0xEC,0x7C,0x3C,0x00,0x00,0x00,0x00,0x00,0x7C,0x7F,0x07,0x01,0x00,0x00,0x00,0x00,0x00 },  // '7'
+    { 0x70,0xF8,0xDC,0x8C,0x8C,0x8C,0x8C,0xDC,0xF8,0x70,0x00,0x00,0x1E,0x3F,0x73,0x61,0x61,0x61,0x61,0x73,0x3F,0x1E,0x00,0x00 },  // '8'
+    { 0xF0,0xF8,0x9C,0x0C,0x0C,0x0C,0x0C,0x9C,0xF8,0xF0,0x00,0x00,0x00,0x01,0x63,0x63,0x63,0x63,0x73,0x3B,0x1F,0x0F,0x00,0x00 },  // '9'
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x60,0x60,0x60,0x00,0x00,0x00,0x00,0x00,0x00 },  // '.'
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x00,0x00,0x00 },  // '-'
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },  // ' '
+    { 0xF0,0xF8,0x1C,0x0C,0x0C,0x0C,0x0C,0x1C,0x38,0x30,0x00,0x00,0x1F,0x3F,0x70,0x60,0x60,0x60,0x60,0x70,0x38,0x18,0x00,0x00 },  // 'C'
+    { 0x00,0x18,0x3C,0x24,0x24,0x3C,0x18,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },  // 0xB0 (°)
+    { 0x18,0x24,0x24,0x98,0xC0,0x60,0x30,0x18,0x0C,0x04,0x00,0x00,0x0C,0x06,0x03,0x01,0x0C,0x12,0x12,0x0C,0x00,0x00,0x00,0x00 },  // '%'
+};
+
+// 窄字符的前进宽度（其余为 FONT12X16_W）
+uint8_t font12x16_advance(char c) {
+    switch (c) {
+    case '.':    return 7;
+    case ' ':    return 6;
+    case '\xB0': return 8;
+    default:     return FONT12X16_W;
+    }
+}
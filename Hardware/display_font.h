@@ -0,0 +1,22 @@
+#ifndef DISPLAY_FONT_H
+#define DISPLAY_FONT_H
+
+#include <stdint.h>
+
+// OLED 字库：连续存放的列字模表，按码点直接索引（display.c 内部使用）
+
+// 5x7：覆盖 ASCII 0x20~0x7E 与 '°'（U+00B0，存放在 0x7F 位置）
+#define FONT5X7_W      5
+#define FONT5X7_FIRST  0x20
+#define FONT5X7_COUNT  96
+#define FONT5X7_DEGREE 0x7F
+extern const uint8_t FONT5X7[FONT5X7_COUNT][FONT5X7_W];
+
+// 12x16 大号数字（实时温度）：字符集见 FONT12X16_CHARS，'°' 以 0xB0 表示
+#define FONT12X16_W     12
+#define FONT12X16_COUNT 16
+extern const char FONT12X16_CHARS[];
+extern const uint8_t FONT12X16[FONT12X16_COUNT][FONT12X16_W * 2];
+uint8_t font12x16_advance(char c);
+
+#endif
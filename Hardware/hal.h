@@ -0,0 +1,95 @@
+#ifndef HAL_H
+#define HAL_H
+
+// 硬件抽象层：Hardware/ 下各模块只通过这里访问外设
+//   hal_esp.c  —— ESP-IDF 驱动实现（adc_oneshot / ledc / gpio / i2c / uart）
+//   hal_sim.c  —— 主机仿真实现（Tools/ 主机工程使用）
+// 通道/引脚/端口均使用 int，避免在接口中暴露驱动头文件
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+// ===== ADC（单元 1，12 位，12dB 衰减） =====
+esp_err_t hal_adc_channel_init(int channel);
+int hal_adc_read_raw(int channel);          // 单次转换原始值（0~4095）；多任务可并发调用（互斥）
+int hal_adc_raw_to_mv(int raw);             // 原始值 -> mV（有校准用校准，否则线性近似）
+
+// ===== PWM（LEDC 低速模式） =====
+esp_err_t hal_pwm_timer_init(int timer, uint32_t freq_hz, int resolution_bits);
+esp_err_t hal_pwm_channel_init(int channel, int timer, int gpio);
+void hal_pwm_set_duty(int channel, uint32_t duty);
+
+// ===== GPIO =====
+esp_err_t hal_gpio_output(int gpio);
+esp_err_t hal_gpio_input_pullup(uint64_t pin_mask);
+void hal_gpio_set(int gpio, int level);
+int hal_gpio_get(int gpio);
+
+// ===== I2C 主机（OLED 数据汇） =====
+esp_err_t hal_i2c_master_init(int port, int sda_io, int scl_io, uint32_t clk_hz);
+esp_err_t hal_i2c_write(int port, uint8_t addr, const uint8_t *data, size_t len, uint32_t timeout_ms);
+
+// ===== SPI 主机（只读传感器，如热电偶转换器）：DMA 传输，排队后立即返回，稍后取回结果 =====
+#define HAL_SPI_MAX_DEVS 4
+#define HAL_SPI_MAX_XFER 4          // 单次读取字节数上限
+typedef struct hal_spi_dev *hal_spi_dev_t;
+// mosi_io = -1 表示只读总线
+esp_err_t hal_spi_bus_init(int host, int sclk_io, int miso_io, int mosi_io);
+esp_err_t hal_spi_device_add(int host, int cs_io, uint32_t clk_hz, int mode, hal_spi_dev_t *out);
+// 排队一次 len 字节读取；同一设备须先取回上一次结果，否则返回 ESP_ERR_INVALID_STATE
+esp_err_t hal_spi_read_start(hal_spi_dev_t dev, size_t len);
+// 等待并取回；timeout_ms 内未完成返回 ESP_ERR_TIMEOUT（传输仍在队列中，可再次取回）
+esp_err_t hal_spi_read_finish(hal_spi_dev_t dev, uint8_t *out, uint32_t timeout_ms);
+
+// ===== UART =====
+// tx_buf_size > 0 时启用驱动 TX 环形缓冲，hal_uart_write 拷入缓冲即返回
+esp_err_t hal_uart_init(int port, int tx_gpio, int rx_gpio, int baud_rate, int rx_buf_size, int tx_buf_size);
+esp_err_t hal_uart_set_baud(int port, int baud_rate);
+int hal_uart_write(int port, const void *data, size_t len);
+
+// ===== 时间与周期定时器（回调在定时器任务上下文执行，不在中断中） =====
+int64_t hal_time_us(void);                  // 启动以来微秒
+typedef void (*hal_timer_cb_t)(void *arg);
+typedef struct hal_timer *hal_timer_t;
+// out 可为 NULL（不需要后续调整周期时）
+esp_err_t hal_timer_start_periodic(const char *name, uint32_t period_us, hal_timer_cb_t cb, void *arg, hal_timer_t *out);
+// 修改周期；period_us = 0 暂停
+esp_err_t hal_timer_set_period(hal_timer_t timer, uint32_t period_us);
+
+// ===== 任务看门狗（当前任务注册后须在超时内持续喂狗，否则复位） =====
+esp_err_t hal_wdt_add_self(void);
+void hal_wdt_feed(void);
+
+// ===== OTA 固件分区（写入下一个非运行分区，按写入进度逐扇区擦除） =====
+typedef struct hal_ota *hal_ota_t;
+size_t hal_ota_partition_size(void);         // 目标分区容量（无可用分区返回 0）
+esp_err_t hal_ota_begin(hal_ota_t *out);
+esp_err_t hal_ota_write(hal_ota_t ota, const void *data, size_t len);
+// 结束写入并校验镜像格式与自带摘要；无论成败句柄均被释放
+esp_err_t hal_ota_end(hal_ota_t ota);
+void hal_ota_abort(hal_ota_t ota);
+// 将最近一次 hal_ota_end 成功的分区设为下次启动分区
+esp_err_t hal_ota_set_boot(void);
+// 新固件自检通过：取消回滚（非待验证状态下为空操作）
+void hal_ota_mark_valid(void);
+// 新固件自检失败：标记无效并重启回到上一固件（非待验证状态下为空操作）
+void hal_ota_rollback(void);
+void hal_restart(void);
+
+#if HAL_SIM
+// ===== 仅仿真：注入与观测 =====
+// 固定某 ADC 通道的读数（mV），mv < 0 恢复为仿真对象驱动
+void hal_sim_set_adc_mv(int channel, int mv);
+// 仿真加热对象（温区 n）当前温度（°C）
+float hal_sim_plant_temp(int plant);
+// 累计 I2C 事务数与字节数
+uint64_t hal_sim_i2c_transactions(void);
+uint64_t hal_sim_i2c_bytes(void);
+// SSD1306 显存镜像（8 页 x 128 列）
+const uint8_t *hal_sim_oled_gddram(void);
+// SPI 设备按添加顺序 n 测量仿真对象 n，按读取长度应答：4 字节为 MAX31855 帧，2 字节为 MAX6675 帧
+#endif
+
+#endif
@@ -0,0 +1,323 @@
+// HAL 的 ESP-IDF 实现：薄封装，不做额外缓存或状态管理
+#include "hal.h"
+#include "adc_shared.h"
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "driver/i2c.h"
+#include "driver/spi_master.h"
+#include "driver/uart.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_ota_ops.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include "esp_task_wdt.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include <string.h>
+
+static const char *TAG = "HAL";
+
+// ===== ADC =====
+// adc_oneshot_read 不可重入：采集任务与安全监控任务共用单元，转换期间互斥（带优先级继承）
+static SemaphoreHandle_t s_adc_lock = NULL;
+
+esp_err_t hal_adc_channel_init(int channel) {
+    // 创建/复用全局 Oneshot ADC 单元与校准
+    esp_err_t err = adc_shared_init_unit();
+    if (err != ESP_OK) return err;
+    if (!s_adc_lock) s_adc_lock = xSemaphoreCreateMutex();
+    adc_oneshot_chan_cfg_t chan_cfg = {
+        .bitwidth = ADC_BITWIDTH_DEFAULT,
+        .atten = ADC_ATTEN_DB_12,
+    };
+    err = adc_oneshot_config_channel(adc_shared_unit(), (adc_channel_t)channel, &chan_cfg);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "adc channel %d config failed: %d", channel, err);
+        return err;
+    }
+    return adc_shared_init_cali();
+}
+
+int hal_adc_read_raw(int channel) {
+    int v = 0;
+    if (s_adc_lock) xSemaphoreTake(s_adc_lock, portMAX_DELAY);
+    adc_oneshot_read(adc_shared_unit(), (adc_channel_t)channel, &v);
+    if (s_adc_lock) xSemaphoreGive(s_adc_lock);
+    return v;
+}
+
+int hal_adc_raw_to_mv(int raw) {
+    int mv = 0;
+    adc_cali_handle_t cali = adc_shared_cali();
+    if (cali) {
+        adc_cali_raw_to_voltage(cali, raw, &mv);
+    } else {
+        // 12-bit, 12dB 近似 0~3300mV
+        mv = (int)((raw * 3300) / 4095);
+    }
+    return mv;
+}
+
+// ===== PWM =====
+esp_err_t hal_pwm_timer_init(int timer, uint32_t freq_hz, int resolution_bits) {
+    ledc_timer_config_t t = {
+        .speed_mode = LEDC_LOW_SPEED_MODE,   // ESP32C3只支持低速模式
+        .timer_num = (ledc_timer_t)timer,
+        .duty_resolution = (ledc_timer_bit_t)resolution_bits,
+        .freq_hz = freq_hz,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+    return ledc_timer_config(&t);
+}
+
+esp_err_t hal_pwm_channel_init(int channel, int timer, int gpio) {
+    ledc_channel_config_t ch = {
+        .gpio_num = gpio,
+        .speed_mode = LEDC_LOW_SPEED_MODE,
+        .channel = (ledc_channel_t)channel,
+        .timer_sel = (ledc_timer_t)timer,
+        .duty = 0,
+        .intr_type = LEDC_INTR_DISABLE,
+    };
+    return ledc_channel_config(&ch);
+}
+
+void hal_pwm_set_duty(int channel, uint32_t duty) {
+    ledc_set_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel, duty);
+    ledc_update_duty(LEDC_LOW_SPEED_MODE, (ledc_channel_t)channel);
+}
+
+// ===== GPIO =====
+esp_err_t hal_gpio_output(int gpio) {
+    gpio_config_t io = {
+        .pin_bit_mask = (1ULL << gpio),
+        .mode = GPIO_MODE_OUTPUT,
+        .pull_up_en = 0,
+        .pull_down_en = 0,
+        .intr_type = GPIO_INTR_DISABLE,
+    };
+    return gpio_config(&io);
+}
+
+esp_err_t hal_gpio_input_pullup(uint64_t pin_mask) {
+    gpio_config_t io = {
+        .pin_bit_mask = pin_mask,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = 1,
+        .pull_down_en = 0,
+        .intr_type = GPIO_INTR_DISABLE,
+    };
+    return gpio_config(&io);
+}
+
+void hal_gpio_set(int gpio, int level) { gpio_set_level((gpio_num_t)gpio, level); }
+
+int hal_gpio_get(int gpio) { return gpio_get_level((gpio_num_t)gpio); }
+
+// ===== I2C =====
+esp_err_t hal_i2c_master_init(int port, int sda_io, int scl_io, uint32_t clk_hz) {
+    i2c_config_t conf = {
+        .mode = I2C_MODE_MASTER,
+        .sda_io_num = sda_io,
+        .scl_io_num = scl_io,
+        .sda_pullup_en = GPIO_PULLUP_ENABLE,
+        .scl_pullup_en = GPIO_PULLUP_ENABLE,
+        .master.clk_speed = clk_hz,
+    };
+    esp_err_t err = i2c_param_config((i2c_port_t)port, &conf);
+    if (err != ESP_OK) return err;
+    return i2c_driver_install((i2c_port_t)port, conf.mode, 0, 0, 0);
+}
+
+esp_err_t hal_i2c_write(int port, uint8_t addr, const uint8_t *data, size_t len, uint32_t timeout_ms) {
+    return i2c_master_write_to_device((i2c_port_t)port, addr, data, len, timeout_ms / portTICK_PERIOD_MS);
+}
+
+// ===== UART =====
+esp_err_t hal_uart_init(int port, int tx_gpio, int rx_gpio, int baud_rate, int rx_buf_size, int tx_buf_size) {
+    uart_config_t uart_config = {
+        .baud_rate = baud_rate,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+    };
+    uart_param_config((uart_port_t)port, &uart_config);
+    uart_set_pin((uart_port_t)port, tx_gpio, rx_gpio, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    return uart_driver_install((uart_port_t)port, rx_buf_size, tx_buf_size, 0, NULL, 0);
+}
+
+esp_err_t hal_uart_set_baud(int port, int baud_rate) {
+    return uart_set_baudrate((uart_port_t)port, (uint32_t)baud_rate);
+}
+
+int hal_uart_write(int port, const void *data, size_t len) {
+    return uart_write_bytes((uart_port_t)port, data, len);
+}
+
+// ===== SPI =====
+// 每个设备一个常驻事务与 DMA 接收缓冲：排队期间驱动持有两者，取回前不可复用
+struct hal_spi_dev {
+    spi_device_handle_t handle;
+    spi_transaction_t trans;
+    uint8_t *rx;
+    size_t len;
+    bool pending;
+};
+static struct hal_spi_dev s_spi_devs[HAL_SPI_MAX_DEVS];
+static int s_spi_dev_count = 0;
+
+esp_err_t hal_spi_bus_init(int host, int sclk_io, int miso_io, int mosi_io) {
+    spi_bus_config_t bus = {
+        .sclk_io_num = sclk_io,
+        .miso_io_num = miso_io,
+        .mosi_io_num = mosi_io,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = HAL_SPI_MAX_XFER,
+    };
+    return spi_bus_initialize((spi_host_device_t)host, &bus, SPI_DMA_CH_AUTO);
+}
+
+esp_err_t hal_spi_device_add(int host, int cs_io, uint32_t clk_hz, int mode, hal_spi_dev_t *out) {
+    if (s_spi_dev_count >= HAL_SPI_MAX_DEVS) return ESP_ERR_NO_MEM;
+    struct hal_spi_dev *d = &s_spi_devs[s_spi_dev_count];
+    d->rx = heap_caps_malloc(HAL_SPI_MAX_XFER, MALLOC_CAP_DMA);
+    if (!d->rx) return ESP_ERR_NO_MEM;
+    spi_device_interface_config_t dev = {
+        .clock_speed_hz = (int)clk_hz,
+        .mode = (uint8_t)mode,
+        .spics_io_num = cs_io,
+        .queue_size = 1,
+    };
+    esp_err_t err = spi_bus_add_device((spi_host_device_t)host, &dev, &d->handle);
+    if (err != ESP_OK) {
+        heap_caps_free(d->rx);
+        d->rx = NULL;
+        return err;
+    }
+    s_spi_dev_count++;
+    *out = d;
+    return ESP_OK;
+}
+
+esp_err_t hal_spi_read_start(hal_spi_dev_t dev, size_t len) {
+    if (dev->pending) return ESP_ERR_INVALID_STATE;
+    if (len == 0 || len > HAL_SPI_MAX_XFER) return ESP_ERR_INVALID_ARG;
+    memset(&dev->trans, 0, sizeof(dev->trans));
+    dev->trans.length = len * 8;
+    dev->trans.rxlength = len * 8;
+    dev->trans.rx_buffer = dev->rx;
+    dev->len = len;
+    esp_err_t err = spi_device_queue_trans(dev->handle, &dev->trans, 0);
+    if (err == ESP_OK) dev->pending = true;
+    return err;
+}
+
+esp_err_t hal_spi_read_finish(hal_spi_dev_t dev, uint8_t *out, uint32_t timeout_ms) {
+    if (!dev->pending) return ESP_ERR_INVALID_STATE;
+    spi_transaction_t *done = NULL;
+    esp_err_t err = spi_device_get_trans_result(dev->handle, &done, pdMS_TO_TICKS(timeout_ms));
+    if (err == ESP_ERR_TIMEOUT) return err;
+    dev->pending = false;
+    if (err == ESP_OK) memcpy(out, dev->rx, dev->len);
+    return err;
+}
+
+// ===== 时间与定时器 =====
+int64_t hal_time_us(void) { return esp_timer_get_time(); }
+
+esp_err_t hal_timer_start_periodic(const char *name, uint32_t period_us, hal_timer_cb_t cb, void *arg, hal_timer_t *out) {
+    const esp_timer_create_args_t args = {
+        .callback = cb,
+        .arg = arg,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = name,
+        .skip_unhandled_events = true,
+    };
+    esp_timer_handle_t h = NULL;
+    esp_err_t err = esp_timer_create(&args, &h);
+    if (err != ESP_OK) return err;
+    if (out) *out = (hal_timer_t)h;
+    return period_us ? esp_timer_start_periodic(h, period_us) : ESP_OK;
+}
+
+esp_err_t hal_timer_set_period(hal_timer_t timer, uint32_t period_us) {
+    esp_timer_handle_t h = (esp_timer_handle_t)timer;
+    esp_timer_stop(h);  // 未运行时返回 ESP_ERR_INVALID_STATE，忽略
+    return period_us ? esp_timer_start_periodic(h, period_us) : ESP_OK;
+}
+
+// ===== 任务看门狗 =====
+esp_err_t hal_wdt_add_self(void) { return esp_task_wdt_add(NULL); }
+
+void hal_wdt_feed(void) { esp_task_wdt_reset(); }
+
+// ===== OTA =====
+struct hal_ota {
+    esp_ota_handle_t handle;
+    const esp_partition_t *part;
+};
+static struct hal_ota s_ota;                    // 同一时刻只有一个 OTA 会话
+static const esp_partition_t *s_ota_done = NULL;
+
+size_t hal_ota_partition_size(void) {
+    const esp_partition_t *p = esp_ota_get_next_update_partition(NULL);
+    return p ? p->size : 0;
+}
+
+esp_err_t hal_ota_begin(hal_ota_t *out) {
+    const esp_partition_t *p = esp_ota_get_next_update_partition(NULL);
+    if (!p) return ESP_ERR_NOT_FOUND;
+    // 顺序写入：写到新扇区时才擦除该扇区，不一次性擦除整个分区
+    esp_err_t err = esp_ota_begin(p, OTA_WITH_SEQUENTIAL_WRITES, &s_ota.handle);
+    if (err != ESP_OK) return err;
+    s_ota.part = p;
+    s_ota_done = NULL;
+    *out = &s_ota;
+    ESP_LOGI(TAG, "ota -> %s @0x%lx (%lu B)", p->label, (unsigned long)p->address, (unsigned long)p->size);
+    return ESP_OK;
+}
+
+esp_err_t hal_ota_write(hal_ota_t ota, const void *data, size_t len) {
+    return esp_ota_write(ota->handle, data, len);
+}
+
+esp_err_t hal_ota_end(hal_ota_t ota) {
+    // esp_ota_end 校验镜像头、段校验和与追加的 SHA-256
+    esp_err_t err = esp_ota_end(ota->handle);
+    if (err == ESP_OK) s_ota_done = ota->part;
+    ota->part = NULL;
+    return err;
+}
+
+void hal_ota_abort(hal_ota_t ota) {
+    esp_ota_abort(ota->handle);
+    ota->part = NULL;
+}
+
+esp_err_t hal_ota_set_boot(void) {
+    if (!s_ota_done) return ESP_ERR_INVALID_STATE;
+    return esp_ota_set_boot_partition(s_ota_done);
+}
+
+void hal_ota_mark_valid(void) {
+    esp_ota_img_states_t st;
+    if (esp_ota_get_state_partition(esp_ota_get_running_partition(), &st) == ESP_OK &&
+        st == ESP_OTA_IMG_PENDING_VERIFY) {
+        esp_ota_mark_app_valid_cancel_rollback();
+        ESP_LOGI(TAG, "new firmware marked valid");
+    }
+}
+
+void hal_ota_rollback(void) {
+    esp_ota_img_states_t st;
+    if (esp_ota_get_state_partition(esp_ota_get_running_partition(), &st) == ESP_OK &&
+        st == ESP_OTA_IMG_PENDING_VERIFY) {
+        ESP_LOGE(TAG, "new firmware failed self-check, rolling back");
+        esp_ota_mark_app_invalid_rollback_and_reboot();
+    }
+}
+
+void hal_restart(void) { esp_restart(); }
@@ -0,0 +1,434 @@
+// HAL 的主机仿真实现：一阶加热对象 + NTC 分压 + SSD1306 显存镜像
+// 用于 Tools/ 主机工程（ESP-IDF 5.0 的 linux 目标缺少 FreeRTOS/lwIP/HTTP 组件，整机不在主机上构建）
+//
+// 环境变量：
+//   HAL_SIM_SPEED      仿真对象时间倍速（默认 1）
+//   HAL_SIM_AMBIENT    环境温度 °C（默认 25）
+//   HAL_SIM_UART_PATH  UART 输出写入的文件/pty 路径（默认丢弃）
+#include "hal.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+// 与 main.c 的引脚/通道配置保持一致：温区 n 的 NTC 在 ADC 通道 n，加热器在 LEDC 通道 3+n
+#define SIM_PLANTS          3
+#define SIM_NTC_ADC_CH      0
+#define SIM_BATT_ADC_CH     4
+#define SIM_HEATER_PWM_CH   3
+#define SIM_HEATER_GPIO     10          // 仅温区 0 的 GPIO 开关模式
+#define SIM_NTC_REF_RES     100000.0f
+#define SIM_VCC_MV          3300.0f
+#define SIM_BATT_MV         1950        // 分压后 3.9V 电池
+
+// 一阶加热对象：tau * dT/dt = ambient + gain * u - T
+#define SIM_PLANT_TAU_S     120.0f
+#define SIM_PLANT_GAIN_C    150.0f
+
+#define SIM_ADC_CHANNELS    10
+#define SIM_PWM_CHANNELS    8
+#define SIM_PWM_TIMERS      4
+#define SIM_GPIOS           64
+
+// OTA：写入文件 HAL_SIM_OTA_PATH（默认 ota_image.bin），容量与 partitions.csv 中 OTA 分区一致
+#define SIM_OTA_SIZE        0xF0000
+#define SIM_IMAGE_MAGIC     0xE9        // ESP 应用镜像首字节
+
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int s_adc_forced_mv[SIM_ADC_CHANNELS] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+static int s_pwm_timer_bits[SIM_PWM_TIMERS];
+static int s_pwm_ch_timer[SIM_PWM_CHANNELS] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+static uint32_t s_pwm_duty[SIM_PWM_CHANNELS];
+static uint8_t s_gpio_level[SIM_GPIOS];
+static uint64_t s_gpio_outputs;
+
+static bool s_plant_init = false;
+static float s_plant_temp[SIM_PLANTS];
+static float s_ambient = 25.0f;
+static float s_speed = 1.0f;
+static double s_plant_last_s;
+
+static uint64_t s_i2c_transactions;
+static uint64_t s_i2c_bytes;
+static uint8_t s_gddram[8][128];
+static int s_oled_page, s_oled_col, s_oled_args_pending;
+
+static FILE *s_uart_out;
+
+struct hal_timer {
+    hal_timer_cb_t cb;
+    void *arg;
+    volatile uint32_t period_us;   // 0 = 暂停
+};
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static float env_float(const char *name, float def) {
+    const char *v = getenv(name);
+    return v ? strtof(v, NULL) : def;
+}
+
+// 加热器输入 0~1：优先 PWM 通道占空，否则 GPIO 电平（调用方持锁）
+static float heater_input(int plant) {
+    int ch = SIM_HEATER_PWM_CH + plant;
+    int t = s_pwm_ch_timer[ch];
+    if (t >= 0) {
+        uint32_t full = 1u << s_pwm_timer_bits[t];
+        return (float)s_pwm_duty[ch] / (float)full;
+    }
+    return (plant == 0 && s_gpio_level[SIM_HEATER_GPIO]) ? 1.0f : 0.0f;
+}
+
+// 推进仿真对象到当前时刻（调用方持锁）
+static void plant_advance(void) {
+    double now = now_s();
+    if (!s_plant_init) {
+        s_ambient = env_float("HAL_SIM_AMBIENT", 25.0f);
+        s_speed = env_float("HAL_SIM_SPEED", 1.0f);
+        for (int i = 0; i < SIM_PLANTS; i++) s_plant_temp[i] = s_ambient;
+        s_plant_last_s = now;
+        s_plant_init = true;
+        return;
+    }
+    float dt = (float)(now - s_plant_last_s) * s_speed;
+    s_plant_last_s = now;
+    float decay = expf(-dt / SIM_PLANT_TAU_S);
+    for (int i = 0; i < SIM_PLANTS; i++) {
+        float target = s_ambient + SIM_PLANT_GAIN_C * heater_input(i);
+        // 精确离散化，dt 再大也不会越过稳态
+        s_plant_temp[i] = target + (s_plant_temp[i] - target) * decay;
+    }
+}
+
+static int ntc_mv(float temp_c) {
+    const float beta = 3950.0f, r0 = 10000.0f, t0_k = 298.15f;
+    float rt = r0 * expf(beta * (1.0f / (temp_c + 273.15f) - 1.0f / t0_k));
+    return (int)(SIM_VCC_MV * rt / (SIM_NTC_REF_RES + rt));
+}
+
+// ===== ADC =====
+esp_err_t hal_adc_channel_init(int channel) {
+    return (channel >= 0 && channel < SIM_ADC_CHANNELS) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+int hal_adc_read_raw(int channel) {
+    if (channel < 0 || channel >= SIM_ADC_CHANNELS) return 0;
+    int mv;
+    pthread_mutex_lock(&s_lock);
+    if (s_adc_forced_mv[channel] >= 0) {
+        mv = s_adc_forced_mv[channel];
+    } else if (channel >= SIM_NTC_ADC_CH && channel < SIM_NTC_ADC_CH + SIM_PLANTS) {
+        plant_advance();
+        mv = ntc_mv(s_plant_temp[channel - SIM_NTC_ADC_CH]);
+    } else if (channel == SIM_BATT_ADC_CH) {
+        mv = SIM_BATT_MV;
+    } else {
+        mv = 0;
+    }
+    pthread_mutex_unlock(&s_lock);
+    // ±2 LSB 量化噪声
+    int raw = mv * 4095 / 3300 + (rand() % 5) - 2;
+    if (raw < 0) raw = 0;
+    if (raw > 4095) raw = 4095;
+    return raw;
+}
+
+int hal_adc_raw_to_mv(int raw) { return (int)((raw * 3300) / 4095); }
+
+void hal_sim_set_adc_mv(int channel, int mv) {
+    if (channel < 0 || channel >= SIM_ADC_CHANNELS) return;
+    pthread_mutex_lock(&s_lock);
+    s_adc_forced_mv[channel] = mv;
+    pthread_mutex_unlock(&s_lock);
+}
+
+float hal_sim_plant_temp(int plant) {
+    if (plant < 0 || plant >= SIM_PLANTS) return 0.0f;
+    pthread_mutex_lock(&s_lock);
+    plant_advance();
+    float t = s_plant_temp[plant];
+    pthread_mutex_unlock(&s_lock);
+    return t;
+}
+
+// ===== PWM =====
+esp_err_t hal_pwm_timer_init(int timer, uint32_t freq_hz, int resolution_bits) {
+    if (timer < 0 || timer >= SIM_PWM_TIMERS || resolution_bits <= 0 || resolution_bits > 20) return ESP_ERR_INVALID_ARG;
+    (void)freq_hz;
+    s_pwm_timer_bits[timer] = resolution_bits;
+    return ESP_OK;
+}
+
+esp_err_t hal_pwm_channel_init(int channel, int timer, int gpio) {
+    if (channel < 0 || channel >= SIM_PWM_CHANNELS || timer < 0 || timer >= SIM_PWM_TIMERS) return ESP_ERR_INVALID_ARG;
+    (void)gpio;
+    pthread_mutex_lock(&s_lock);
+    plant_advance();
+    s_pwm_ch_timer[channel] = timer;
+    s_pwm_duty[channel] = 0;
+    pthread_mutex_unlock(&s_lock);
+    return ESP_OK;
+}
+
+void hal_pwm_set_duty(int channel, uint32_t duty) {
+    if (channel < 0 || channel >= SIM_PWM_CHANNELS) return;
+    pthread_mutex_lock(&s_lock);
+    plant_advance();  // 先按旧占空积分到现在
+    s_pwm_duty[channel] = duty;
+    pthread_mutex_unlock(&s_lock);
+}
+
+// ===== GPIO =====
+esp_err_t hal_gpio_output(int gpio) {
+    if (gpio < 0 || gpio >= SIM_GPIOS) return ESP_ERR_INVALID_ARG;
+    s_gpio_outputs |= 1ULL << gpio;
+    s_gpio_level[gpio] = 0;
+    return ESP_OK;
+}
+
+esp_err_t hal_gpio_input_pullup(uint64_t pin_mask) {
+    for (int i = 0; i < SIM_GPIOS; i++) {
+        if (pin_mask & (1ULL << i)) s_gpio_level[i] = 1;  // 按键未按下
+    }
+    return ESP_OK;
+}
+
+void hal_gpio_set(int gpio, int level) {
+    if (gpio < 0 || gpio >= SIM_GPIOS) return;
+    pthread_mutex_lock(&s_lock);
+    if (gpio == SIM_HEATER_GPIO) plant_advance();
+    s_gpio_level[gpio] = level ? 1 : 0;
+    pthread_mutex_unlock(&s_lock);
+}
+
+int hal_gpio_get(int gpio) {
+    return (gpio >= 0 && gpio < SIM_GPIOS) ? s_gpio_level[gpio] : 0;
+}
+
+// ===== I2C：按 SSD1306 协议解析，维护显存镜像 =====
+esp_err_t hal_i2c_master_init(int port, int sda_io, int scl_io, uint32_t clk_hz) {
+    (void)port; (void)sda_io; (void)scl_io; (void)clk_hz;
+    return ESP_OK;
+}
+
+static void oled_cmd(uint8_t c) {
+    if (s_oled_args_pending > 0) { s_oled_args_pending--; return; }
+    if (c >= 0xB0 && c <= 0xB7) s_oled_page = c & 0x07;
+    else if (c <= 0x0F) s_oled_col = (s_oled_col & 0xF0) | c;
+    else if (c >= 0x10 && c <= 0x1F) s_oled_col = (s_oled_col & 0x0F) | ((c & 0x0F) << 4);
+    else if (c == 0x21 || c == 0x22) s_oled_args_pending = 2;
+    else if (c == 0x26 || c == 0x27) s_oled_args_pending = 6;
+    else if (c == 0x29 || c == 0x2A) s_oled_args_pending = 5;
+    else if (c == 0xA3) s_oled_args_pending = 2;
+    else if (c == 0x81 || c == 0x8D || c == 0x20 || c == 0xA8 || c == 0xD3 ||
+             c == 0xD5 || c == 0xD9 || c == 0xDA || c == 0xDB) s_oled_args_pending = 1;
+}
+
+esp_err_t hal_i2c_write(int port, uint8_t addr, const uint8_t *data, size_t len, uint32_t timeout_ms) {
+    (void)port; (void)addr; (void)timeout_ms;
+    pthread_mutex_lock(&s_lock);
+    s_i2c_transactions++;
+    s_i2c_bytes += len;
+    if (len > 1 && data[0] == 0x40) {
+        for (size_t i = 1; i < len; i++) {
+            s_gddram[s_oled_page][s_oled_col] = data[i];
+            if (++s_oled_col >= 128) { s_oled_col = 0; s_oled_page = (s_oled_page + 1) & 0x07; }
+        }
+    } else if (len > 1 && data[0] == 0x00) {
+        for (size_t i = 1; i < len; i++) oled_cmd(data[i]);
+    }
+    pthread_mutex_unlock(&s_lock);
+    return ESP_OK;
+}
+
+uint64_t hal_sim_i2c_transactions(void) { return s_i2c_transactions; }
+uint64_t hal_sim_i2c_bytes(void) { return s_i2c_bytes; }
+const uint8_t *hal_sim_oled_gddram(void) { return &s_gddram[0][0]; }
+
+// ===== SPI：设备 n 按热电偶转换器帧格式应答仿真对象 n 的温度（理想线性，冷端取环境温度） =====
+struct hal_spi_dev {
+    int plant;
+    size_t len;
+    bool pending;
+};
+static struct hal_spi_dev s_spi_devs[HAL_SPI_MAX_DEVS];
+static int s_spi_dev_count;
+
+esp_err_t hal_spi_bus_init(int host, int sclk_io, int miso_io, int mosi_io) {
+    (void)host; (void)sclk_io; (void)miso_io; (void)mosi_io;
+    return ESP_OK;
+}
+
+esp_err_t hal_spi_device_add(int host, int cs_io, uint32_t clk_hz, int mode, hal_spi_dev_t *out) {
+    (void)host; (void)cs_io; (void)clk_hz; (void)mode;
+    if (s_spi_dev_count >= HAL_SPI_MAX_DEVS) return ESP_ERR_NO_MEM;
+    struct hal_spi_dev *d = &s_spi_devs[s_spi_dev_count];
+    d->plant = s_spi_dev_count++;
+    *out = d;
+    return ESP_OK;
+}
+
+esp_err_t hal_spi_read_start(hal_spi_dev_t dev, size_t len) {
+    if (dev->pending) return ESP_ERR_INVALID_STATE;
+    if (len == 0 || len > HAL_SPI_MAX_XFER) return ESP_ERR_INVALID_ARG;
+    dev->len = len;
+    dev->pending = true;
+    return ESP_OK;
+}
+
+esp_err_t hal_spi_read_finish(hal_spi_dev_t dev, uint8_t *out, uint32_t timeout_ms) {
+    (void)timeout_ms;
+    if (!dev->pending) return ESP_ERR_INVALID_STATE;
+    dev->pending = false;
+    float t = dev->plant < SIM_PLANTS ? hal_sim_plant_temp(dev->plant) : s_ambient;
+    uint32_t frame;
+    if (dev->len == 2) {
+        // MAX6675：D14..D3 温度 0.25 °C/LSB
+        frame = ((uint32_t)lroundf(t * 4.0f) & 0xFFF) << 3;
+    } else {
+        // MAX31855：D31..D18 热端 0.25 °C/LSB，D15..D4 冷端 0.0625 °C/LSB
+        frame = (((uint32_t)lroundf(t * 4.0f) & 0x3FFF) << 18) | (((uint32_t)lroundf(s_ambient * 16.0f) & 0xFFF) << 4);
+        frame >>= 8 * (4 - dev->len);
+    }
+    for (size_t i = 0; i < dev->len; i++) out[i] = (uint8_t)(frame >> (8 * (dev->len - 1 - i)));
+    return ESP_OK;
+}
+
+// ===== UART =====
+esp_err_t hal_uart_init(int port, int tx_gpio, int rx_gpio, int baud_rate, int rx_buf_size, int tx_buf_size) {
+    (void)port; (void)tx_gpio; (void)rx_gpio; (void)baud_rate; (void)rx_buf_size; (void)tx_buf_size;
+    const char *path = getenv("HAL_SIM_UART_PATH");
+    if (path && !s_uart_out) {
+        s_uart_out = fopen(path, "wb");
+        if (!s_uart_out) return ESP_FAIL;
+        setvbuf(s_uart_out, NULL, _IONBF, 0);
+    }
+    return ESP_OK;
+}
+
+esp_err_t hal_uart_set_baud(int port, int baud_rate) {
+    (void)port;
+    return baud_rate > 0 ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+int hal_uart_write(int port, const void *data, size_t len) {
+    (void)port;
+    if (s_uart_out) return (int)fwrite(data, 1, len, s_uart_out);
+    return (int)len;
+}
+
+// ===== 时间与定时器：每个定时器一个线程，按绝对时刻节拍调用回调 =====
+// 与 esp_timer 一致从“启动”（首次调用）起计
+static struct timespec s_boot_ts;
+static pthread_once_t s_boot_once = PTHREAD_ONCE_INIT;
+
+static void boot_time_init(void) { clock_gettime(CLOCK_MONOTONIC, &s_boot_ts); }
+
+int64_t hal_time_us(void) {
+    pthread_once(&s_boot_once, boot_time_init);
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)(ts.tv_sec - s_boot_ts.tv_sec) * 1000000 + (ts.tv_nsec - s_boot_ts.tv_nsec) / 1000;
+}
+
+static void *sim_timer_thread(void *p) {
+    struct hal_timer *t = p;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (;;) {
+        uint32_t period = t->period_us;
+        if (period == 0) {
+            // 暂停：低频轮询，恢复后从当前时刻重新计节拍
+            struct timespec idle = { 0, 10 * 1000000L };
+            nanosleep(&idle, NULL);
+            clock_gettime(CLOCK_MONOTONIC, &next);
+            continue;
+        }
+        next.tv_nsec += (long)period * 1000L;
+        while (next.tv_nsec >= 1000000000L) { next.tv_nsec -= 1000000000L; next.tv_sec++; }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        if (t->period_us) t->cb(t->arg);
+    }
+    return NULL;
+}
+
+esp_err_t hal_timer_start_periodic(const char *name, uint32_t period_us, hal_timer_cb_t cb, void *arg, hal_timer_t *out) {
+    (void)name;
+    if (!cb) return ESP_ERR_INVALID_ARG;
+    struct hal_timer *t = malloc(sizeof(*t));
+    if (!t) return ESP_ERR_NO_MEM;
+    t->cb = cb; t->arg = arg; t->period_us = period_us;
+    pthread_t th;
+    if (pthread_create(&th, NULL, sim_timer_thread, t) != 0) { free(t); return ESP_FAIL; }
+    pthread_detach(th);
+    if (out) *out = t;
+    return ESP_OK;
+}
+
+esp_err_t hal_timer_set_period(hal_timer_t timer, uint32_t period_us) {
+    if (!timer) return ESP_ERR_INVALID_ARG;
+    timer->period_us = period_us;
+    return ESP_OK;
+}
+
+// ===== 任务看门狗：仿真中不复位 =====
+esp_err_t hal_wdt_add_self(void) { return ESP_OK; }
+
+void hal_wdt_feed(void) {}
+
+// ===== OTA：镜像写入文件，结束时只检查大小与镜像魔数 =====
+struct hal_ota {
+    FILE *f;
+    size_t written;
+    uint8_t first;
+};
+static struct hal_ota s_ota;
+static bool s_ota_done;
+
+size_t hal_ota_partition_size(void) { return SIM_OTA_SIZE; }
+
+esp_err_t hal_ota_begin(hal_ota_t *out) {
+    const char *path = getenv("HAL_SIM_OTA_PATH");
+    s_ota.f = fopen(path ? path : "ota_image.bin", "wb");
+    if (!s_ota.f) return ESP_FAIL;
+    s_ota.written = 0;
+    s_ota_done = false;
+    *out = &s_ota;
+    return ESP_OK;
+}
+
+esp_err_t hal_ota_write(hal_ota_t ota, const void *data, size_t len) {
+    if (ota->written + len > SIM_OTA_SIZE) return ESP_ERR_INVALID_ARG;
+    if (ota->written == 0 && len) ota->first = *(const uint8_t *)data;
+    if (fwrite(data, 1, len, ota->f) != len) return ESP_FAIL;
+    ota->written += len;
+    return ESP_OK;
+}
+
+esp_err_t hal_ota_end(hal_ota_t ota) {
+    fclose(ota->f);
+    ota->f = NULL;
+    if (ota->written == 0 || ota->first != SIM_IMAGE_MAGIC) return ESP_ERR_INVALID_STATE;
+    s_ota_done = true;
+    return ESP_OK;
+}
+
+void hal_ota_abort(hal_ota_t ota) {
+    if (ota->f) fclose(ota->f);
+    ota->f = NULL;
+}
+
+esp_err_t hal_ota_set_boot(void) { return s_ota_done ? ESP_OK : ESP_ERR_INVALID_STATE; }
+
+void hal_ota_mark_valid(void) {}
+
+void hal_ota_rollback(void) {}
+
+void hal_restart(void) { exit(0); }
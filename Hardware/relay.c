@@ -1,82 +1,251 @@
 #include "relay.h"
-#include "driver/gpio.h"
-#include "driver/ledc.h"
+#include "hal.h"
 
-static int s_relay_gpio = -1;
-static bool s_relay_on = false;
-static bool s_pwm_mode = false;
-static int s_pwm_percent = 0;
+// LEDC 资源分配：RGB 占用 TIMER0/CH0~2，继电器输出共用 TIMER1，输出 n 使用 CH3+n
+#define RELAY_PWM_TIMER   1
+#define RELAY_PWM_CHANNEL 3
+#define RELAY_PWM_MAX_BITS 14          // ESP32-C3 LEDC 最大占空分辨率
+#define RELAY_LEDC_CLK_HZ 80000000u     // APB 时钟
+
+// 占空内部统一用 Q16（0~65536 对应 0~100%）
+#define DUTY_Q16_ONE      65536u
+
+static int s_relay_gpio[RELAY_MAX_OUTPUTS] = { -1, -1, -1 };
+static bool s_relay_on[RELAY_MAX_OUTPUTS];
+static bool s_pwm_mode[RELAY_MAX_OUTPUTS];
+static float s_percent[RELAY_MAX_OUTPUTS];
+static bool s_pwm_timer_ready = false;
+static int s_pwm_bits = 8;
+static uint32_t s_pwm_full = 1u << 8;            // 100% 对应的 LEDC 计数（LEDC 允许 duty = 2^bits 全开）
+static uint32_t s_pwm_written[RELAY_MAX_OUTPUTS] = { UINT32_MAX, UINT32_MAX, UINT32_MAX }; // 最近写入的计数
+static uint32_t s_dither_acc[RELAY_MAX_OUTPUTS]; // 残差累积（Q16）
+
+// 慢速调制器状态（由定时器回调推进）
+static relay_mod_cfg_t s_mod[RELAY_MAX_OUTPUTS];
+static volatile uint32_t s_duty_q16[RELAY_MAX_OUTPUTS];
+static bool s_mod_level[RELAY_MAX_OUTPUTS];       // 当前实际输出电平
+static uint32_t s_mod_state_ms[RELAY_MAX_OUTPUTS]; // 当前电平已保持时间
+static uint32_t s_win_pos_ms[RELAY_MAX_OUTPUTS];   // 窗口内位置
+static uint32_t s_win_on_ms[RELAY_MAX_OUTPUTS];    // 本窗口导通时长（窗口起点锁存）
+static int32_t s_sd_acc[RELAY_MAX_OUTPUTS];        // Σ-Δ 误差累积（Q16）
+static bool s_mod_timer_ready = false;
+static volatile bool s_inhibit = false;           // 安全切断锁定
+
+static inline bool out_valid(int out) { return out >= 0 && out < RELAY_MAX_OUTPUTS; }
+
+// 频率允许的最高分辨率：LEDC 分频系数需 >= 1，即 f * 2^bits <= 80MHz
+static int pwm_max_bits(int freq_hz) {
+    int bits = 1;
+    while (bits < RELAY_PWM_MAX_BITS && ((uint64_t)freq_hz << (bits + 1)) <= RELAY_LEDC_CLK_HZ) bits++;
+    return bits;
+}
+
+// 写 LEDC 占空计数；与上次相同则跳过（每次写入都要经过 ledc_update_duty 同步）
+static void pwm_write(int out, uint32_t counts) {
+    if (s_inhibit) counts = 0;
+    if (counts == s_pwm_written[out]) return;
+    s_pwm_written[out] = counts;
+    hal_pwm_set_duty(RELAY_PWM_CHANNEL + out, counts);
+}
+
+// Q16 占空 -> LEDC 计数；dither 时把小于 1 个计数的残差按节拍累积，溢出时多给 1 个计数
+static void pwm_apply(int out, bool dither) {
+    uint32_t q = s_duty_q16[out] * s_pwm_full;  // 计数的 Q16 表示（<= 2^30）
+    uint32_t counts = q >> 16;
+    uint32_t frac = q & 0xFFFFu;
+    if (!dither) {
+        counts += frac >= 0x8000u;
+    } else {
+        s_dither_acc[out] += frac;
+        if (s_dither_acc[out] >= DUTY_Q16_ONE) {
+            s_dither_acc[out] -= DUTY_Q16_ONE;
+            counts++;
+        }
+    }
+    pwm_write(out, counts);
+}
+
+// 直接驱动输出引脚：PWM 模式下用 0%/100% 占空代替 GPIO 电平
+static void out_drive(int out, bool on) {
+    if (s_pwm_mode[out]) {
+        pwm_write(out, on ? s_pwm_full : 0);
+    } else {
+        hal_gpio_set(s_relay_gpio[out], (on && !s_inhibit) ? 1 : 0);
+    }
+}
+
+// 时间比例：窗口起点按占空锁存导通时长，先开后关；不足最短开/关时间的部分取整到 0/整窗
+static bool mod_window(int out) {
+    const relay_mod_cfg_t *c = &s_mod[out];
+    if (s_win_pos_ms[out] == 0) {
+        uint32_t on = (uint32_t)(((uint64_t)s_duty_q16[out] * c->window_ms) >> 16);
+        if (on < c->min_on_ms) on = 0;
+        else if (c->window_ms - on < c->min_off_ms) on = c->window_ms;
+        s_win_on_ms[out] = on;
+    }
+    bool want = s_win_pos_ms[out] < s_win_on_ms[out];
+    s_win_pos_ms[out] += RELAY_MOD_TICK_MS;
+    if (s_win_pos_ms[out] >= c->window_ms) s_win_pos_ms[out] = 0;
+    return want;
+}
+
+// 一阶 Σ-Δ：每节拍累积占空，超过半格即导通并扣除一格；最短开/关时间内保持电平，误差留在累积器中
+static bool mod_sigma_delta(int out) {
+    const relay_mod_cfg_t *c = &s_mod[out];
+    s_sd_acc[out] += (int32_t)s_duty_q16[out];
+    bool want = s_sd_acc[out] >= (int32_t)(DUTY_Q16_ONE / 2);
+    if (s_mod_level[out] && s_mod_state_ms[out] < c->min_on_ms) want = true;
+    else if (!s_mod_level[out] && s_mod_state_ms[out] < c->min_off_ms) want = false;
+    if (want) s_sd_acc[out] -= (int32_t)DUTY_Q16_ONE;
+    return want;
+}
+
+static void relay_mod_tick(void *arg) {
+    (void)arg;
+    for (int out = 0; out < RELAY_MAX_OUTPUTS; out++) {
+        bool want;
+        switch (s_mod[out].mode) {
+        case RELAY_MODE_WINDOW:      want = mod_window(out); break;
+        case RELAY_MODE_SIGMA_DELTA: want = mod_sigma_delta(out); break;
+        default:
+            if (s_mod[out].dither && s_pwm_mode[out]) pwm_apply(out, true);
+            continue;
+        }
+        s_mod_state_ms[out] += RELAY_MOD_TICK_MS;
+        if (want != s_mod_level[out]) {
+            out_drive(out, want);
+            s_mod_level[out] = want;
+            s_mod_state_ms[out] = 0;
+        }
+    }
+}
 
 void relay_init(int gpio) {
-    s_relay_gpio = gpio;
-    s_pwm_mode = false;
-    gpio_config_t io = {
-        .pin_bit_mask = (1ULL<<s_relay_gpio),
-        .mode = GPIO_MODE_OUTPUT,
-        .pull_down_en = 0,
-        .pull_up_en = 0,
-        .intr_type = GPIO_INTR_DISABLE,
-    };
-    gpio_config(&io);
+    s_relay_gpio[0] = gpio;
+    s_pwm_mode[0] = false;
+    hal_gpio_output(gpio);
     relay_set(false);
 }
 
-void relay_set(bool on) {
-    s_relay_on = on;
-    if (!s_pwm_mode) {
-        gpio_set_level(s_relay_gpio, on ? 1 : 0);
-    } else {
+void relay_output_set(int out, bool on) {
+    if (!out_valid(out)) return;
+    if (s_mod[out].mode != RELAY_MODE_PWM) {
+        // 慢速调制下，on/off 等价于 100%/0%，由调制器按最短开/关时间执行
+        relay_set_output_percent(out, on ? 100 : 0);
+        return;
+    }
+    if (s_pwm_mode[out]) {
         // PWM 模式下，on/off 可作为 100%/0% 的快捷设置
-        ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_3, on ? 255 : 0);
-        ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_3);
-        s_pwm_percent = on ? 100 : 0;
+        relay_set_output_percent_f(out, on ? 100.0f : 0.0f);
+        return;
+    }
+    s_relay_on[out] = on;
+    out_drive(out, on);
+}
+
+void relay_set(bool on) { relay_output_set(0, on); }
+
+void relay_toggle(void) { relay_set(!s_relay_on[0]); }
+
+// 安全切断期间输出被强制关断，按关断报告
+bool relay_get(void) { return s_relay_on[0] && !s_inhibit; }
+
+void relay_init_pwm_output(int out, int gpio, int freq_hz) {
+    if (!out_valid(out)) return;
+    s_relay_gpio[out] = gpio;
+    s_pwm_mode[out] = true;
+    // 所有输出共用一个定时器，频率以首次初始化为准；分辨率取该频率允许的最高值
+    if (!s_pwm_timer_ready) {
+        if (freq_hz <= 0) freq_hz = 1000;
+        s_pwm_bits = pwm_max_bits(freq_hz);
+        s_pwm_full = 1u << s_pwm_bits;
+        hal_pwm_timer_init(RELAY_PWM_TIMER, (uint32_t)freq_hz, s_pwm_bits);
+        s_pwm_timer_ready = true;
     }
+    hal_pwm_channel_init(RELAY_PWM_CHANNEL + out, RELAY_PWM_TIMER, gpio);
+    s_pwm_written[out] = 0;   // 通道初始化时占空为 0
 }
 
-void relay_toggle(void) { relay_set(!s_relay_on); }
-
-bool relay_get(void) { return s_relay_on; }
-
-void relay_init_pwm(int gpio, int freq_hz) {
-    s_relay_gpio = gpio;
-    s_pwm_mode = true;
-    ledc_timer_config_t t = {
-        .speed_mode = LEDC_LOW_SPEED_MODE,
-        .timer_num = LEDC_TIMER_1,
-        .duty_resolution = LEDC_TIMER_8_BIT,
-        .freq_hz = freq_hz > 0 ? freq_hz : 1000,
-        .clk_cfg = LEDC_AUTO_CLK,
-    };
-    ledc_timer_config(&t);
-    ledc_channel_config_t ch = {
-        .gpio_num = s_relay_gpio,
-        .speed_mode = LEDC_LOW_SPEED_MODE,
-        .channel = LEDC_CHANNEL_3,
-        .timer_sel = LEDC_TIMER_1,
-        .duty = 0,
-        .intr_type = LEDC_INTR_DISABLE,
-    };
-    ledc_channel_config(&ch);
+void relay_init_pwm(int gpio, int freq_hz) { relay_init_pwm_output(0, gpio, freq_hz); }
+
+void relay_set_output_mode(int out, const relay_mod_cfg_t *cfg) {
+    if (!out_valid(out) || !cfg) return;
+    relay_mod_cfg_t c = *cfg;
+    if (c.mode == RELAY_MODE_WINDOW && c.window_ms < RELAY_MOD_TICK_MS) c.window_ms = RELAY_MOD_TICK_MS;
+    // 先切到 PWM 让定时器回调跳过该路，再复位调制器状态
+    s_mod[out].mode = RELAY_MODE_PWM;
+    s_mod_level[out] = false;
+    s_mod_state_ms[out] = c.min_off_ms;   // 允许立即导通
+    s_win_pos_ms[out] = 0;
+    s_sd_acc[out] = 0;
+    s_dither_acc[out] = 0;
+    out_drive(out, false);
+    s_mod[out] = c;
+    if ((c.mode != RELAY_MODE_PWM || c.dither) && !s_mod_timer_ready) {
+        s_mod_timer_ready = hal_timer_start_periodic("relay_mod", RELAY_MOD_TICK_MS * 1000u, relay_mod_tick, NULL, NULL) == ESP_OK;
+    }
+    if (c.mode == RELAY_MODE_PWM) relay_set_output_percent_f(out, s_percent[out]);
 }
 
-void relay_set_pwm_percent(int percent) {
-    if (!s_pwm_mode) {
+void relay_set_output_percent_f(int out, float percent) {
+    if (!out_valid(out)) return;
+    if (!(percent > 0.0f)) {          // 同时吞掉 NaN
+        percent = 0.0f;
+    } else if (percent > 100.0f) {
+        percent = 100.0f;
+    }
+    uint32_t q = (uint32_t)(percent * (DUTY_Q16_ONE / 100.0f) + 0.5f);
+    if (s_mod[out].mode == RELAY_MODE_PWM && !s_pwm_mode[out]) {
         // 未开启 PWM，退化为阈值开关
-        relay_set(percent >= 50);
+        s_relay_on[out] = percent >= 50.0f;
+        s_percent[out] = s_relay_on[out] ? 100.0f : 0.0f;
+        out_drive(out, s_relay_on[out]);
         return;
     }
-    if (percent < 0) {
-        percent = 0;
-    } else if (percent > 100) {
-        percent = 100;
-    }
-    uint32_t duty = (uint32_t)(percent * 255 / 100);
-    ledc_set_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_3, duty);
-    ledc_update_duty(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_3);
-    s_relay_on = (percent > 0);
-    s_pwm_percent = percent;
+    s_duty_q16[out] = q;
+    s_relay_on[out] = (q > 0);
+    s_percent[out] = percent;
+    // 慢速调制与 dither 由定时器回调推进输出；纯 PWM 立即写入（相同计数跳过）
+    if (s_mod[out].mode == RELAY_MODE_PWM && !(s_mod[out].dither && s_mod_timer_ready)) pwm_apply(out, false);
 }
 
-int relay_get_pwm_percent(void) { return s_pwm_percent; }
+void relay_set_output_percent(int out, int percent) { relay_set_output_percent_f(out, (float)percent); }
+
+void relay_set_pwm_percent(int percent) { relay_set_output_percent(0, percent); }
+
+float relay_get_output_percent_f(int out) { return out_valid(out) ? s_percent[out] : 0.0f; }
+
+int relay_get_output_percent(int out) { return (int)(relay_get_output_percent_f(out) + 0.5f); }
+
+int relay_get_pwm_percent(void) { return relay_get_output_percent(0); }
 
+// 直接写驱动，不经写入缓存：即使缓存认为已是 0 也再写一次
+void relay_safety_cutoff(void) {
+    s_inhibit = true;
+    for (int out = 0; out < RELAY_MAX_OUTPUTS; out++) {
+        if (s_pwm_mode[out]) {
+            hal_pwm_set_duty(RELAY_PWM_CHANNEL + out, 0);
+            s_pwm_written[out] = 0;
+        } else if (s_relay_gpio[out] >= 0) {
+            hal_gpio_set(s_relay_gpio[out], 0);
+        }
+    }
+}
+
+// 解除后调制器从关断电平重新开始；占空目标清零（锁存期间写入的目标与停止前残留的目标均不恢复），
+// 由控制方重新设置
+void relay_safety_release(void) {
+    for (int out = 0; out < RELAY_MAX_OUTPUTS; out++) {
+        s_duty_q16[out] = 0;
+        s_percent[out] = 0.0f;
+        s_relay_on[out] = false;
+        s_dither_acc[out] = 0;
+        s_mod_level[out] = false;
+        s_mod_state_ms[out] = 0;
+        s_win_pos_ms[out] = 0;
+        s_sd_acc[out] = 0;
+    }
+    s_inhibit = false;
+}
 
+bool relay_safety_inhibited(void) { return s_inhibit; }
@@ -2,6 +2,10 @@
 #define RELAY_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+// 继电器/SSR 输出路数（受 LEDC 通道数限制：CH0~2 给 RGB，CH3~5 给加热输出）
+#define RELAY_MAX_OUTPUTS 3
 
 void relay_init(int gpio);
 void relay_set(bool on);
@@ -15,5 +19,43 @@ void relay_init_pwm(int gpio, int freq_hz);
 void relay_set_pwm_percent(int percent);
 int relay_get_pwm_percent(void);
 
-#endif
+// 多路输出（out = 0..RELAY_MAX_OUTPUTS-1；上面的单路接口等价于 out 0）
+void relay_init_pwm_output(int out, int gpio, int freq_hz);
+void relay_output_set(int out, bool on);
+void relay_set_output_percent(int out, int percent);
+int relay_get_output_percent(int out);
+
+// 连续占空（0.0-100.0%）：PWM 模式下按频率允许的最高 LEDC 分辨率输出（1kHz 时 14 位），
+// 慢速调制下以 Q16 精度进入调制器；占空计数未变化时不重复写 LEDC
+void relay_set_output_percent_f(int out, float percent);
+float relay_get_output_percent_f(int out);
+
+// 输出调制方式：PWM 直接走 LEDC；慢速模式由定时器按 RELAY_MOD_TICK_MS 节拍开关输出
+typedef enum {
+    RELAY_MODE_PWM = 0,       // LEDC 快速 PWM（MOSFET / 随机导通型 SSR）
+    RELAY_MODE_WINDOW,        // 时间比例：每个窗口内先开后关（机械继电器）
+    RELAY_MODE_SIGMA_DELTA,   // 一阶 Σ-Δ；节拍取市电半波、最短开关为 0 即过零 SSR 的整半波群控
+} relay_mode_t;
+
+typedef struct {
+    relay_mode_t mode;
+    uint32_t window_ms;       // WINDOW：窗口长度
+    uint32_t min_on_ms;       // 最短导通时间（WINDOW / SIGMA_DELTA）
+    uint32_t min_off_ms;      // 最短关断时间（WINDOW / SIGMA_DELTA）
+    bool dither;              // PWM：不足 1 个 LEDC 计数的残差按节拍时间抖动输出
+} relay_mod_cfg_t;
 
+// 调制节拍 (ms)：50Hz 市电半波
+#define RELAY_MOD_TICK_MS 10
+
+// 安全切断（安全监控任务调用）：立即把全部加热输出拉到关断并锁定；锁定期间的占空/开关设置
+// 只更新目标值、不驱动引脚。调用方在锁存期间按周期重复调用，覆盖与其它任务写输出的竞争
+void relay_safety_cutoff(void);
+// 解除锁定：全部占空目标清零，输出保持关断直到控制方重新设置
+void relay_safety_release(void);
+bool relay_safety_inhibited(void);
+
+// 选择输出调制方式（默认 RELAY_MODE_PWM，无 dither）；慢速模式/dither 下设置占空只更新目标值
+void relay_set_output_mode(int out, const relay_mod_cfg_t *cfg);
+
+#endif
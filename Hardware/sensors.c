@@ -0,0 +1,163 @@
+#include "sensors.h"
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "hal.h"
+#include "temperature.h"
+#include "battery_monitor.h"
+
+static const char *TAG = "SENSORS";
+
+typedef struct {
+    bool used;
+    uint8_t kind;
+    uint32_t period_ms;
+    int64_t next_us;            // 下次采样时刻（仅采集任务访问）
+    temp_source_t *src;         // SENSOR_SOURCE
+    sensor_reading_t last;      // 发布值（持锁读写）
+} sensor_slot_t;
+
+static sensor_slot_t s_slots[SENSOR_MAX_CHANNELS];
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t s_task = NULL;
+
+static void sensor_publish(sensor_slot_t *slot, sensor_reading_t *r) {
+    r->t_us = hal_time_us();
+    portENTER_CRITICAL(&s_lock);
+    r->seq = slot->last.seq + 1;
+    slot->last = *r;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+// 取回温度源读数并发布；故障映射为 NTC 同样的无效温度，控制/安全按 temperature_valid 处理
+static void source_finish(int id, sensor_slot_t *slot) {
+    temp_sample_t t;
+    slot->src->end(slot->src, &t);
+    sensor_reading_t r = { .raw = (int)t.raw, .mv = 0, .fault = (uint8_t)t.fault };
+    if (t.fault == TEMP_FAULT_NONE) r.value = t.temp;
+    else r.value = (t.fault == TEMP_FAULT_SHORT_GND || t.fault == TEMP_FAULT_SHORT_VCC) ? TEMP_SHORT_C : TEMP_OPEN_C;
+    if (r.fault != slot->last.fault) {
+        ESP_LOGW(TAG, "sensor %d (%s): fault %s", id, slot->src->name, temp_fault_name(t.fault));
+    }
+    sensor_publish(slot, &r);
+}
+
+// 采样 + 换算 + 发布；只在采集任务（及任务创建前的注册）中调用
+// 安全监控与外设基准也直接做单次转换（hal 层对单次转换加互斥锁），换算只用本次 r.raw，不读共享的“最近一次”状态
+static void sensor_sample(int ch, sensor_slot_t *slot) {
+    sensor_reading_t r = { 0 };
+    if (slot->kind == SENSOR_SOURCE) {
+        slot->src->begin(slot->src);
+        source_finish(ch, slot);
+        return;
+    }
+    if (slot->kind == SENSOR_NTC) {
+        r.raw = temperature_read_raw_channel(ch);
+        r.value = temperature_from_raw(r.raw);
+        r.mv = hal_adc_raw_to_mv(r.raw);
+    } else {
+        r.raw = hal_adc_read_raw(ch);
+        r.mv = hal_adc_raw_to_mv(r.raw);
+        r.value = battery_voltage_from_mv(r.mv);
+    }
+    sensor_publish(slot, &r);
+}
+
+// 到期的通道逐个采样，然后睡到最早的下一次到期
+// 温度源分两段：先全部发起（SPI 事务排队，DMA 后台传输），ADC 采样之后再取回
+static void sensors_task(void *arg) {
+    for (;;) {
+        int64_t now = hal_time_us();
+        int64_t next = now + 1000000;
+        uint32_t due = 0;
+        for (int ch = 0; ch < SENSOR_MAX_CHANNELS; ch++) {
+            if (s_slots[ch].used && now >= s_slots[ch].next_us) due |= 1u << ch;
+        }
+        uint32_t src_due = 0;
+        for (int ch = SENSOR_SRC_ID(0); ch < SENSOR_MAX_CHANNELS; ch++) {
+            if ((due & (1u << ch)) && s_slots[ch].kind == SENSOR_SOURCE) {
+                s_slots[ch].src->begin(s_slots[ch].src);
+                src_due |= 1u << ch;
+            }
+        }
+        for (uint32_t m = due & ~src_due; m; m &= m - 1) {
+            int ch = __builtin_ctz(m);
+            sensor_sample(ch, &s_slots[ch]);
+        }
+        for (uint32_t m = src_due; m; m &= m - 1) {
+            int ch = __builtin_ctz(m);
+            source_finish(ch, &s_slots[ch]);
+        }
+        for (int ch = 0; ch < SENSOR_MAX_CHANNELS; ch++) {
+            sensor_slot_t *slot = &s_slots[ch];
+            if (!slot->used) continue;
+            if (due & (1u << ch)) {
+                slot->next_us += (int64_t)slot->period_ms * 1000;
+                // 落后超过一个周期（长时间被抢占）时不补采，从当前时刻重新计
+                if (slot->next_us < now) slot->next_us = now + (int64_t)slot->period_ms * 1000;
+            }
+            if (slot->next_us < next) next = slot->next_us;
+        }
+        int64_t wait_ms = (next - hal_time_us() + 999) / 1000;
+        TickType_t ticks = wait_ms > 0 ? pdMS_TO_TICKS(wait_ms) : 0;
+        // 新注册通道的通知会提前结束等待；至少让出一个 tick
+        ulTaskNotifyTake(pdTRUE, ticks ? ticks : 1);
+    }
+}
+
+// 占用编号 id 的槽位；首次注册时采样一次并在需要时创建采集任务
+static esp_err_t sensor_register(int id, sensor_kind_t kind, temp_source_t *src, uint32_t period_ms) {
+    sensor_slot_t *slot = &s_slots[id];
+    if (slot->used) {
+        if (slot->kind != kind || slot->src != src) return ESP_ERR_INVALID_STATE;
+        // 同一通道被多个温区共用时保留较短周期
+        if (period_ms < slot->period_ms) slot->period_ms = period_ms;
+        return ESP_OK;
+    }
+    slot->kind = (uint8_t)kind;
+    slot->src = src;
+    slot->period_ms = period_ms;
+    if (!s_task) {
+        // 采集任务尚未运行，ADC 无其它访问者，直接在调用方采样
+        sensor_sample(id, slot);
+        slot->next_us = slot->last.t_us + (int64_t)period_ms * 1000;
+        slot->used = true;
+        xTaskCreate(sensors_task, "sensors", 3072, NULL, SENSOR_TASK_PRIO, &s_task);
+    } else {
+        // 由采集任务完成首次采样，等待其发布（ADC 始终只有一个访问者）
+        slot->next_us = 0;
+        slot->used = true;
+        xTaskNotifyGive(s_task);
+        for (int i = 0; i < 10 && slot->last.seq == 0; i++) vTaskDelay(1);
+    }
+    ESP_LOGI(TAG, "channel %d: kind=%d period=%lums", id, (int)kind, (unsigned long)period_ms);
+    return ESP_OK;
+}
+
+esp_err_t sensors_add_channel(int adc_channel, sensor_kind_t kind, uint32_t period_ms) {
+    if (adc_channel < 0 || adc_channel >= SENSOR_ADC_CHANNELS || period_ms == 0 || kind == SENSOR_SOURCE) return ESP_ERR_INVALID_ARG;
+    return sensor_register(adc_channel, kind, NULL, period_ms);
+}
+
+esp_err_t sensors_add_source(int id, temp_source_t *src, uint32_t period_ms) {
+    if (id < SENSOR_SRC_ID(0) || id >= SENSOR_MAX_CHANNELS || !src || period_ms == 0) return ESP_ERR_INVALID_ARG;
+    if (period_ms < src->min_period_ms) period_ms = src->min_period_ms;
+    return sensor_register(id, SENSOR_SOURCE, src, period_ms);
+}
+
+bool sensors_get(int adc_channel, sensor_reading_t *out) {
+    if (adc_channel < 0 || adc_channel >= SENSOR_MAX_CHANNELS || !s_slots[adc_channel].used) {
+        memset(out, 0, sizeof(*out));
+        return false;
+    }
+    portENTER_CRITICAL(&s_lock);
+    *out = s_slots[adc_channel].last;
+    portEXIT_CRITICAL(&s_lock);
+    return true;
+}
+
+float sensors_value(int adc_channel) {
+    sensor_reading_t r;
+    return sensors_get(adc_channel, &r) ? r.value : 0.0f;
+}
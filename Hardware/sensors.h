@@ -0,0 +1,51 @@
+#ifndef SENSORS_H
+#define SENSORS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "temp_source.h"
+
+// 传感器采集服务：各通道按自己的周期采样、换算并发布带时间戳的缓存值
+// HTTP/显示/控制/遥测只读缓存（O(1)，按通道号直接索引），不触发硬件访问；
+// 另有安全监控（独立于缓存做单次转换）与外设基准直接读 ADC，hal 层对单次转换加互斥锁
+// 传感器编号：0 ~ SENSOR_ADC_CHANNELS-1 为 ADC1 通道号，SENSOR_SRC_ID(n) 为外部温度源（temp_source.h）
+#define SENSOR_ADC_CHANNELS 10
+#define SENSOR_SRC_MAX      4
+#define SENSOR_SRC_ID(n)    (SENSOR_ADC_CHANNELS + (n))
+#define SENSOR_MAX_CHANNELS (SENSOR_ADC_CHANNELS + SENSOR_SRC_MAX)
+#define SENSOR_TASK_PRIO    6           // 高于控制任务，控制周期读到的总是最新值
+#define SENSOR_NTC_PERIOD_MS 50         // NTC：与最快控制周期一致
+#define SENSOR_BATT_PERIOD_MS 2000      // 电池：变化缓慢
+
+// 换算方式
+typedef enum {
+    SENSOR_NTC = 0,     // value = 温度 (°C)，temperature_from_raw
+    SENSOR_BATTERY,     // value = 电池电压 (V)，分压系数见 battery_monitor_init
+    SENSOR_SOURCE,      // value = 温度 (°C)，温度源故障时为 TEMP_OPEN_C/TEMP_SHORT_C；raw 为原始帧
+} sensor_kind_t;
+
+typedef struct {
+    int raw;            // 多次平均后的原始值
+    int mv;             // 等效电压 (mV)
+    float value;        // 换算值（单位见 sensor_kind_t）
+    int64_t t_us;       // 采样时刻（hal_time_us）
+    uint32_t seq;       // 累计采样次数
+    uint8_t fault;      // 温度源故障（temp_fault_t），NTC/电池恒为 0
+} sensor_reading_t;
+
+// 注册通道（通道须已由驱动 init 配置）；注册时同步采样一次，返回后即有有效缓存
+// 首次注册时创建采集任务
+esp_err_t sensors_add_channel(int adc_channel, sensor_kind_t kind, uint32_t period_ms);
+
+// 注册外部温度源（id 为 SENSOR_SRC_ID(n)）；周期不短于源的 min_period_ms
+// 每轮先对到期的源发起读取，ADC 采样完成后再取回，SPI 传输与 ADC 转换重叠
+esp_err_t sensors_add_source(int id, temp_source_t *src, uint32_t period_ms);
+
+// 读取最新缓存；通道未注册返回 false
+bool sensors_get(int adc_channel, sensor_reading_t *out);
+
+// 仅取换算值；通道未注册返回 0
+float sensors_value(int adc_channel);
+
+#endif
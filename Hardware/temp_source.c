@@ -0,0 +1,62 @@
+#include "temp_source.h"
+#include <math.h>
+#include "freertos/FreeRTOS.h"
+
+const char *temp_fault_name(temp_fault_t fault) {
+    switch (fault) {
+    case TEMP_FAULT_NONE:      return "none";
+    case TEMP_FAULT_OPEN:      return "open";
+    case TEMP_FAULT_SHORT_GND: return "short_gnd";
+    case TEMP_FAULT_SHORT_VCC: return "short_vcc";
+    case TEMP_FAULT_NO_DEVICE: return "no_device";
+    case TEMP_FAULT_BUS:       return "bus";
+    }
+    return "?";
+}
+
+// ===== 模拟源 =====
+typedef struct {
+    float temp;
+    temp_fault_t fault;
+    uint32_t reads;
+    temp_source_t src;
+} temp_mock_t;
+
+static temp_mock_t s_mocks[TEMP_MOCK_MAX];
+static int s_mock_count = 0;
+static portMUX_TYPE s_mock_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static esp_err_t mock_begin(temp_source_t *src) { return ESP_OK; }
+
+static void mock_end(temp_source_t *src, temp_sample_t *out) {
+    temp_mock_t *m = src->ctx;
+    portENTER_CRITICAL(&s_mock_lock);
+    out->temp = m->temp;
+    out->fault = m->fault;
+    m->reads++;
+    portEXIT_CRITICAL(&s_mock_lock);
+    out->cold_junction = NAN;
+    out->raw = 0;
+}
+
+temp_source_t *temp_mock_add(float temp) {
+    if (s_mock_count >= TEMP_MOCK_MAX) return NULL;
+    temp_mock_t *m = &s_mocks[s_mock_count++];
+    m->temp = temp;
+    m->fault = TEMP_FAULT_NONE;
+    m->src = (temp_source_t){ .name = "mock", .min_period_ms = 0, .begin = mock_begin, .end = mock_end, .ctx = m };
+    return &m->src;
+}
+
+void temp_mock_set(temp_source_t *src, float temp, temp_fault_t fault) {
+    temp_mock_t *m = src->ctx;
+    portENTER_CRITICAL(&s_mock_lock);
+    m->temp = temp;
+    m->fault = fault;
+    portEXIT_CRITICAL(&s_mock_lock);
+}
+
+uint32_t temp_mock_reads(temp_source_t *src) {
+    temp_mock_t *m = src->ctx;
+    return m->reads;
+}
@@ -0,0 +1,45 @@
+#ifndef TEMP_SOURCE_H
+#define TEMP_SOURCE_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+// 温度源：NTC 之外的温度输入（SPI 热电偶、仿真/测试用模拟源）的统一接口
+// 两段式读取：采集任务先对所有到期的源调用 begin（SPI 后端排队 DMA 事务后立即返回），
+// 完成本轮 ADC 采样后再逐个 end 取回；控制任务只读采集服务缓存（sensors_get），与源类型无关
+typedef enum {
+    TEMP_FAULT_NONE = 0,
+    TEMP_FAULT_OPEN,        // 热电偶开路
+    TEMP_FAULT_SHORT_GND,   // 短路到 GND
+    TEMP_FAULT_SHORT_VCC,   // 短路到 VCC
+    TEMP_FAULT_NO_DEVICE,   // 无应答/帧格式错误（保留位非 0、全 1）
+    TEMP_FAULT_BUS,         // 传输失败或超时
+} temp_fault_t;
+
+typedef struct {
+    float temp;             // 测量温度 (°C)，fault 非 0 时无意义
+    float cold_junction;    // 冷端温度 (°C)；无冷端输出的器件为 NAN
+    uint32_t raw;           // 原始帧
+    temp_fault_t fault;
+} temp_sample_t;
+
+typedef struct temp_source temp_source_t;
+struct temp_source {
+    const char *name;
+    uint32_t min_period_ms;     // 器件转换时间：采样间隔不短于此值（MAX6675 读取会中止进行中的转换）
+    esp_err_t (*begin)(temp_source_t *src);
+    // 取回 begin 发起的读取；失败时 out->fault 为 TEMP_FAULT_BUS
+    void (*end)(temp_source_t *src, temp_sample_t *out);
+    void *ctx;
+};
+
+const char *temp_fault_name(temp_fault_t fault);
+
+// ===== 模拟源：读数由 temp_mock_set 设定，不访问硬件（主机测试、无传感器调试） =====
+#define TEMP_MOCK_MAX 4
+temp_source_t *temp_mock_add(float temp);   // 池满返回 NULL
+void temp_mock_set(temp_source_t *src, float temp, temp_fault_t fault);
+// begin/end 调用计数（检查采集节拍）
+uint32_t temp_mock_reads(temp_source_t *src);
+
+#endif
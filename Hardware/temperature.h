@@ -1,8 +1,6 @@
 #ifndef TEMPERATURE_H
 #define TEMPERATURE_H
 
-// 需要 ADC 类型定义（使用新HAL类型，避免旧驱动告警）
-#include "hal/adc_types.h"
 // 温度传感器常量
 #define NTC_R25 10000.0     // 25°C时的电阻值 (10kΩ)
 #define NTC_B 3950.0        // B常数
@@ -12,10 +10,19 @@
 
 // 函数声明
 // 初始化温度传感器（ADC通道、参考电阻、供电电压）
-void temperature_init(adc_channel_t temp_channel, float ref_res_ohm, float vcc_volt);
+void temperature_init(int temp_channel, float ref_res_ohm, float vcc_volt);
 float temperature_read(void);         // 读取当前温度 (°C)
-int temperature_get_last_raw(void);   // 最近一次温度ADC原始值
-int temperature_get_last_mv(void);    // 最近一次温度等效电压(mV)
+int temperature_read_raw(void);       // 仅采样：多次平均后的 ADC 原始值
+float temperature_from_raw(int raw);  // 仅换算：ADC 原始值 -> 温度 (°C)，无副作用，可多任务并发调用
+void temperature_add_channel(int channel);          // 追加 NTC 通道（多温区，分压参数同主通道）
+int temperature_read_raw_channel(int channel);      // 指定通道采样
+int temperature_get_last_raw(void);   // 最近一次 temperature_read 的 ADC 原始值
+int temperature_get_last_mv(void);    // 最近一次 temperature_read 的等效电压(mV)
+
+// NTC 开路/短路时 temperature_from_raw 的返回值；控制与显示前用 temperature_valid 判断
+#define TEMP_OPEN_C   999.0f
+#define TEMP_SHORT_C  (-999.0f)
+static inline int temperature_valid(float t) { return t > TEMP_SHORT_C && t < TEMP_OPEN_C; }
 
 // 温度报警阈值
 #define TEMP_ALARM_HIGH 80.0    // 高温报警阈值 (°C)
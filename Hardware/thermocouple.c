@@ -0,0 +1,146 @@
+#include "thermocouple.h"
+#include <math.h>
+#include "esp_log.h"
+#include "hal.h"
+
+static const char *TAG = "TC";
+
+#define TC_READ_TIMEOUT_MS 10   // 4 字节 @4MHz 约 10 µs，超时只在总线异常时出现
+
+typedef struct {
+    tc_cfg_t cfg;
+    hal_spi_dev_t dev;
+    bool started;           // begin 成功，end 需取回
+    temp_source_t src;
+} tc_dev_t;
+
+static tc_dev_t s_devs[TC_MAX_DEVICES];
+static int s_count = 0;
+
+// ===== 解码 =====
+void tc_decode_max31855(uint32_t frame, temp_sample_t *out) {
+    out->raw = frame;
+    // D17、D3 保留位恒为 0；全 1 为 MISO 悬空
+    if (frame == 0xFFFFFFFFu || (frame & ((1u << 17) | (1u << 3)))) {
+        out->cold_junction = NAN;
+        out->fault = TEMP_FAULT_NO_DEVICE;
+        return;
+    }
+    // 冷端 D15..D4 总是有效（有符号，0.0625 °C）
+    out->cold_junction = (float)((int32_t)(frame << 16) >> 20) * 0.0625f;
+    if (frame & (1u << 16)) {
+        out->fault = (frame & 0x01) ? TEMP_FAULT_OPEN : (frame & 0x02) ? TEMP_FAULT_SHORT_GND : TEMP_FAULT_SHORT_VCC;
+        return;
+    }
+    out->fault = TEMP_FAULT_NONE;
+    out->temp = (float)((int32_t)frame >> 18) * 0.25f;
+}
+
+void tc_decode_max6675(uint16_t frame, temp_sample_t *out) {
+    out->raw = frame;
+    out->cold_junction = NAN;
+    // D15 恒为 0，D1 为器件 ID 恒为 0
+    if (frame & 0x8002u) {
+        out->fault = TEMP_FAULT_NO_DEVICE;
+        return;
+    }
+    if (frame & 0x04) {
+        out->fault = TEMP_FAULT_OPEN;
+        return;
+    }
+    out->fault = TEMP_FAULT_NONE;
+    out->temp = (float)(frame >> 3) * 0.25f;
+}
+
+// ===== NIST ITS-90 K 型：E(t) 热电势 (mV)，t(E) 反函数 =====
+static const float K_E_NEG[] = { 0.0f, 3.9450128025e-2f, 2.3622373598e-5f, -3.2858906784e-7f, -4.9904828777e-9f,
+                                 -6.7509059173e-11f, -5.7410327428e-13f, -3.1088872894e-15f, -1.0451609365e-17f,
+                                 -1.9889266878e-20f, -1.6322697486e-23f };
+static const float K_E_POS[] = { -1.7600413686e-2f, 3.8921204975e-2f, 1.8558770032e-5f, -9.9457592874e-8f,
+                                 3.1840945719e-10f, -5.6072844889e-13f, 5.6075059059e-16f, -3.2020720003e-19f,
+                                 9.7151147152e-23f, -1.2104721275e-26f };
+static const float K_T_NEG[] = { 0.0f, 2.5173462e1f, -1.1662878f, -1.0833638f, -8.9773540e-1f, -3.7342377e-1f,
+                                 -8.6632643e-2f, -1.0450598e-2f, -5.1920577e-4f };
+static const float K_T_MID[] = { 0.0f, 2.508355e1f, 7.860106e-2f, -2.503131e-1f, 8.315270e-2f, -1.228034e-2f,
+                                 9.804036e-4f, -4.413030e-5f, 1.057734e-6f, -1.052755e-8f };
+static const float K_T_HIGH[] = { -1.318058e2f, 4.830222e1f, -1.646031f, 5.464731e-2f, -9.650715e-4f,
+                                  8.802193e-6f, -3.110810e-8f };
+#define K_SEEBECK_MV 0.041276f  // MAX31855 内部使用的线性系数 (mV/°C)
+
+static float poly(const float *c, int n, float x) {
+    float r = 0.0f;
+    for (int i = n - 1; i >= 0; i--) r = r * x + c[i];
+    return r;
+}
+
+static float k_emf_mv(float t) {
+    if (t < 0.0f) return poly(K_E_NEG, 11, t);
+    float d = t - 126.9686f;
+    return poly(K_E_POS, 10, t) + 0.1185976f * expf(-1.183432e-4f * d * d);
+}
+
+static float k_temp_c(float mv) {
+    if (mv < 0.0f) return poly(K_T_NEG, 9, mv);
+    if (mv < 20.644f) return poly(K_T_MID, 10, mv);
+    return poly(K_T_HIGH, 7, mv);
+}
+
+// 由读数还原热电偶电势，加上冷端电势后查反函数
+float tc_k_nist_correct(float tc_c, float cj_c) {
+    float mv = (tc_c - cj_c) * K_SEEBECK_MV + k_emf_mv(cj_c);
+    return k_temp_c(mv);
+}
+
+// ===== 温度源 =====
+static esp_err_t tc_begin(temp_source_t *src) {
+    tc_dev_t *d = src->ctx;
+    // 上次超时的事务仍在队列中：本轮 end 取回它
+    if (d->started) return ESP_ERR_INVALID_STATE;
+    esp_err_t err = hal_spi_read_start(d->dev, d->cfg.chip == TC_MAX6675 ? 2 : 4);
+    d->started = err == ESP_OK;
+    return err;
+}
+
+static void tc_end(temp_source_t *src, temp_sample_t *out) {
+    tc_dev_t *d = src->ctx;
+    uint8_t rx[4];
+    out->cold_junction = NAN;
+    esp_err_t err = d->started ? hal_spi_read_finish(d->dev, rx, TC_READ_TIMEOUT_MS) : ESP_ERR_INVALID_STATE;
+    if (err != ESP_ERR_TIMEOUT) d->started = false;
+    if (err != ESP_OK) {
+        out->fault = TEMP_FAULT_BUS;
+        return;
+    }
+    if (d->cfg.chip == TC_MAX6675) {
+        tc_decode_max6675((uint16_t)(rx[0] << 8 | rx[1]), out);
+    } else {
+        tc_decode_max31855((uint32_t)rx[0] << 24 | (uint32_t)rx[1] << 16 | (uint32_t)rx[2] << 8 | rx[3], out);
+        if (out->fault == TEMP_FAULT_NONE && d->cfg.nist) out->temp = tc_k_nist_correct(out->temp, out->cold_junction);
+    }
+}
+
+esp_err_t thermocouple_bus_init(int spi_host, int sclk_io, int miso_io) {
+    esp_err_t err = hal_spi_bus_init(spi_host, sclk_io, miso_io, -1);
+    if (err != ESP_OK) ESP_LOGE(TAG, "spi bus %d init failed: %d", spi_host, err);
+    return err;
+}
+
+temp_source_t *thermocouple_add(const tc_cfg_t *cfg) {
+    if (s_count >= TC_MAX_DEVICES) return NULL;
+    tc_dev_t *d = &s_devs[s_count];
+    if (hal_spi_device_add(cfg->spi_host, cfg->cs_io, TC_SPI_CLK_HZ, 0, &d->dev) != ESP_OK) {
+        ESP_LOGE(TAG, "add cs=%d failed", cfg->cs_io);
+        return NULL;
+    }
+    d->cfg = *cfg;
+    d->src = (temp_source_t){
+        .name = cfg->chip == TC_MAX6675 ? "max6675" : "max31855",
+        .min_period_ms = cfg->chip == TC_MAX6675 ? TC_PERIOD_MAX6675 : TC_PERIOD_MAX31855,
+        .begin = tc_begin,
+        .end = tc_end,
+        .ctx = d,
+    };
+    s_count++;
+    ESP_LOGI(TAG, "%s cs=%d nist=%d", d->src.name, cfg->cs_io, (int)cfg->nist);
+    return &d->src;
+}
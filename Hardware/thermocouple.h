@@ -0,0 +1,42 @@
+#ifndef THERMOCOUPLE_H
+#define THERMOCOUPLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "temp_source.h"
+
+// SPI K 型热电偶转换器（只读，SPI 模式 0）：
+//   MAX31855  32 位帧：热端 14 位 0.25 °C、冷端 12 位 0.0625 °C、开路/短路故障位，-200~1350 °C
+//   MAX6675   16 位帧：12 位 0.25 °C（内部已做冷端补偿）、开路位，0~1024 °C
+// 解码为整数移位，每次采样不做对数/除法运算
+#define TC_MAX_DEVICES     4
+#define TC_SPI_CLK_HZ      4000000     // MAX6675 上限 4.3 MHz，MAX31855 5 MHz
+#define TC_PERIOD_MAX31855 100         // 转换时间 (ms)
+#define TC_PERIOD_MAX6675  250         // 转换 220 ms；CS 拉低会中止转换，读取不可更快
+
+typedef enum {
+    TC_MAX31855 = 0,
+    TC_MAX6675,
+} tc_chip_t;
+
+typedef struct {
+    tc_chip_t chip;
+    int spi_host;
+    int cs_io;
+    // MAX31855 按 41.276 µV/°C 线性补偿冷端，高温段误差可达数 °C；开启后按冷端温度做 NIST ITS-90 K 型修正
+    bool nist;
+} tc_cfg_t;
+
+// 初始化 SPI 总线（只需 SCLK/MISO）
+esp_err_t thermocouple_bus_init(int spi_host, int sclk_io, int miso_io);
+// 添加一个转换器，返回温度源（注册到采集服务：sensors_add_source）；失败返回 NULL
+temp_source_t *thermocouple_add(const tc_cfg_t *cfg);
+
+// ===== 纯解码（不访问硬件） =====
+void tc_decode_max31855(uint32_t frame, temp_sample_t *out);
+void tc_decode_max6675(uint16_t frame, temp_sample_t *out);
+// MAX31855 读数 -> 按冷端温度修正后的热端温度（K 型，-200~1372 °C）
+float tc_k_nist_correct(float tc_c, float cj_c);
+
+#endif
@@ -1,33 +1,37 @@
 #include "uart.h"
-#include "driver/uart.h"
+#include "hal.h"
 #include <string.h>
 
-static uart_port_t S_UART_PORT = UART_NUM_1;
+static int S_UART_PORT = 1;
 static int S_TX_GPIO = -1;
 static int S_RX_GPIO = -1;
 static int S_BAUD = 115200;
 static const int BUF_SIZE = 1024;
+static const int TX_BUF_SIZE = 4096;   // 遥测帧经驱动 TX 环形缓冲发送，调用方不等待移位
 
 // 初始化UART
-void uart_init(uart_port_t port, int tx_gpio, int rx_gpio, int baud_rate) {
+void uart_init(int port, int tx_gpio, int rx_gpio, int baud_rate) {
     S_UART_PORT = port;
     S_TX_GPIO = tx_gpio;
     S_RX_GPIO = rx_gpio;
     S_BAUD = baud_rate;
 
-    uart_config_t uart_config = {
-        .baud_rate = S_BAUD,
-        .data_bits = UART_DATA_8_BITS,
-        .parity = UART_PARITY_DISABLE,
-        .stop_bits = UART_STOP_BITS_1,
-        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
-    };
-    uart_param_config(S_UART_PORT, &uart_config);
-    uart_set_pin(S_UART_PORT, S_TX_GPIO, S_RX_GPIO, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
-    uart_driver_install(S_UART_PORT, BUF_SIZE * 2, 0, 0, NULL, 0);
+    hal_uart_init(S_UART_PORT, S_TX_GPIO, S_RX_GPIO, S_BAUD, BUF_SIZE * 2, TX_BUF_SIZE);
 }
 
+// 运行时修改波特率
+void uart_set_baud(int baud_rate) {
+    if (hal_uart_set_baud(S_UART_PORT, baud_rate) == ESP_OK) S_BAUD = baud_rate;
+}
+
+int uart_get_baud(void) { return S_BAUD; }
+
 // 输出日志
 void uart_log(const char *msg) {
-    uart_write_bytes(S_UART_PORT, msg, strlen(msg));
+    hal_uart_write(S_UART_PORT, msg, strlen(msg));
+}
+
+// 输出二进制数据
+int uart_write(const void *data, size_t len) {
+    return hal_uart_write(S_UART_PORT, data, len);
 }
@@ -1,13 +1,19 @@
 #ifndef UART_H
 #define UART_H
 
-// 需要 UART 类型定义
-#include "driver/uart.h"
+#include <stddef.h>
 
 // 初始化UART（端口、TX、RX、波特率）
-void uart_init(uart_port_t port, int tx_gpio, int rx_gpio, int baud_rate);
+void uart_init(int port, int tx_gpio, int rx_gpio, int baud_rate);
+
+// 运行时修改/读取波特率（C3 UART 最高约 5Mbps）
+void uart_set_baud(int baud_rate);
+int uart_get_baud(void);
 
 // 日志输出
 void uart_log(const char *msg);
 
+// 二进制输出（写入驱动 TX 环形缓冲），返回写入字节数
+int uart_write(const void *data, size_t len);
+
 #endif
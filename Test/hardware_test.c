@@ -2,7 +2,7 @@
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "driver/gpio.h"
+#include "../Hardware/hal.h"
 
 #include "../Hardware/uart.h"
 #include "../Hardware/key.h"
@@ -25,28 +25,21 @@ void run_hardware_self_test(void) {
 
 	// 1) 电池电压检测
 	ESP_LOGI(TAG, "[1/7] 电池电压检测");
-	battery_monitor_init(ADC_CHANNEL_4, 2.0f, 3.0f, 4.2f);
+	battery_monitor_init(4, 2.0f, 3.0f, 4.2f);
 	float battery_voltage = battery_read_voltage();
 	float battery_percent = battery_voltage_to_percentage(battery_voltage);
 	ESP_LOGI(TAG, "电池电压: %.2fV (%.0f%%)", battery_voltage, battery_percent);
 
 	// 2) 按键测试
 	ESP_LOGI(TAG, "[2/7] 按键测试：请依次按下 按键1(加)+ 按键2(减)- 按键3(确认)");
-	gpio_config_t io_conf = {
-		.intr_type = GPIO_INTR_DISABLE,
-		.mode = GPIO_MODE_INPUT,
-		.pin_bit_mask = (1ULL<<BUTTON1_GPIO) | (1ULL<<BUTTON2_GPIO) | (1ULL<<BUTTON3_GPIO),
-		.pull_down_en = 0,
-		.pull_up_en = 1,
-	};
-	gpio_config(&io_conf);
+	hal_gpio_input_pullup((1ULL<<BUTTON1_GPIO) | (1ULL<<BUTTON2_GPIO) | (1ULL<<BUTTON3_GPIO));
 
 	bool b1_ok = false, b2_ok = false, b3_ok = false;
 	TickType_t start_ticks = xTaskGetTickCount();
 	while (!(b1_ok && b2_ok && b3_ok)) {
-		if (!b1_ok && gpio_get_level(BUTTON1_GPIO) == 0) { ESP_LOGI(TAG, "按键1 检测到"); b1_ok = true; vTaskDelay(pdMS_TO_TICKS(300)); }
-		if (!b2_ok && gpio_get_level(BUTTON2_GPIO) == 0) { ESP_LOGI(TAG, "按键2 检测到"); b2_ok = true; vTaskDelay(pdMS_TO_TICKS(300)); }
-		if (!b3_ok && gpio_get_level(BUTTON3_GPIO) == 0) { ESP_LOGI(TAG, "按键3 检测到"); b3_ok = true; vTaskDelay(pdMS_TO_TICKS(300)); }
+		if (!b1_ok && hal_gpio_get(BUTTON1_GPIO) == 0) { ESP_LOGI(TAG, "按键1 检测到"); b1_ok = true; vTaskDelay(pdMS_TO_TICKS(300)); }
+		if (!b2_ok && hal_gpio_get(BUTTON2_GPIO) == 0) { ESP_LOGI(TAG, "按键2 检测到"); b2_ok = true; vTaskDelay(pdMS_TO_TICKS(300)); }
+		if (!b3_ok && hal_gpio_get(BUTTON3_GPIO) == 0) { ESP_LOGI(TAG, "按键3 检测到"); b3_ok = true; vTaskDelay(pdMS_TO_TICKS(300)); }
 		vTaskDelay(pdMS_TO_TICKS(20));
 		if (xTaskGetTickCount() - start_ticks > pdMS_TO_TICKS(30000)) {
 			ESP_LOGW(TAG, "按键测试等待超时，请继续按键...");
@@ -87,17 +80,10 @@ void run_hardware_self_test(void) {
 
 	// 7) 继电器测试
 	ESP_LOGI(TAG, "[7/7] 继电器测试：HIGH 2s -> LOW 2s");
-	gpio_config_t rconf = {
-		.intr_type = GPIO_INTR_DISABLE,
-		.mode = GPIO_MODE_OUTPUT,
-		.pin_bit_mask = (1ULL<<RELAY_GPIO),
-		.pull_down_en = 0,
-		.pull_up_en = 0,
-	};
-	gpio_config(&rconf);
-	gpio_set_level(RELAY_GPIO, 1);
+	hal_gpio_output(RELAY_GPIO);
+	hal_gpio_set(RELAY_GPIO, 1);
 	vTaskDelay(pdMS_TO_TICKS(2000));
-	gpio_set_level(RELAY_GPIO, 0);
+	hal_gpio_set(RELAY_GPIO, 0);
 	vTaskDelay(pdMS_TO_TICKS(2000));
 
 	ESP_LOGI(TAG, "===== 硬件自检完毕 =====");
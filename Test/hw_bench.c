@@ -0,0 +1,187 @@
+#include "hw_bench.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_app_desc.h"
+#include "lwip/sockets.h"
+#include "../Hardware/hal.h"
+#include "../Hardware/display.h"
+#include "../Hardware/sensors.h"
+
+static const char *TAG = "HWBENCH";
+
+static bool s_running = false;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// 报告追加写；溢出后截断
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t w;
+} report_t;
+
+static void rp(report_t *r, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static void rp(report_t *r, const char *fmt, ...) {
+    if (r->w >= r->len) return;
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(r->buf + r->w, r->len - r->w, fmt, ap);
+    va_end(ap);
+    if (n < 0) return;
+    r->w = (size_t)n < r->len - r->w ? r->w + (size_t)n : r->len;
+}
+
+// ===== ADC：连续单次转换，统计原始值分布 =====
+static void bench_adc(report_t *r, int ch) {
+    double sum = 0, sum2 = 0;
+    int mn = 4095, mx = 0;
+    int64_t t0 = hal_time_us();
+    for (int i = 0; i < HW_BENCH_ADC_SAMPLES; i++) {
+        int v = hal_adc_read_raw(ch);
+        sum += v;
+        sum2 += (double)v * v;
+        if (v < mn) mn = v;
+        if (v > mx) mx = v;
+    }
+    int64_t dt = hal_time_us() - t0;
+    double mean = sum / HW_BENCH_ADC_SAMPLES;
+    double var = sum2 / HW_BENCH_ADC_SAMPLES - mean * mean;
+    rp(r, "{\"ch\":%d,\"n\":%d,\"sps\":%.0f,\"mean\":%.1f,\"std\":%.2f,\"min\":%d,\"max\":%d,\"mv\":%d}",
+       ch, HW_BENCH_ADC_SAMPLES, dt > 0 ? HW_BENCH_ADC_SAMPLES * 1e6 / dt : 0.0, mean,
+       var > 0 ? sqrt(var) : 0.0, mn, mx, hal_adc_raw_to_mv((int)(mean + 0.5)));
+}
+
+// ===== I2C：OLED 整帧 8 页重写，字节率按实际发送的命令+数据字节计 =====
+static void bench_i2c(report_t *r) {
+    int64_t t0 = hal_time_us();
+    size_t bytes = display_flush_full();
+    int64_t dt = hal_time_us() - t0;
+    if (!bytes) { rp(r, "\"i2c\":null"); return; }
+    rp(r, "\"i2c\":{\"bytes\":%u,\"flush_us\":%lld,\"bps\":%.0f}",
+       (unsigned)bytes, (long long)dt, dt > 0 ? bytes * 1e6 / dt : 0.0);
+}
+
+// ===== LEDC：单次 set_duty + update_duty 调用耗时 =====
+static void bench_ledc(report_t *r, int ch, uint32_t duty) {
+    int64_t total = 0, worst = 0;
+    for (int i = 0; i < HW_BENCH_LEDC_UPDATES; i++) {
+        int64_t t0 = hal_time_us();
+        hal_pwm_set_duty(ch, duty);
+        int64_t dt = hal_time_us() - t0;
+        total += dt;
+        if (dt > worst) worst = dt;
+    }
+    rp(r, "\"ledc\":{\"ch\":%d,\"n\":%d,\"avg_us\":%.2f,\"max_us\":%lld}",
+       ch, HW_BENCH_LEDC_UPDATES, (double)total / HW_BENCH_LEDC_UPDATES, (long long)worst);
+}
+
+// ===== HTTP：回环地址上的完整请求（建连、发送、读到对端关闭） =====
+static int64_t http_roundtrip_us(uint16_t port) {
+    int s = socket(AF_INET, SOCK_STREAM, 0);
+    if (s < 0) return -1;
+    struct timeval tv = { .tv_sec = HW_BENCH_HTTP_TIMEOUT_MS / 1000, .tv_usec = (HW_BENCH_HTTP_TIMEOUT_MS % 1000) * 1000 };
+    setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(port) };
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    static const char req[] = "GET " HW_BENCH_HTTP_PATH " HTTP/1.1\r\nHost: 127.0.0.1\r\nConnection: close\r\n\r\n";
+    char rx[256];
+    int64_t t0 = hal_time_us();
+    int64_t dt = -1;
+    if (connect(s, (struct sockaddr *)&addr, sizeof(addr)) == 0 && send(s, req, sizeof(req) - 1, 0) == (int)(sizeof(req) - 1)) {
+        int n, got = 0;
+        while ((n = recv(s, rx, sizeof(rx), 0)) > 0) got += n;
+        if (n == 0 && got > 0) dt = hal_time_us() - t0;
+    }
+    close(s);
+    return dt;
+}
+
+static void bench_http(report_t *r, uint16_t port) {
+    int ok = 0;
+    int64_t total = 0, worst = 0;
+    for (int i = 0; i < HW_BENCH_HTTP_REQS; i++) {
+        int64_t dt = http_roundtrip_us(port);
+        if (dt < 0) continue;
+        ok++;
+        total += dt;
+        if (dt > worst) worst = dt;
+    }
+    rp(r, "\"http\":{\"n\":%d,\"ok\":%d,\"avg_ms\":%.2f,\"max_ms\":%.2f}",
+       HW_BENCH_HTTP_REQS, ok, ok ? total / 1000.0 / ok : 0.0, worst / 1000.0);
+}
+
+// ===== Flash：经 OTA 接口顺序写入空闲分区（按写入进度擦除扇区），结束后放弃 =====
+static void bench_flash(report_t *r, size_t bytes) {
+    uint8_t *chunk = malloc(HW_BENCH_FLASH_CHUNK);
+    if (!chunk) { rp(r, "\"flash\":{\"err\":%d}", ESP_ERR_NO_MEM); return; }
+    for (int i = 0; i < HW_BENCH_FLASH_CHUNK; i++) chunk[i] = (uint8_t)(i * 7 + 1);
+    chunk[0] = 0xE9;    // 镜像头魔数，首块写入时校验
+    if (bytes > hal_ota_partition_size()) bytes = hal_ota_partition_size();
+
+    hal_ota_t ota = NULL;
+    esp_err_t err = hal_ota_begin(&ota);
+    size_t done = 0;
+    int64_t worst = 0, t0 = hal_time_us();
+    while (err == ESP_OK && done < bytes) {
+        size_t n = bytes - done < HW_BENCH_FLASH_CHUNK ? bytes - done : HW_BENCH_FLASH_CHUNK;
+        int64_t c0 = hal_time_us();
+        err = hal_ota_write(ota, chunk, n);
+        int64_t dt = hal_time_us() - c0;
+        if (dt > worst) worst = dt;
+        if (err == ESP_OK) done += n;
+    }
+    int64_t dt = hal_time_us() - t0;
+    if (ota) hal_ota_abort(ota);
+    free(chunk);
+    rp(r, "\"flash\":{\"bytes\":%u,\"ms\":%.1f,\"kbps\":%.1f,\"max_chunk_ms\":%.1f,\"err\":%d}",
+       (unsigned)done, dt / 1000.0, dt > 0 ? done * 1e6 / 1024.0 / dt : 0.0, worst / 1000.0, (int)err);
+}
+
+esp_err_t hw_bench_run(const hw_bench_cfg_t *cfg, char *buf, size_t len) {
+    portENTER_CRITICAL(&s_lock);
+    bool busy = s_running;
+    s_running = true;
+    portEXIT_CRITICAL(&s_lock);
+    if (busy) return ESP_ERR_INVALID_STATE;
+
+    report_t r = { .buf = buf, .len = len, .w = 0 };
+    const esp_app_desc_t *app = esp_app_get_description();
+    int64_t t0 = hal_time_us();
+    rp(&r, "{\"fw\":\"%s\",\"idf\":\"%s\",\"built\":\"%s %s\",\"adc\":[",
+       app->version, app->idf_ver, app->date, app->time);
+    sensor_reading_t unused;
+    for (int ch = 0, n = 0; ch < SENSOR_ADC_CHANNELS; ch++) {
+        if (!sensors_get(ch, &unused)) continue;
+        if (n++) rp(&r, ",");
+        bench_adc(&r, ch);
+    }
+    rp(&r, "],");
+    // 各项之间让出 CPU，控制与安全任务不被连续占用
+    vTaskDelay(1);
+    bench_i2c(&r);
+    vTaskDelay(1);
+    rp(&r, ",");
+    bench_ledc(&r, HW_BENCH_PWM_CHANNEL, 0);
+    if (cfg->http_port) {
+        rp(&r, ",");
+        bench_http(&r, cfg->http_port);
+    }
+    vTaskDelay(1);
+    if (cfg->flash_bytes) {
+        rp(&r, ",");
+        bench_flash(&r, cfg->flash_bytes);
+    }
+    rp(&r, ",\"total_ms\":%.1f}", (hal_time_us() - t0) / 1000.0);
+    ESP_LOGI(TAG, "%s", buf);
+
+    portENTER_CRITICAL(&s_lock);
+    s_running = false;
+    portEXIT_CRITICAL(&s_lock);
+    return ESP_OK;
+}
@@ -0,0 +1,33 @@
+#ifndef HW_BENCH_H
+#define HW_BENCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// 非交互外设基准：逐项实测并输出 JSON 报告（控制台一行 "HWBENCH: {...}"，便于比对不同板子/固件）
+//   ADC   采集服务已注册的每个 ADC 通道：采样率与噪声（原始值均值/标准差/极差）
+//   I2C   OLED 整帧刷新耗时与有效字节率
+//   LEDC  占空比更新调用耗时（RGB 蓝色通道，各处均写 0，测量时重写 0 不改变显示）
+//   HTTP  本机回环请求往返时间
+//   Flash 写入空闲 OTA 分区的速度（含按扇区擦除），写完即放弃，不影响已有镜像
+// 不操作加热输出，温区控制与安全监控照常运行
+#define HW_BENCH_ADC_SAMPLES  500
+#define HW_BENCH_LEDC_UPDATES 200
+#define HW_BENCH_PWM_CHANNEL  2
+#define HW_BENCH_HTTP_REQS    20
+#define HW_BENCH_HTTP_PATH    "/api/boot"   // 同步路由，响应小且不访问外设
+#define HW_BENCH_HTTP_TIMEOUT_MS 2000
+#define HW_BENCH_FLASH_CHUNK  4096
+#define HW_BENCH_FLASH_BYTES  (64 * 1024)
+#define HW_BENCH_REPORT_MAX   1024
+
+typedef struct {
+    uint16_t http_port;       // 0 跳过（调用方运行在 HTTP 服务任务内时须跳过）
+    size_t flash_bytes;       // 0 跳过（OTA 会话进行中或已有待切换镜像时须跳过）
+} hw_bench_cfg_t;
+
+// 依次运行各项并把报告写入 buf；已有一次在运行返回 ESP_ERR_INVALID_STATE
+esp_err_t hw_bench_run(const hw_bench_cfg_t *cfg, char *buf, size_t len);
+
+#endif
@@ -0,0 +1,267 @@
+// 固件热点函数主机端微基准：ns/op、每次调用的堆分配次数/字节数、I2C 字节数
+//
+// 用法：fw_bench [--csv] [--min-ms N] [过滤子串]
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pid_controller.h"
+#include "mpc_controller.h"
+#include "plant_id.h"
+#include "api_json.h"
+#include "temperature.h"
+#include "battery_monitor.h"
+#include "sensors.h"
+#include "thermocouple.h"
+#include "display.h"
+#include "hal.h"
+
+// ===== 堆分配统计（链接时 --wrap=malloc/calloc/realloc/free） =====
+void *__real_malloc(size_t n);
+void *__real_calloc(size_t n, size_t sz);
+void *__real_realloc(void *p, size_t n);
+void __real_free(void *p);
+
+static uint64_t s_allocs = 0;
+static uint64_t s_alloc_bytes = 0;
+
+void *__wrap_malloc(size_t n) { s_allocs++; s_alloc_bytes += n; return __real_malloc(n); }
+void *__wrap_calloc(size_t n, size_t sz) { s_allocs++; s_alloc_bytes += n * sz; return __real_calloc(n, sz); }
+void *__wrap_realloc(void *p, size_t n) { s_allocs++; s_alloc_bytes += n; return __real_realloc(p, n); }
+void __wrap_free(void *p) { __real_free(p); }
+
+// ===== 被测对象 =====
+static volatile float s_sink_f;
+static volatile int s_sink_i;
+static PID_t s_pid;
+static pid_bank_t s_bank;
+static float s_bank_in[PID_BANK_MAX], s_bank_out[PID_BANK_MAX];
+static char s_json[256];
+static float s_temp_in = 25.0f;
+
+static void bm_pid_compute(void) {
+    // 输入在设定值附近小幅摆动，避免积分饱和后走捷径
+    s_temp_in = s_temp_in > 41.0f ? 39.0f : s_temp_in + 0.01f;
+    s_sink_f = pid_compute(&s_pid, s_temp_in);
+}
+
+static void bm_pid_compute_bank(void) {
+    // 全部温区同一周期批量计算
+    for (int i = 0; i < PID_BANK_MAX; i++) {
+        s_bank_in[i] = s_bank_in[i] > 41.0f ? 39.0f : s_bank_in[i] + 0.01f;
+    }
+    pid_compute_bank(&s_bank, (1u << PID_BANK_MAX) - 1, s_bank_in, s_bank_out, 1.0f);
+    s_sink_f = s_bank_out[0];
+}
+
+static void bm_mpc_table_eval(void) {
+    // 参数扫过整个域：覆盖按面积排序靠后的区域与域外回退
+    static float x = 0.0f;
+    x = x >= 150.0f ? 0.0f : x + 0.37f;
+    s_sink_f = mpc_table_eval(&MPC_TABLE, x, 150.0f - x * 0.5f, NULL);
+}
+
+static plant_id_t s_id;
+
+static void bm_plant_id_update(void) {
+    // 方波输入激励，温度按一阶对象响应：每次调用更新全部候选纯滞后
+    static int k = 0;
+    static float y = 25.0f;
+    float u = (k++ / 50) % 2 ? 60.0f : 20.0f;
+    y = 0.99170f * y + 0.012448f * u + 0.2075f;
+    plant_id_update(&s_id, y, u);
+    s_sink_f = s_id.rls[0].theta[0];
+}
+
+static void bm_ntc_from_raw(void) {
+    static int raw = 1500;
+    raw = raw >= 2600 ? 1500 : raw + 1;
+    s_sink_f = temperature_from_raw(raw);
+}
+
+static void bm_temperature_read(void) { s_sink_f = temperature_read(); }
+
+// 热电偶帧解码（整数移位）与可选 NIST 修正，对比 NTC 的 temperature_from_raw
+static uint32_t s_tc_frame = (400u << 2) << 18 | (25u << 4) << 4;
+static temp_sample_t s_tc;
+static void bm_max31855_decode(void) {
+    s_tc_frame ^= 1u << 18;
+    tc_decode_max31855(s_tc_frame, &s_tc);
+    s_sink_f = s_tc.temp;
+}
+
+static void bm_tc_nist_correct(void) {
+    s_tc.temp = s_tc.temp >= 800.0f ? 100.0f : s_tc.temp + 0.25f;
+    s_sink_f = tc_k_nist_correct(s_tc.temp, 25.0f);
+}
+
+static temp_source_t *s_mock;
+static void bm_temp_source_mock(void) {
+    if (!s_mock) s_mock = temp_mock_add(40.0f);
+    s_mock->begin(s_mock);
+    s_mock->end(s_mock, &s_tc);
+    s_sink_f = s_tc.temp;
+}
+
+// 消费者读取采集缓存（对比 temperature_read 的直接采样）
+static void bm_sensors_get(void) {
+    sensor_reading_t r;
+    sensors_get(0, &r);
+    s_sink_f = r.value;
+}
+
+static void bm_battery_percent(void) {
+    static float v = 3.0f;
+    v = v > 4.2f ? 3.0f : v + 0.001f;
+    s_sink_f = battery_voltage_to_percentage(v);
+}
+
+static void bm_display_show_text(void) {
+    display_show_text("T:40.1 S:40.0 MAX:80.0", "KP:2.00 KI:0.100", "KD:0.50 OUT: 42%");
+}
+
+static void bm_display_update(void) { display_update(40.1f, 40.0f, 87.0f); }
+
+// 每次温度末位变化：只有大号数字区需要刷新
+static void bm_display_dashboard(void) {
+    static int t = 0;
+    char big[16];
+    t = (t + 1) % 10;
+    snprintf(big, sizeof(big), "40.%d\xC2\xB0""C", t);
+    display_dashboard(big, "Set 40.0 Max 80.0", "Kp2.00 Ki0.100 Kd0.50", "Out  42%  Zone 0");
+}
+
+// 趋势图每个样本：写入一列 + 擦除间隙列，随后增量刷新
+static void bm_display_trend(void) {
+    static int i = 0;
+    i++;
+    display_trend_push(40.0f + 1.5f * sinf(i * 0.05f), 40.0f);
+    display_flush();
+}
+
+static void bm_json_temp(void) { s_sink_i = api_json_temp(s_json, sizeof(s_json), 40.12f); }
+
+static void bm_json_battery(void) { s_sink_i = api_json_battery(s_json, sizeof(s_json), 3.92f, 76.0f); }
+
+static void bm_json_pid_params(void) { s_sink_i = api_json_pid_params(s_json, sizeof(s_json), &s_pid, 80.0f); }
+
+static void bm_json_pid_status(void) {
+    api_pid_status_t st = {
+        .running = true, .pid = &s_pid, .max_temp = 80.0f, .temp = 40.12f,
+        .output = 42.0f, .adc = 2011, .mv = 1620, .pwm = 42,
+    };
+    s_sink_i = api_json_pid_status(s_json, sizeof(s_json), &st);
+}
+
+typedef struct {
+    const char *name;
+    void (*fn)(void);
+} bench_t;
+
+static const bench_t BENCHES[] = {
+    { "pid_compute",                 bm_pid_compute },
+    { "pid_compute_bank",            bm_pid_compute_bank },
+    { "mpc_table_eval",              bm_mpc_table_eval },
+    { "plant_id_update",             bm_plant_id_update },
+    { "temperature_from_raw",        bm_ntc_from_raw },
+    { "temperature_read",            bm_temperature_read },
+    { "max31855_decode",             bm_max31855_decode },
+    { "tc_k_nist_correct",           bm_tc_nist_correct },
+    { "temp_source_mock",            bm_temp_source_mock },
+    { "sensors_get",                 bm_sensors_get },
+    { "battery_voltage_to_percentage", bm_battery_percent },
+    { "display_show_text",           bm_display_show_text },
+    { "display_update",              bm_display_update },
+    { "display_dashboard",           bm_display_dashboard },
+    { "display_trend_push",          bm_display_trend },
+    { "api_json_temp",               bm_json_temp },
+    { "api_json_battery",            bm_json_battery },
+    { "api_json_pid_params",         bm_json_pid_params },
+    { "api_json_pid_status",         bm_json_pid_status },
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+typedef struct {
+    double ns_per_op;
+    double allocs_per_op;
+    double bytes_per_op;
+    double i2c_bytes_per_op;
+    uint64_t iters;
+} bench_result_t;
+
+static bench_result_t run_one(const bench_t *b, uint64_t min_ns) {
+    // 预热
+    for (int i = 0; i < 100; i++) b->fn();
+
+    uint64_t iters = 64;
+    for (;;) {
+        uint64_t a0 = s_allocs, ab0 = s_alloc_bytes, i0 = hal_sim_i2c_bytes();
+        uint64_t t0 = now_ns();
+        for (uint64_t i = 0; i < iters; i++) b->fn();
+        uint64_t dt = now_ns() - t0;
+        if (dt >= min_ns || iters >= (1ull << 32)) {
+            bench_result_t r = {
+                .ns_per_op = (double)dt / (double)iters,
+                .allocs_per_op = (double)(s_allocs - a0) / (double)iters,
+                .bytes_per_op = (double)(s_alloc_bytes - ab0) / (double)iters,
+                .i2c_bytes_per_op = (double)(hal_sim_i2c_bytes() - i0) / (double)iters,
+                .iters = iters,
+            };
+            return r;
+        }
+        // 按已测耗时估算下一轮次数，最多放大 10 倍
+        uint64_t next = dt ? iters * min_ns / dt + iters / 2 : iters * 10;
+        if (next > iters * 10) next = iters * 10;
+        if (next <= iters) next = iters * 2;
+        iters = next;
+    }
+}
+
+int main(int argc, char **argv) {
+    bool csv = false;
+    uint64_t min_ms = 200;
+    const char *filter = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--csv") == 0) csv = true;
+        else if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) min_ms = strtoull(argv[++i], NULL, 10);
+        else filter = argv[i];
+    }
+
+    // 与固件默认一致的初始化
+    pid_init(&s_pid, 2.0f, 0.1f, 0.5f, 40.0f);
+    plant_id_reset(&s_id);
+    for (int i = 0; i < PID_BANK_MAX; i++) {
+        pid_bank_init(&s_bank, i, 2.0f, 0.1f, 0.5f, 40.0f);
+        s_bank_in[i] = 25.0f + i;
+    }
+    temperature_init(0, 100000.0f, 3.3f);
+    battery_monitor_init(4, 2.0f, 3.0f, 4.2f);
+    display_init(0, 8, 9, 400000, 0x3C);
+    hal_sim_set_adc_mv(0, 1620);
+    sensors_add_channel(0, SENSOR_NTC, SENSOR_NTC_PERIOD_MS);
+
+    if (csv) printf("name,ns_per_op,allocs_per_op,bytes_per_op,i2c_bytes_per_op,iters\n");
+    else printf("%-32s %12s %10s %10s %10s\n", "benchmark", "ns/op", "allocs/op", "B/op", "i2c B/op");
+
+    for (size_t i = 0; i < sizeof(BENCHES) / sizeof(BENCHES[0]); i++) {
+        const bench_t *b = &BENCHES[i];
+        if (filter && !strstr(b->name, filter)) continue;
+        bench_result_t r = run_one(b, min_ms * 1000000ull);
+        if (csv) {
+            printf("%s,%.2f,%.3f,%.1f,%.1f,%llu\n", b->name, r.ns_per_op, r.allocs_per_op,
+                   r.bytes_per_op, r.i2c_bytes_per_op, (unsigned long long)r.iters);
+        } else {
+            printf("%-32s %12.1f %10.3f %10.1f %10.1f\n", b->name, r.ns_per_op, r.allocs_per_op,
+                   r.bytes_per_op, r.i2c_bytes_per_op);
+        }
+    }
+    return 0;
+}
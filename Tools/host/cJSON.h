@@ -0,0 +1,49 @@
+#ifndef HOST_CJSON_H
+#define HOST_CJSON_H
+
+// 主机整机的 cJSON 子集（只解析与查询，不序列化）；结构与类型位与 cJSON 1.7 一致
+#include <stdbool.h>
+
+#define cJSON_Invalid (0)
+#define cJSON_False   (1 << 0)
+#define cJSON_True    (1 << 1)
+#define cJSON_NULL    (1 << 2)
+#define cJSON_Number  (1 << 3)
+#define cJSON_String  (1 << 4)
+#define cJSON_Array   (1 << 5)
+#define cJSON_Object  (1 << 6)
+
+#define CJSON_NESTING_LIMIT 1000
+
+typedef int cJSON_bool;
+
+typedef struct cJSON {
+    struct cJSON *next, *prev;
+    struct cJSON *child;
+    int type;
+    char *valuestring;
+    int valueint;
+    double valuedouble;
+    char *string;
+} cJSON;
+
+cJSON *cJSON_Parse(const char *value);
+void cJSON_Delete(cJSON *item);
+cJSON *cJSON_CreateObject(void);
+cJSON *cJSON_GetObjectItem(const cJSON *object, const char *string);
+cJSON_bool cJSON_HasObjectItem(const cJSON *object, const char *string);
+int cJSON_GetArraySize(const cJSON *array);
+cJSON *cJSON_GetArrayItem(const cJSON *array, int index);
+char *cJSON_GetStringValue(const cJSON *item);
+double cJSON_GetNumberValue(const cJSON *item);
+
+cJSON_bool cJSON_IsFalse(const cJSON *item);
+cJSON_bool cJSON_IsTrue(const cJSON *item);
+cJSON_bool cJSON_IsBool(const cJSON *item);
+cJSON_bool cJSON_IsNull(const cJSON *item);
+cJSON_bool cJSON_IsNumber(const cJSON *item);
+cJSON_bool cJSON_IsString(const cJSON *item);
+cJSON_bool cJSON_IsArray(const cJSON *item);
+cJSON_bool cJSON_IsObject(const cJSON *item);
+
+#endif
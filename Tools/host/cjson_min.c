@@ -0,0 +1,231 @@
+// 主机整机的 cJSON 子集：递归下降解析 RFC 8259 JSON，对象键查找不区分大小写（与 cJSON_GetObjectItem 一致）
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "cJSON.h"
+
+typedef struct {
+    const char *p;
+    int depth;
+} parser_t;
+
+static cJSON *item_new(int type) {
+    cJSON *it = calloc(1, sizeof(*it));
+    if (it) it->type = type;
+    return it;
+}
+
+void cJSON_Delete(cJSON *item) {
+    while (item) {
+        cJSON *next = item->next;
+        cJSON_Delete(item->child);
+        free(item->valuestring);
+        free(item->string);
+        free(item);
+        item = next;
+    }
+}
+
+static void skip_ws(parser_t *ps) {
+    while (*ps->p == ' ' || *ps->p == '\t' || *ps->p == '\n' || *ps->p == '\r') ps->p++;
+}
+
+static int hex4(const char *s) {
+    int v = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = s[i];
+        v <<= 4;
+        if (c >= '0' && c <= '9') v |= c - '0';
+        else if (c >= 'a' && c <= 'f') v |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') v |= c - 'A' + 10;
+        else return -1;
+    }
+    return v;
+}
+
+static size_t utf8_put(char *out, uint32_t cp) {
+    if (cp < 0x80) { out[0] = (char)cp; return 1; }
+    if (cp < 0x800) { out[0] = (char)(0xC0 | cp >> 6); out[1] = (char)(0x80 | (cp & 0x3F)); return 2; }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | cp >> 12); out[1] = (char)(0x80 | ((cp >> 6) & 0x3F)); out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | cp >> 18); out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F)); out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+// 解析 "..."，返回堆上的 UTF-8 串；转义后长度不超过原文长度
+static char *parse_string(parser_t *ps) {
+    if (*ps->p != '"') return NULL;
+    const char *s = ++ps->p;
+    const char *e = s;
+    while (*e && *e != '"') { if (*e == '\\' && e[1]) e++; e++; }
+    if (*e != '"') return NULL;
+    char *out = malloc((size_t)(e - s) + 1), *o = out;
+    if (!out) return NULL;
+    while (s < e) {
+        if ((unsigned char)*s < 0x20) goto fail;
+        if (*s != '\\') { *o++ = *s++; continue; }
+        s++;
+        switch (*s++) {
+        case '"': *o++ = '"'; break;
+        case '\\': *o++ = '\\'; break;
+        case '/': *o++ = '/'; break;
+        case 'b': *o++ = '\b'; break;
+        case 'f': *o++ = '\f'; break;
+        case 'n': *o++ = '\n'; break;
+        case 'r': *o++ = '\r'; break;
+        case 't': *o++ = '\t'; break;
+        case 'u': {
+            if (e - s < 4) goto fail;
+            int hi = hex4(s);
+            if (hi < 0) goto fail;
+            s += 4;
+            uint32_t cp = (uint32_t)hi;
+            if (hi >= 0xD800 && hi <= 0xDBFF) {
+                // 代理对：\uD8xx\uDCxx
+                if (e - s < 6 || s[0] != '\\' || s[1] != 'u') goto fail;
+                int lo = hex4(s + 2);
+                if (lo < 0xDC00 || lo > 0xDFFF) goto fail;
+                s += 6;
+                cp = 0x10000 + (((uint32_t)hi - 0xD800) << 10) + ((uint32_t)lo - 0xDC00);
+            } else if (hi >= 0xDC00 && hi <= 0xDFFF) {
+                goto fail;
+            }
+            o += utf8_put(o, cp);
+            break;
+        }
+        default: goto fail;
+        }
+    }
+    *o = 0;
+    ps->p = e + 1;
+    return out;
+fail:
+    free(out);
+    return NULL;
+}
+
+static bool parse_number(parser_t *ps, cJSON *it) {
+    const char *s = ps->p;
+    if (*s == '-') s++;
+    if (*s == '0') s++;
+    else if (*s >= '1' && *s <= '9') while (*s >= '0' && *s <= '9') s++;
+    else return false;
+    if (*s == '.') { s++; if (!(*s >= '0' && *s <= '9')) return false; while (*s >= '0' && *s <= '9') s++; }
+    if (*s == 'e' || *s == 'E') {
+        s++;
+        if (*s == '+' || *s == '-') s++;
+        if (!(*s >= '0' && *s <= '9')) return false;
+        while (*s >= '0' && *s <= '9') s++;
+    }
+    char *end;
+    double d = strtod(ps->p, &end);
+    if (end != s) return false;
+    ps->p = s;
+    it->type = cJSON_Number;
+    it->valuedouble = d;
+    // 与 cJSON 相同：valueint 饱和到 int 范围
+    it->valueint = d >= INT32_MAX ? INT32_MAX : d <= (double)INT32_MIN ? INT32_MIN : (int)d;
+    return true;
+}
+
+static cJSON *parse_value(parser_t *ps);
+
+// 解析 [ ... ] 或 { ... } 的成员链表
+static bool parse_members(parser_t *ps, cJSON *parent, char close, bool keyed) {
+    if (++ps->depth > CJSON_NESTING_LIMIT) return false;
+    ps->p++;
+    skip_ws(ps);
+    cJSON *tail = NULL;
+    if (*ps->p == close) { ps->p++; ps->depth--; return true; }
+    for (;;) {
+        char *key = NULL;
+        if (keyed) {
+            skip_ws(ps);
+            if (!(key = parse_string(ps))) return false;
+            skip_ws(ps);
+            if (*ps->p != ':') { free(key); return false; }
+            ps->p++;
+        }
+        cJSON *v = parse_value(ps);
+        if (!v) { free(key); return false; }
+        v->string = key;
+        if (tail) { tail->next = v; v->prev = tail; } else { parent->child = v; }
+        tail = v;
+        skip_ws(ps);
+        if (*ps->p == ',') { ps->p++; continue; }
+        if (*ps->p == close) { ps->p++; ps->depth--; return true; }
+        return false;
+    }
+}
+
+static cJSON *parse_value(parser_t *ps) {
+    skip_ws(ps);
+    cJSON *it = item_new(cJSON_Invalid);
+    if (!it) return NULL;
+    bool ok = false;
+    switch (*ps->p) {
+    case '{': it->type = cJSON_Object; ok = parse_members(ps, it, '}', true); break;
+    case '[': it->type = cJSON_Array; ok = parse_members(ps, it, ']', false); break;
+    case '"': it->type = cJSON_String; ok = (it->valuestring = parse_string(ps)) != NULL; break;
+    case 't': if ((ok = strncmp(ps->p, "true", 4) == 0)) { it->type = cJSON_True; it->valueint = 1; ps->p += 4; } break;
+    case 'f': if ((ok = strncmp(ps->p, "false", 5) == 0)) { it->type = cJSON_False; ps->p += 5; } break;
+    case 'n': if ((ok = strncmp(ps->p, "null", 4) == 0)) { it->type = cJSON_NULL; ps->p += 4; } break;
+    default: ok = parse_number(ps, it); break;
+    }
+    if (!ok) { cJSON_Delete(it); return NULL; }
+    return it;
+}
+
+cJSON *cJSON_Parse(const char *value) {
+    if (!value) return NULL;
+    parser_t ps = { .p = value };
+    cJSON *it = parse_value(&ps);
+    if (!it) return NULL;
+    skip_ws(&ps);
+    if (*ps.p) { cJSON_Delete(it); return NULL; }
+    return it;
+}
+
+cJSON *cJSON_CreateObject(void) { return item_new(cJSON_Object); }
+
+cJSON *cJSON_GetObjectItem(const cJSON *object, const char *string) {
+    if (!object || !string) return NULL;
+    for (cJSON *c = object->child; c; c = c->next) {
+        if (c->string && strcasecmp(c->string, string) == 0) return c;
+    }
+    return NULL;
+}
+
+cJSON_bool cJSON_HasObjectItem(const cJSON *object, const char *string) {
+    return cJSON_GetObjectItem(object, string) != NULL;
+}
+
+int cJSON_GetArraySize(const cJSON *array) {
+    int n = 0;
+    for (cJSON *c = array ? array->child : NULL; c; c = c->next) n++;
+    return n;
+}
+
+cJSON *cJSON_GetArrayItem(const cJSON *array, int index) {
+    cJSON *c = array ? array->child : NULL;
+    while (c && index-- > 0) c = c->next;
+    return index < 0 ? NULL : c;
+}
+
+char *cJSON_GetStringValue(const cJSON *item) { return cJSON_IsString(item) ? item->valuestring : NULL; }
+
+double cJSON_GetNumberValue(const cJSON *item) { return cJSON_IsNumber(item) ? item->valuedouble : NAN; }
+
+cJSON_bool cJSON_IsFalse(const cJSON *item) { return item && (item->type & 0xFF) == cJSON_False; }
+cJSON_bool cJSON_IsTrue(const cJSON *item) { return item && (item->type & 0xFF) == cJSON_True; }
+cJSON_bool cJSON_IsBool(const cJSON *item) { return item && (item->type & (cJSON_True | cJSON_False)) != 0; }
+cJSON_bool cJSON_IsNull(const cJSON *item) { return item && (item->type & 0xFF) == cJSON_NULL; }
+cJSON_bool cJSON_IsNumber(const cJSON *item) { return item && (item->type & 0xFF) == cJSON_Number; }
+cJSON_bool cJSON_IsString(const cJSON *item) { return item && (item->type & 0xFF) == cJSON_String; }
+cJSON_bool cJSON_IsArray(const cJSON *item) { return item && (item->type & 0xFF) == cJSON_Array; }
+cJSON_bool cJSON_IsObject(const cJSON *item) { return item && (item->type & 0xFF) == cJSON_Object; }
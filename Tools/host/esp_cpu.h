@@ -0,0 +1,16 @@
+#ifndef HOST_ESP_CPU_H
+#define HOST_ESP_CPU_H
+
+#include <stdint.h>
+#include <time.h>
+#include "sdkconfig.h"
+
+// 主机整机：周期计数按单调时钟折算到 CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ，/api/perf 的 us 换算与板上一致
+static inline uint32_t esp_cpu_get_cycle_count(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    return (uint32_t)(ns * CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ / 1000u);
+}
+
+#endif
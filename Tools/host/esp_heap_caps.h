@@ -0,0 +1,24 @@
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+typedef struct {
+    size_t total_free_bytes;
+    size_t total_allocated_bytes;
+    size_t largest_free_block;
+    size_t minimum_free_bytes;
+    size_t allocated_blocks;
+    size_t free_blocks;
+    size_t total_blocks;
+} multi_heap_info_t;
+
+// 主机整机：按 glibc mallinfo2 填写（空闲 = 已映射未分配字节）
+void heap_caps_get_info(multi_heap_info_t *info, uint32_t caps);
+
+#endif
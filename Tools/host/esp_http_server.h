@@ -0,0 +1,139 @@
+#ifndef HOST_ESP_HTTP_SERVER_H
+#define HOST_ESP_HTTP_SERVER_H
+
+// 主机整机的 esp_http_server 垫片：固件用到的 ESP-IDF 5.0 接口子集，语义与 IDF 一致
+// （单服务任务 select 全部会话；处理函数在服务任务执行；httpd_queue_work 交回服务任务）
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define HTTPD_MAX_URI_LEN       512
+#define HTTPD_MAX_REQ_HDR_LEN   1024
+#define HTTPD_RESP_USE_STRLEN   -1
+
+#define HTTPD_SOCK_ERR_FAIL     -1
+#define HTTPD_SOCK_ERR_INVALID  -2
+#define HTTPD_SOCK_ERR_TIMEOUT  -3
+
+#define ESP_ERR_HTTPD_BASE          0xb000
+#define ESP_ERR_HTTPD_HANDLERS_FULL (ESP_ERR_HTTPD_BASE + 1)
+#define ESP_ERR_HTTPD_INVALID_REQ   (ESP_ERR_HTTPD_BASE + 3)
+#define ESP_ERR_HTTPD_RESULT_TRUNC  (ESP_ERR_HTTPD_BASE + 4)
+#define ESP_ERR_HTTPD_RESP_SEND     (ESP_ERR_HTTPD_BASE + 7)
+#define ESP_ERR_HTTPD_TASK          (ESP_ERR_HTTPD_BASE + 8)
+
+// 取值同 http_parser
+typedef enum {
+    HTTP_DELETE = 0, HTTP_GET = 1, HTTP_HEAD = 2, HTTP_POST = 3, HTTP_PUT = 4, HTTP_OPTIONS = 6,
+} httpd_method_t;
+
+typedef enum {
+    HTTPD_400_BAD_REQUEST,
+    HTTPD_404_NOT_FOUND,
+    HTTPD_405_METHOD_NOT_ALLOWED,
+    HTTPD_408_REQ_TIMEOUT,
+    HTTPD_411_LENGTH_REQUIRED,
+    HTTPD_414_URI_TOO_LONG,
+    HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE,
+    HTTPD_500_INTERNAL_SERVER_ERROR,
+    HTTPD_501_METHOD_NOT_IMPLEMENTED,
+} httpd_err_code_t;
+
+typedef void *httpd_handle_t;
+typedef void (*httpd_free_ctx_fn_t)(void *ctx);
+typedef void (*httpd_work_fn_t)(void *arg);
+typedef bool (*httpd_uri_match_func_t)(const char *reference_uri, const char *uri_to_match, size_t match_upto);
+
+typedef struct httpd_req {
+    httpd_handle_t handle;
+    int method;
+    char uri[HTTPD_MAX_URI_LEN + 1];
+    size_t content_len;
+    void *aux;
+    void *user_ctx;
+    void *sess_ctx;
+    httpd_free_ctx_fn_t free_ctx;
+    bool ignore_sess_ctx_changes;
+} httpd_req_t;
+
+typedef struct httpd_uri {
+    const char *uri;
+    httpd_method_t method;
+    esp_err_t (*handler)(httpd_req_t *r);
+    void *user_ctx;
+} httpd_uri_t;
+
+typedef struct httpd_config {
+    unsigned task_priority;
+    size_t stack_size;
+    uint16_t server_port;
+    uint16_t max_open_sockets;
+    uint16_t max_uri_handlers;
+    uint16_t max_resp_headers;
+    uint16_t backlog_conn;
+    bool lru_purge_enable;
+    uint16_t recv_wait_timeout;     // s
+    uint16_t send_wait_timeout;     // s
+    httpd_uri_match_func_t uri_match_fn;
+} httpd_config_t;
+
+// 监听端口取环境变量 HAL_SIM_HTTP_PORT（默认 8080，非特权端口）
+uint16_t httpd_sim_default_port(void);
+
+#define HTTPD_DEFAULT_CONFIG() {                \
+        .task_priority      = 5,                \
+        .stack_size         = 4096,             \
+        .server_port        = httpd_sim_default_port(), \
+        .max_open_sockets   = 7,                \
+        .max_uri_handlers   = 8,                \
+        .max_resp_headers   = 8,                \
+        .backlog_conn       = 5,                \
+        .lru_purge_enable   = false,            \
+        .recv_wait_timeout  = 5,                \
+        .send_wait_timeout  = 5,                \
+        .uri_match_fn       = NULL,             \
+}
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config);
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler);
+bool httpd_uri_match_wildcard(const char *uri_template, const char *uri_to_match, size_t match_upto);
+
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len);
+size_t httpd_req_get_url_query_len(httpd_req_t *r);
+esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len);
+esp_err_t httpd_query_key_value(const char *qry, const char *key, char *val, size_t val_size);
+int httpd_req_to_sockfd(httpd_req_t *r);
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status);
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type);
+esp_err_t httpd_resp_set_hdr(httpd_req_t *r, const char *field, const char *value);
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len);
+esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len);
+esp_err_t httpd_resp_send_err(httpd_req_t *req, httpd_err_code_t error, const char *msg);
+
+static inline esp_err_t httpd_resp_sendstr(httpd_req_t *r, const char *str) {
+    return httpd_resp_send(r, str, str ? HTTPD_RESP_USE_STRLEN : 0);
+}
+static inline esp_err_t httpd_resp_sendstr_chunk(httpd_req_t *r, const char *str) {
+    return httpd_resp_send_chunk(r, str, str ? HTTPD_RESP_USE_STRLEN : 0);
+}
+static inline esp_err_t httpd_resp_send_404(httpd_req_t *r) {
+    return httpd_resp_send_err(r, HTTPD_404_NOT_FOUND, NULL);
+}
+static inline esp_err_t httpd_resp_send_500(httpd_req_t *r) {
+    return httpd_resp_send_err(r, HTTPD_500_INTERNAL_SERVER_ERROR, NULL);
+}
+
+esp_err_t httpd_queue_work(httpd_handle_t handle, httpd_work_fn_t work, void *arg);
+int httpd_socket_send(httpd_handle_t hd, int sockfd, const char *buf, size_t buf_len, int flags);
+void *httpd_sess_get_ctx(httpd_handle_t handle, int sockfd);
+void httpd_sess_set_ctx(httpd_handle_t handle, int sockfd, void *ctx, httpd_free_ctx_fn_t free_fn);
+esp_err_t httpd_sess_trigger_close(httpd_handle_t handle, int sockfd);
+
+#endif
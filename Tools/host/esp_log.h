@@ -0,0 +1,15 @@
+#ifndef HOST_ESP_LOG_H
+#define HOST_ESP_LOG_H
+
+#include "esp_err.h"
+
+// 主机整机日志：与板上控制台相同的 "I (ms) TAG: msg" 格式输出到 stderr；D/V 级别编译期剔除
+void host_log_write(char level, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+#define ESP_LOGE(tag, fmt, ...) host_log_write('E', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) host_log_write('W', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) host_log_write('I', tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) do { (void)(tag); } while (0)
+#define ESP_LOGV(tag, fmt, ...) do { (void)(tag); } while (0)
+
+#endif
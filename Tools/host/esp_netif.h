@@ -0,0 +1,12 @@
+#ifndef HOST_ESP_NETIF_H
+#define HOST_ESP_NETIF_H
+
+#include "esp_err.h"
+
+typedef struct esp_netif_obj esp_netif_t;
+
+// 主机整机：网络由主机协议栈提供，均为空操作
+esp_err_t esp_netif_init(void);
+esp_netif_t *esp_netif_create_default_wifi_ap(void);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef HOST_ESP_WIFI_H
+#define HOST_ESP_WIFI_H
+
+// 主机整机：Wi-Fi 接口为空操作（HTTP 直接监听主机回环地址），AP 启动事件在 esp_wifi_start 时同步投递
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_event.h"
+
+extern const esp_event_base_t WIFI_EVENT;
+
+typedef enum { WIFI_EVENT_AP_START = 12, WIFI_EVENT_AP_STOP } wifi_event_t;
+typedef enum { WIFI_MODE_NULL = 0, WIFI_MODE_STA, WIFI_MODE_AP, WIFI_MODE_APSTA } wifi_mode_t;
+typedef enum { WIFI_IF_STA = 0, WIFI_IF_AP } wifi_interface_t;
+typedef enum { WIFI_AUTH_OPEN = 0, WIFI_AUTH_WEP, WIFI_AUTH_WPA_PSK, WIFI_AUTH_WPA2_PSK, WIFI_AUTH_WPA_WPA2_PSK } wifi_auth_mode_t;
+
+typedef struct { int unused; } wifi_init_config_t;
+#define WIFI_INIT_CONFIG_DEFAULT() { 0 }
+
+typedef struct {
+    uint8_t ssid[32];
+    uint8_t password[64];
+    uint8_t ssid_len;
+    uint8_t channel;
+    wifi_auth_mode_t authmode;
+    uint8_t ssid_hidden;
+    uint8_t max_connection;
+} wifi_ap_config_t;
+
+typedef union {
+    wifi_ap_config_t ap;
+} wifi_config_t;
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *config);
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode);
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf);
+esp_err_t esp_wifi_start(void);
+
+#endif
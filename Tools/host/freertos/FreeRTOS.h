@@ -0,0 +1,33 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+// 主机整机（fw_host）的 FreeRTOS 垫片：任务为 pthread，优先级只记录不调度
+#include <stdint.h>
+#include <stdlib.h>
+#include "esp_err.h"
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ 100
+#define configMAX_PRIORITIES 25
+#define configUSE_TRACE_FACILITY 1
+#define configGENERATE_RUN_TIME_STATS 1
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)((ms) / portTICK_PERIOD_MS))
+#define portMAX_DELAY      0xFFFFFFFFu
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+
+// ESP32-C3 单核：临界区等价于关调度，这里用一把全局递归锁（各 portMUX 共用）
+typedef struct { int unused; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+void host_critical_enter(void);
+void host_critical_exit(void);
+#define portENTER_CRITICAL(mux) do { (void)(mux); host_critical_enter(); } while (0)
+#define portEXIT_CRITICAL(mux)  do { (void)(mux); host_critical_exit(); } while (0)
+
+#endif
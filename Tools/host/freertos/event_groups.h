@@ -0,0 +1,14 @@
+#ifndef HOST_FREERTOS_EVENT_GROUPS_H
+#define HOST_FREERTOS_EVENT_GROUPS_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_event_group *EventGroupHandle_t;
+typedef uint32_t EventBits_t;
+
+EventGroupHandle_t xEventGroupCreate(void);
+EventBits_t xEventGroupSetBits(EventGroupHandle_t eg, EventBits_t bits);
+EventBits_t xEventGroupClearBits(EventGroupHandle_t eg, EventBits_t bits);
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t eg, EventBits_t bits, BaseType_t clear, BaseType_t all, TickType_t ticks);
+
+#endif
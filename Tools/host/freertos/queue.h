@@ -0,0 +1,16 @@
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+typedef struct host_queue *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size);
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks);
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q);
+void vQueueDelete(QueueHandle_t q);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef HOST_FREERTOS_SEMPHR_H
+#define HOST_FREERTOS_SEMPHR_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef struct host_sem *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+#define xSemaphoreTakeRecursive(sem, ticks) xSemaphoreTake(sem, ticks)
+#define xSemaphoreGiveRecursive(sem)        xSemaphoreGive(sem)
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+
+#endif
@@ -0,0 +1,447 @@
+// 主机整机的 FreeRTOS 垫片：任务/通知/信号量/队列/事件组映射到 pthread
+// 不模拟优先级抢占；阻塞超时按 configTICK_RATE_HZ 折算为绝对时刻
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+#include "freertos/event_groups.h"
+
+#define HOST_MAX_TASKS 32
+
+struct host_task {
+    char name[16];
+    TaskFunction_t fn;
+    void *arg;
+    UBaseType_t prio;
+    UBaseType_t number;
+    uint32_t stack;
+    pthread_t thread;
+    eTaskState state;           // 多线程读写，经 state_get/state_set 原子访问
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify;
+};
+
+static pthread_mutex_t s_tasks_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct host_task *s_tasks[HOST_MAX_TASKS];
+static UBaseType_t s_task_count;
+static __thread struct host_task *s_self;
+
+// ===== 临界区：全局递归锁 =====
+static pthread_mutex_t s_critical;
+static pthread_once_t s_critical_once = PTHREAD_ONCE_INIT;
+
+static void critical_init(void) {
+    pthread_mutexattr_t a;
+    pthread_mutexattr_init(&a);
+    pthread_mutexattr_settype(&a, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&s_critical, &a);
+    pthread_mutexattr_destroy(&a);
+}
+
+void host_critical_enter(void) {
+    pthread_once(&s_critical_once, critical_init);
+    pthread_mutex_lock(&s_critical);
+}
+
+void host_critical_exit(void) { pthread_mutex_unlock(&s_critical); }
+
+// 阻塞节拍数 -> CLOCK_MONOTONIC 绝对时刻；portMAX_DELAY 返回 false（无限等待）
+static bool deadline(TickType_t ticks, struct timespec *ts) {
+    if (ticks == portMAX_DELAY) return false;
+    clock_gettime(CLOCK_MONOTONIC, ts);
+    uint64_t ns = (uint64_t)ticks * portTICK_PERIOD_MS * 1000000ull + (uint64_t)ts->tv_nsec;
+    ts->tv_sec += (time_t)(ns / 1000000000ull);
+    ts->tv_nsec = (long)(ns % 1000000000ull);
+    return true;
+}
+
+// 条件变量统一用单调时钟
+static void cond_init(pthread_cond_t *c) {
+    pthread_condattr_t a;
+    pthread_condattr_init(&a);
+    pthread_condattr_setclock(&a, CLOCK_MONOTONIC);
+    pthread_cond_init(c, &a);
+    pthread_condattr_destroy(&a);
+}
+
+// 等待一次；超时返回 false
+static bool cond_wait(pthread_cond_t *c, pthread_mutex_t *m, bool timed, const struct timespec *ts) {
+    if (!timed) { pthread_cond_wait(c, m); return true; }
+    return pthread_cond_timedwait(c, m, ts) != ETIMEDOUT;
+}
+
+// ===== 任务 =====
+static struct host_task *task_new(const char *name, UBaseType_t prio, uint32_t stack) {
+    struct host_task *t = calloc(1, sizeof(*t));
+    if (!t) return NULL;
+    snprintf(t->name, sizeof(t->name), "%s", name ? name : "");
+    t->prio = prio;
+    t->stack = stack;
+    t->state = eReady;
+    pthread_mutex_init(&t->lock, NULL);
+    cond_init(&t->cond);
+    pthread_mutex_lock(&s_tasks_lock);
+    t->number = ++s_task_count;
+    for (int i = 0; i < HOST_MAX_TASKS; i++) {
+        if (!s_tasks[i]) { s_tasks[i] = t; break; }
+    }
+    pthread_mutex_unlock(&s_tasks_lock);
+    return t;
+}
+
+static inline eTaskState state_get(const struct host_task *t) { return __atomic_load_n(&t->state, __ATOMIC_RELAXED); }
+static inline void state_set(struct host_task *t, eTaskState st) { __atomic_store_n(&t->state, st, __ATOMIC_RELAXED); }
+
+// 非任务线程（main、hal_sim 定时器线程）首次调用时登记为任务
+static struct host_task *self(void) {
+    if (!s_self && (s_self = task_new("main", 1, 0)) != NULL) {
+        s_self->thread = pthread_self();
+    }
+    return s_self;
+}
+
+// 阻塞等待期间报告为 eBlocked（uxTaskGetSystemState 中调用者本身为 eRunning，其余为 eReady）
+static struct host_task *block_begin(TickType_t ticks) {
+    struct host_task *t = self();
+    if (ticks != 0) state_set(t, eBlocked);
+    return t;
+}
+
+static void block_end(struct host_task *t) { state_set(t, eReady); }
+
+static void *task_entry(void *p) {
+    s_self = p;
+    s_self->fn(s_self->arg);
+    // FreeRTOS 任务函数不得返回
+    abort();
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg, UBaseType_t prio, TaskHandle_t *out) {
+    struct host_task *t = task_new(name, prio, stack);
+    if (!t) return pdFAIL;
+    t->fn = fn;
+    t->arg = arg;
+    // 句柄先于任务运行写出（调用方常在任务里用到自己的句柄）
+    if (out) *out = t;
+    pthread_attr_t a;
+    pthread_attr_init(&a);
+    pthread_attr_setdetachstate(&a, PTHREAD_CREATE_DETACHED);
+    int rc = pthread_create(&t->thread, &a, task_entry, t);
+    pthread_attr_destroy(&a);
+    if (rc != 0) {
+        state_set(t, eDeleted);
+        if (out) *out = NULL;
+        return pdFAIL;
+    }
+    return pdPASS;
+}
+
+// 只支持删除自身（固件中仅此用法）；结构保留供 uxTaskGetSystemState 跳过
+void vTaskDelete(TaskHandle_t task) {
+    struct host_task *t = task ? task : self();
+    // 持锁置位：uxTaskGetSystemState 持同一把锁读取线程 CPU 时间，不会碰到已退出的线程
+    pthread_mutex_lock(&s_tasks_lock);
+    state_set(t, eDeleted);
+    pthread_mutex_unlock(&s_tasks_lock);
+    if (t == s_self) pthread_exit(NULL);
+}
+
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) { sched_yield(); return; }
+    struct timespec ts;
+    deadline(ticks, &ts);
+    struct host_task *me = block_begin(ticks);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+    block_end(me);
+}
+
+// 节拍从首次调用起计
+static struct timespec s_tick_t0;
+static pthread_once_t s_tick_once = PTHREAD_ONCE_INIT;
+
+static void tick_origin(void) { clock_gettime(CLOCK_MONOTONIC, &s_tick_t0); }
+
+TickType_t xTaskGetTickCount(void) {
+    pthread_once(&s_tick_once, tick_origin);
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    int64_t ms = (int64_t)(ts.tv_sec - s_tick_t0.tv_sec) * 1000 + (ts.tv_nsec - s_tick_t0.tv_nsec) / 1000000;
+    return (TickType_t)(ms / portTICK_PERIOD_MS);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+    struct host_task *t = block_begin(ticks);
+    struct timespec ts;
+    bool timed = deadline(ticks, &ts);
+    pthread_mutex_lock(&t->lock);
+    while (t->notify == 0 && ticks != 0) {
+        if (!cond_wait(&t->cond, &t->lock, timed, &ts)) break;
+    }
+    block_end(t);
+    uint32_t n = t->notify;
+    if (n) t->notify = clear ? 0 : n - 1;
+    pthread_mutex_unlock(&t->lock);
+    return n;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    if (!task) return pdFAIL;
+    pthread_mutex_lock(&task->lock);
+    task->notify++;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+    return pdPASS;
+}
+
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t prio) { (task ? task : self())->prio = prio; }
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task) { return (task ? task : self())->prio; }
+
+// 线程 CPU 时间 (us)，线程已退出时为 0
+static uint32_t task_runtime_us(struct host_task *t) {
+    clockid_t cid;
+    struct timespec ts;
+    if (state_get(t) == eDeleted || pthread_getcpuclockid(t->thread, &cid) != 0 || clock_gettime(cid, &ts) != 0) return 0;
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+
+// 运行时间与板上 esp_timer 计数一致按 us 计：各任务取线程 CPU 时间，总量取进程启动以来的墙钟时间；栈余量在主机上无意义，按 0 返回
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *out, UBaseType_t max, uint32_t *total_runtime) {
+    UBaseType_t n = 0;
+    pthread_mutex_lock(&s_tasks_lock);
+    for (int i = 0; i < HOST_MAX_TASKS && n < max; i++) {
+        struct host_task *t = s_tasks[i];
+        if (!t || state_get(t) == eDeleted) continue;
+        out[n++] = (TaskStatus_t){
+            .xHandle = t, .pcTaskName = t->name, .xTaskNumber = t->number,
+            .eCurrentState = t == s_self ? eRunning : state_get(t),
+            .uxCurrentPriority = t->prio, .uxBasePriority = t->prio,
+            .ulRunTimeCounter = task_runtime_us(t),
+        };
+    }
+    pthread_mutex_unlock(&s_tasks_lock);
+    if (total_runtime) {
+        pthread_once(&s_tick_once, tick_origin);
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        *total_runtime = (uint32_t)((int64_t)(ts.tv_sec - s_tick_t0.tv_sec) * 1000000 + (ts.tv_nsec - s_tick_t0.tv_nsec) / 1000);
+    }
+    return n;
+}
+
+// ===== 信号量：计数 + 持有者（互斥量），递归互斥量允许持有者重入 =====
+struct host_sem {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    UBaseType_t count;
+    bool mutex;
+    bool recursive;
+    struct host_task *owner;
+    UBaseType_t depth;
+};
+
+static SemaphoreHandle_t sem_new(UBaseType_t count, bool mutex, bool recursive) {
+    struct host_sem *s = calloc(1, sizeof(*s));
+    if (!s) return NULL;
+    pthread_mutex_init(&s->lock, NULL);
+    cond_init(&s->cond);
+    s->count = count;
+    s->mutex = mutex;
+    s->recursive = recursive;
+    return s;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) { return sem_new(1, true, false); }
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex(void) { return sem_new(1, true, true); }
+SemaphoreHandle_t xSemaphoreCreateBinary(void) { return sem_new(0, false, false); }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t ticks) {
+    struct host_task *me = block_begin(ticks);
+    struct timespec ts;
+    bool timed = deadline(ticks, &ts);
+    BaseType_t ok = pdFALSE;
+    pthread_mutex_lock(&s->lock);
+    if (s->recursive && s->owner == me) {
+        s->depth++;
+        ok = pdTRUE;
+    } else {
+        while (s->count == 0 && ticks != 0) {
+            if (!cond_wait(&s->cond, &s->lock, timed, &ts)) break;
+        }
+        if (s->count > 0) {
+            s->count--;
+            if (s->mutex) { s->owner = me; s->depth = 1; }
+            ok = pdTRUE;
+        }
+    }
+    pthread_mutex_unlock(&s->lock);
+    block_end(me);
+    return ok;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    BaseType_t ok = pdTRUE;
+    pthread_mutex_lock(&s->lock);
+    if (s->mutex) {
+        if (s->owner != self()) ok = pdFALSE;
+        else if (--s->depth == 0) { s->owner = NULL; s->count = 1; pthread_cond_signal(&s->cond); }
+    } else if (s->count == 0) {
+        s->count = 1;
+        pthread_cond_signal(&s->cond);
+    } else {
+        ok = pdFALSE;
+    }
+    pthread_mutex_unlock(&s->lock);
+    return ok;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t s) {
+    if (!s) return;
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->cond);
+    free(s);
+}
+
+// ===== 队列：定长环形缓冲，按值拷贝 =====
+struct host_queue {
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty, not_full;
+    UBaseType_t len, item_size, head, count;
+    uint8_t *buf;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t len, UBaseType_t item_size) {
+    struct host_queue *q = calloc(1, sizeof(*q));
+    if (!q) return NULL;
+    q->buf = malloc((size_t)len * item_size);
+    if (!q->buf) { free(q); return NULL; }
+    pthread_mutex_init(&q->lock, NULL);
+    cond_init(&q->not_empty);
+    cond_init(&q->not_full);
+    q->len = len;
+    q->item_size = item_size;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t ticks) {
+    struct host_task *me = block_begin(ticks);
+    struct timespec ts;
+    bool timed = deadline(ticks, &ts);
+    BaseType_t ok = pdFALSE;
+    pthread_mutex_lock(&q->lock);
+    while (q->count == q->len && ticks != 0) {
+        if (!cond_wait(&q->not_full, &q->lock, timed, &ts)) break;
+    }
+    if (q->count < q->len) {
+        memcpy(q->buf + (size_t)((q->head + q->count) % q->len) * q->item_size, item, q->item_size);
+        q->count++;
+        pthread_cond_signal(&q->not_empty);
+        ok = pdTRUE;
+    }
+    pthread_mutex_unlock(&q->lock);
+    block_end(me);
+    return ok;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t ticks) {
+    struct host_task *me = block_begin(ticks);
+    struct timespec ts;
+    bool timed = deadline(ticks, &ts);
+    BaseType_t ok = pdFALSE;
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0 && ticks != 0) {
+        if (!cond_wait(&q->not_empty, &q->lock, timed, &ts)) break;
+    }
+    if (q->count > 0) {
+        memcpy(item, q->buf + (size_t)q->head * q->item_size, q->item_size);
+        q->head = (q->head + 1) % q->len;
+        q->count--;
+        pthread_cond_signal(&q->not_full);
+        ok = pdTRUE;
+    }
+    pthread_mutex_unlock(&q->lock);
+    block_end(me);
+    return ok;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    pthread_mutex_lock(&q->lock);
+    UBaseType_t n = q->count;
+    pthread_mutex_unlock(&q->lock);
+    return n;
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t q) {
+    pthread_mutex_lock(&q->lock);
+    UBaseType_t n = q->len - q->count;
+    pthread_mutex_unlock(&q->lock);
+    return n;
+}
+
+void vQueueDelete(QueueHandle_t q) {
+    if (!q) return;
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+    free(q->buf);
+    free(q);
+}
+
+// ===== 事件组 =====
+struct host_event_group {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    EventBits_t bits;
+};
+
+EventGroupHandle_t xEventGroupCreate(void) {
+    struct host_event_group *eg = calloc(1, sizeof(*eg));
+    if (!eg) return NULL;
+    pthread_mutex_init(&eg->lock, NULL);
+    cond_init(&eg->cond);
+    return eg;
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t eg, EventBits_t bits) {
+    pthread_mutex_lock(&eg->lock);
+    eg->bits |= bits;
+    EventBits_t now = eg->bits;
+    pthread_cond_broadcast(&eg->cond);
+    pthread_mutex_unlock(&eg->lock);
+    return now;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t eg, EventBits_t bits) {
+    pthread_mutex_lock(&eg->lock);
+    EventBits_t prev = eg->bits;
+    eg->bits &= ~bits;
+    pthread_mutex_unlock(&eg->lock);
+    return prev;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t eg, EventBits_t bits, BaseType_t clear, BaseType_t all, TickType_t ticks) {
+    struct host_task *me = block_begin(ticks);
+    struct timespec ts;
+    bool timed = deadline(ticks, &ts);
+    pthread_mutex_lock(&eg->lock);
+    for (;;) {
+        EventBits_t hit = eg->bits & bits;
+        if (all ? hit == bits : hit != 0) break;
+        if (ticks == 0 || !cond_wait(&eg->cond, &eg->lock, timed, &ts)) break;
+    }
+    EventBits_t now = eg->bits;
+    EventBits_t hit = now & bits;
+    if (clear && (all ? hit == bits : hit != 0)) eg->bits &= ~bits;
+    pthread_mutex_unlock(&eg->lock);
+    block_end(me);
+    return now;
+}
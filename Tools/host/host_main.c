@@ -0,0 +1,12 @@
+// fw_host：整机固件（main/ + Hardware/ + Test/，hal_sim.c 仿真外设）作为 Linux 进程运行
+// 与板上相同，app_main 在 "main" 任务（此处为进程主线程）中执行；HTTP 监听 127.0.0.1:HAL_SIM_HTTP_PORT
+#include <signal.h>
+
+void app_main(void);
+
+int main(void) {
+    // 对端提前关闭时 send 返回错误而不是终止进程（lwIP 无 SIGPIPE）
+    signal(SIGPIPE, SIG_IGN);
+    app_main();
+    return 0;
+}
@@ -0,0 +1,533 @@
+// 主机整机的 esp_http_server 垫片：BSD 套接字 + 一个服务任务
+// 与 IDF 相同的执行模型：服务任务 select 监听套接字、控制套接字与全部会话，逐个请求调用处理函数；
+// httpd_queue_work 经控制套接字唤醒服务任务执行；会话满时按 lru_purge_enable 关闭最久未用的会话
+#define _GNU_SOURCE
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "httpd";
+
+typedef struct host_sess {
+    int fd;                     // -1 为空闲槽
+    void *ctx;
+    httpd_free_ctx_fn_t free_ctx;
+    bool close;                 // 待关闭（httpd_sess_trigger_close 或处理失败）
+    uint64_t lru;
+    size_t len;                 // buf 中已收到、尚未消费的字节
+    char buf[HTTPD_MAX_REQ_HDR_LEN];
+} host_sess_t;
+
+typedef struct host_work {
+    httpd_work_fn_t fn;
+    void *arg;
+    struct host_work *next;
+} host_work_t;
+
+typedef struct {
+    httpd_config_t cfg;
+    int listen_fd;
+    int ctrl[2];                // [0] 服务任务读，[1] httpd_queue_work 写
+    pthread_mutex_t uri_lock;   // 处理函数表：服务启动后仍可由其他任务注册
+    httpd_uri_t *handlers;
+    int n_handlers;
+    host_sess_t *sess;
+    uint64_t lru_counter;
+    pthread_mutex_t work_lock;
+    host_work_t *work_head, *work_tail;
+} host_httpd_t;
+
+// 请求处理期间的响应状态（req->aux）
+typedef struct {
+    host_httpd_t *hd;
+    host_sess_t *sess;
+    size_t remaining;           // 未读的请求体字节
+    const char *status;
+    const char *type;
+    const char *hdr_field[16];
+    const char *hdr_value[16];
+    int n_hdr;
+    bool chunked;               // 已发出分块响应头
+    bool send_failed;
+    bool responded;             // 处理函数已发出响应
+    bool conn_close;            // 请求或响应带 Connection: close：已回复时处理完即关闭会话
+                                //（未回复的由异步回复方 httpd_sess_trigger_close）
+} host_req_aux_t;
+
+uint16_t httpd_sim_default_port(void) {
+    const char *p = getenv("HAL_SIM_HTTP_PORT");
+    int port = p ? atoi(p) : 8080;
+    return (port > 0 && port < 65536) ? (uint16_t)port : 8080;
+}
+
+static int send_all(int fd, const char *buf, size_t len) {
+    size_t off = 0;
+    while (off < len) {
+        ssize_t n = send(fd, buf + off, len - off, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        off += (size_t)n;
+    }
+    return 0;
+}
+
+// ===== 会话 =====
+static void sess_close(host_sess_t *s) {
+    if (s->fd < 0) return;
+    if (s->ctx) {
+        if (s->free_ctx) s->free_ctx(s->ctx);
+        else free(s->ctx);
+    }
+    close(s->fd);
+    *s = (host_sess_t){ .fd = -1 };
+}
+
+static host_sess_t *sess_find(host_httpd_t *hd, int fd) {
+    for (int i = 0; i < hd->cfg.max_open_sockets; i++) {
+        if (hd->sess[i].fd == fd && fd >= 0) return &hd->sess[i];
+    }
+    return NULL;
+}
+
+static void sess_accept(host_httpd_t *hd) {
+    int fd = accept(hd->listen_fd, NULL, NULL);
+    if (fd < 0) return;
+    host_sess_t *slot = NULL, *oldest = NULL;
+    for (int i = 0; i < hd->cfg.max_open_sockets; i++) {
+        host_sess_t *s = &hd->sess[i];
+        if (s->fd < 0) { slot = s; break; }
+        if (!oldest || s->lru < oldest->lru) oldest = s;
+    }
+    if (!slot && hd->cfg.lru_purge_enable && oldest) {
+        ESP_LOGD(TAG, "LRU purge fd %d", oldest->fd);
+        sess_close(oldest);
+        slot = oldest;
+    }
+    if (!slot) {
+        ESP_LOGW(TAG, "no free session, closing fd %d", fd);
+        close(fd);
+        return;
+    }
+    struct timeval rcv = { .tv_sec = hd->cfg.recv_wait_timeout }, snd = { .tv_sec = hd->cfg.send_wait_timeout };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &rcv, sizeof(rcv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &snd, sizeof(snd));
+    *slot = (host_sess_t){ .fd = fd, .lru = ++hd->lru_counter };
+}
+
+// ===== 响应 =====
+static const char *err_status(httpd_err_code_t e) {
+    switch (e) {
+    case HTTPD_400_BAD_REQUEST:              return "400 Bad Request";
+    case HTTPD_404_NOT_FOUND:                return "404 Not Found";
+    case HTTPD_405_METHOD_NOT_ALLOWED:       return "405 Method Not Allowed";
+    case HTTPD_408_REQ_TIMEOUT:              return "408 Request Timeout";
+    case HTTPD_411_LENGTH_REQUIRED:          return "411 Length Required";
+    case HTTPD_414_URI_TOO_LONG:             return "414 URI Too Long";
+    case HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE: return "431 Request Header Fields Too Large";
+    case HTTPD_501_METHOD_NOT_IMPLEMENTED:   return "501 Method Not Implemented";
+    default:                                 return "500 Internal Server Error";
+    }
+}
+
+static int resp_head(httpd_req_t *r, char *out, size_t len, const char *length_hdr) {
+    host_req_aux_t *a = r->aux;
+    int w = snprintf(out, len, "HTTP/1.1 %s\r\nContent-Type: %s\r\n%s\r\n", a->status, a->type, length_hdr);
+    for (int i = 0; i < a->n_hdr && w > 0 && (size_t)w < len; i++) {
+        w += snprintf(out + w, len - w, "%s: %s\r\n", a->hdr_field[i], a->hdr_value[i]);
+    }
+    if (w > 0 && (size_t)w < len) w += snprintf(out + w, len - w, "\r\n");
+    return (w > 0 && (size_t)w < len) ? w : -1;
+}
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status) {
+    ((host_req_aux_t *)r->aux)->status = status;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type) {
+    ((host_req_aux_t *)r->aux)->type = type;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_hdr(httpd_req_t *r, const char *field, const char *value) {
+    host_req_aux_t *a = r->aux;
+    if (a->n_hdr >= a->hd->cfg.max_resp_headers || a->n_hdr >= (int)(sizeof(a->hdr_field) / sizeof(a->hdr_field[0]))) {
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+    if (strcasecmp(field, "Connection") == 0 && strcasecmp(value, "close") == 0) a->conn_close = true;
+    a->hdr_field[a->n_hdr] = field;
+    a->hdr_value[a->n_hdr++] = value;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len) {
+    host_req_aux_t *a = r->aux;
+    size_t n = buf_len < 0 ? (buf ? strlen(buf) : 0) : (size_t)buf_len;
+    char head[1024], len_hdr[40];
+    snprintf(len_hdr, sizeof(len_hdr), "Content-Length: %zu", n);
+    int h = resp_head(r, head, sizeof(head), len_hdr);
+    a->responded = true;
+    if (h < 0 || send_all(a->sess->fd, head, (size_t)h) != 0 || (n && send_all(a->sess->fd, buf, n) != 0)) {
+        a->send_failed = true;
+        return ESP_ERR_HTTPD_RESP_SEND;
+    }
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len) {
+    host_req_aux_t *a = r->aux;
+    size_t n = buf_len < 0 ? (buf ? strlen(buf) : 0) : (size_t)buf_len;
+    if (!a->chunked) {
+        char head[1024];
+        int h = resp_head(r, head, sizeof(head), "Transfer-Encoding: chunked");
+        a->responded = true;
+        if (h < 0 || send_all(a->sess->fd, head, (size_t)h) != 0) goto fail;
+        a->chunked = true;
+    }
+    char sz[16];
+    int k = snprintf(sz, sizeof(sz), "%zx\r\n", n);
+    if (send_all(a->sess->fd, sz, (size_t)k) != 0) goto fail;
+    if (n && send_all(a->sess->fd, buf, n) != 0) goto fail;
+    if (send_all(a->sess->fd, "\r\n", 2) != 0) goto fail;
+    return ESP_OK;
+fail:
+    a->send_failed = true;
+    return ESP_ERR_HTTPD_RESP_SEND;
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t *r, httpd_err_code_t error, const char *msg) {
+    const char *status = err_status(error);
+    httpd_resp_set_status(r, status);
+    httpd_resp_set_type(r, "text/html");
+    return httpd_resp_send(r, msg ? msg : status, HTTPD_RESP_USE_STRLEN);
+}
+
+// ===== 请求 =====
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len) {
+    host_req_aux_t *a = r->aux;
+    if (a->remaining == 0 || buf_len == 0) return 0;
+    if (buf_len > a->remaining) buf_len = a->remaining;
+    host_sess_t *s = a->sess;
+    if (s->len) {
+        size_t n = s->len < buf_len ? s->len : buf_len;
+        memcpy(buf, s->buf, n);
+        memmove(s->buf, s->buf + n, s->len - n);
+        s->len -= n;
+        a->remaining -= n;
+        return (int)n;
+    }
+    ssize_t n = recv(s->fd, buf, buf_len, 0);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) return HTTPD_SOCK_ERR_TIMEOUT;
+    if (n <= 0) return HTTPD_SOCK_ERR_FAIL;
+    a->remaining -= (size_t)n;
+    return (int)n;
+}
+
+size_t httpd_req_get_url_query_len(httpd_req_t *r) {
+    const char *q = strchr(r->uri, '?');
+    return q ? strlen(q + 1) : 0;
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len) {
+    const char *q = strchr(r->uri, '?');
+    if (!q) return ESP_ERR_NOT_FOUND;
+    if (!buf || buf_len == 0) return ESP_ERR_INVALID_ARG;
+    snprintf(buf, buf_len, "%s", q + 1);
+    return strlen(q + 1) < buf_len ? ESP_OK : ESP_ERR_HTTPD_RESULT_TRUNC;
+}
+
+// 与 IDF 相同：不做 URL 解码
+esp_err_t httpd_query_key_value(const char *qry, const char *key, char *val, size_t val_size) {
+    if (!qry || !key || !val || val_size == 0) return ESP_ERR_INVALID_ARG;
+    size_t klen = strlen(key);
+    for (const char *p = qry; *p; ) {
+        const char *end = strchr(p, '&');
+        if (!end) end = p + strlen(p);
+        if ((size_t)(end - p) > klen && strncmp(p, key, klen) == 0 && p[klen] == '=') {
+            const char *v = p + klen + 1;
+            size_t n = (size_t)(end - v);
+            size_t c = n < val_size - 1 ? n : val_size - 1;
+            memcpy(val, v, c);
+            val[c] = 0;
+            return n < val_size ? ESP_OK : ESP_ERR_HTTPD_RESULT_TRUNC;
+        }
+        p = *end ? end + 1 : end;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+int httpd_req_to_sockfd(httpd_req_t *r) { return ((host_req_aux_t *)r->aux)->sess->fd; }
+
+bool httpd_uri_match_wildcard(const char *tpl, const char *uri, size_t match_upto) {
+    size_t tlen = strlen(tpl);
+    if (tlen && tpl[tlen - 1] == '*') {
+        tlen--;
+        return match_upto >= tlen && strncmp(tpl, uri, tlen) == 0;
+    }
+    // 末尾 '?'：前一个字符可有可无
+    if (tlen && tpl[tlen - 1] == '?') {
+        tlen--;
+        if (tlen && match_upto == tlen - 1 && strncmp(tpl, uri, tlen - 1) == 0) return true;
+    }
+    return match_upto == tlen && strncmp(tpl, uri, tlen) == 0;
+}
+
+static int parse_method(const char *m, size_t n) {
+    static const struct { const char *name; int method; } M[] = {
+        { "GET", HTTP_GET }, { "POST", HTTP_POST }, { "OPTIONS", HTTP_OPTIONS },
+        { "PUT", HTTP_PUT }, { "DELETE", HTTP_DELETE }, { "HEAD", HTTP_HEAD },
+    };
+    for (size_t i = 0; i < sizeof(M) / sizeof(M[0]); i++) {
+        if (strlen(M[i].name) == n && strncmp(M[i].name, m, n) == 0) return M[i].method;
+    }
+    return -1;
+}
+
+// 直接回复错误（无请求对象时）并关闭会话
+static void sess_fail(host_sess_t *s, httpd_err_code_t e) {
+    char buf[160];
+    const char *st = err_status(e);
+    int n = snprintf(buf, sizeof(buf), "HTTP/1.1 %s\r\nContent-Type: text/html\r\nContent-Length: %zu\r\n\r\n%s",
+                     st, strlen(st), st);
+    send_all(s->fd, buf, (size_t)n);
+    s->close = true;
+}
+
+// 处理缓冲区中的一个完整请求头；请求头未收全返回 false
+static bool sess_handle_one(host_httpd_t *hd, host_sess_t *s) {
+    char *end = NULL;
+    for (size_t i = 0; i + 3 < s->len; i++) {
+        if (memcmp(s->buf + i, "\r\n\r\n", 4) == 0) { end = s->buf + i; break; }
+    }
+    if (!end) {
+        if (s->len == sizeof(s->buf)) sess_fail(s, HTTPD_431_REQ_HDR_FIELDS_TOO_LARGE);
+        return false;
+    }
+    static httpd_req_t req;       // 只在服务任务中使用（与 IDF 相同，每个服务实例一个请求对象）
+    host_req_aux_t aux = { .hd = hd, .sess = s, .status = "200 OK", .type = "text/html" };
+    req = (httpd_req_t){ .handle = hd, .aux = &aux, .sess_ctx = s->ctx, .free_ctx = s->free_ctx };
+
+    // 请求行：METHOD SP URI SP HTTP/1.x
+    *end = 0;
+    char *line_end = strstr(s->buf, "\r\n");
+    if (line_end) *line_end = 0;
+    char *sp1 = strchr(s->buf, ' '), *sp2 = sp1 ? strchr(sp1 + 1, ' ') : NULL;
+    int method = sp1 ? parse_method(s->buf, (size_t)(sp1 - s->buf)) : -1;
+    if (!sp2 || strncmp(sp2 + 1, "HTTP/1.", 7) != 0) { sess_fail(s, HTTPD_400_BAD_REQUEST); return false; }
+    if (method < 0) { sess_fail(s, HTTPD_501_METHOD_NOT_IMPLEMENTED); return false; }
+    if ((size_t)(sp2 - sp1 - 1) > HTTPD_MAX_URI_LEN) { sess_fail(s, HTTPD_414_URI_TOO_LONG); return false; }
+    req.method = method;
+    memcpy(req.uri, sp1 + 1, (size_t)(sp2 - sp1 - 1));
+    req.uri[sp2 - sp1 - 1] = 0;
+
+    // 头部：只关心 Content-Length
+    for (char *h = line_end ? line_end + 2 : end; h && h < end; ) {
+        char *eol = strstr(h, "\r\n");
+        if (eol) *eol = 0;
+        if (strncasecmp(h, "Content-Length:", 15) == 0) req.content_len = strtoul(h + 15, NULL, 10);
+        else if (strncasecmp(h, "Transfer-Encoding:", 18) == 0) { sess_fail(s, HTTPD_411_LENGTH_REQUIRED); return false; }
+        else if (strncasecmp(h, "Connection:", 11) == 0 && strcasestr(h + 11, "close")) aux.conn_close = true;
+        h = eol ? eol + 2 : NULL;
+    }
+    size_t used = (size_t)(end - s->buf) + 4;
+    memmove(s->buf, s->buf + used, s->len - used);
+    s->len -= used;
+    aux.remaining = req.content_len;
+
+    // 按方法 + 匹配函数查找处理函数
+    size_t upto = strcspn(req.uri, "?");
+    httpd_uri_t hit = { 0 };
+    bool uri_known = false;
+    pthread_mutex_lock(&hd->uri_lock);
+    for (int i = 0; i < hd->n_handlers; i++) {
+        const httpd_uri_t *u = &hd->handlers[i];
+        bool m = hd->cfg.uri_match_fn ? hd->cfg.uri_match_fn(u->uri, req.uri, upto)
+                                      : (strlen(u->uri) == upto && strncmp(u->uri, req.uri, upto) == 0);
+        if (!m) continue;
+        uri_known = true;
+        if ((int)u->method == method) { hit = *u; break; }
+    }
+    pthread_mutex_unlock(&hd->uri_lock);
+    esp_err_t ret;
+    if (!hit.handler) {
+        httpd_resp_send_err(&req, uri_known ? HTTPD_405_METHOD_NOT_ALLOWED : HTTPD_404_NOT_FOUND, NULL);
+        ret = ESP_FAIL;
+    } else {
+        req.user_ctx = hit.user_ctx;
+        ret = hit.handler(&req);
+    }
+    // 处理函数可设置/替换会话上下文
+    if (req.sess_ctx != s->ctx) {
+        if (s->ctx) { if (s->free_ctx) s->free_ctx(s->ctx); else free(s->ctx); }
+        s->ctx = req.sess_ctx;
+    }
+    s->free_ctx = req.free_ctx;
+    // 丢弃未读的请求体，保持连接可复用
+    char sink[256];
+    while (ret == ESP_OK && aux.remaining) {
+        int n = httpd_req_recv(&req, sink, sizeof(sink));
+        if (n <= 0) ret = ESP_FAIL;
+    }
+    if (ret != ESP_OK || aux.send_failed || (aux.conn_close && aux.responded)) s->close = true;
+    return !s->close;
+}
+
+static void sess_readable(host_httpd_t *hd, host_sess_t *s) {
+    ssize_t n = recv(s->fd, s->buf + s->len, sizeof(s->buf) - s->len, 0);
+    if (n <= 0) {
+        if (n < 0 && (errno == EAGAIN || errno == EINTR)) return;
+        sess_close(s);
+        return;
+    }
+    s->len += (size_t)n;
+    s->lru = ++hd->lru_counter;
+    while (sess_handle_one(hd, s)) {}
+    if (s->close) sess_close(s);
+}
+
+// ===== 工作队列 =====
+esp_err_t httpd_queue_work(httpd_handle_t handle, httpd_work_fn_t work, void *arg) {
+    host_httpd_t *hd = handle;
+    host_work_t *w = malloc(sizeof(*w));
+    if (!hd || !w) { free(w); return ESP_FAIL; }
+    *w = (host_work_t){ .fn = work, .arg = arg };
+    pthread_mutex_lock(&hd->work_lock);
+    if (hd->work_tail) hd->work_tail->next = w; else hd->work_head = w;
+    hd->work_tail = w;
+    pthread_mutex_unlock(&hd->work_lock);
+    char c = 'w';
+    if (write(hd->ctrl[1], &c, 1) != 1) ESP_LOGW(TAG, "ctrl socket write failed");
+    return ESP_OK;
+}
+
+static void run_work(host_httpd_t *hd) {
+    char drain[64];
+    while (recv(hd->ctrl[0], drain, sizeof(drain), MSG_DONTWAIT) > 0) {}
+    pthread_mutex_lock(&hd->work_lock);
+    host_work_t *w = hd->work_head;
+    hd->work_head = hd->work_tail = NULL;
+    pthread_mutex_unlock(&hd->work_lock);
+    while (w) {
+        host_work_t *next = w->next;
+        w->fn(w->arg);
+        free(w);
+        w = next;
+    }
+}
+
+int httpd_socket_send(httpd_handle_t handle, int sockfd, const char *buf, size_t buf_len, int flags) {
+    (void)handle;
+    ssize_t n = send(sockfd, buf, buf_len, flags | MSG_NOSIGNAL);
+    if (n < 0) return (errno == EAGAIN || errno == EWOULDBLOCK) ? HTTPD_SOCK_ERR_TIMEOUT : HTTPD_SOCK_ERR_FAIL;
+    return (int)n;
+}
+
+void *httpd_sess_get_ctx(httpd_handle_t handle, int sockfd) {
+    host_sess_t *s = sess_find(handle, sockfd);
+    return s ? s->ctx : NULL;
+}
+
+void httpd_sess_set_ctx(httpd_handle_t handle, int sockfd, void *ctx, httpd_free_ctx_fn_t free_fn) {
+    host_sess_t *s = sess_find(handle, sockfd);
+    if (!s) return;
+    if (s->ctx && s->ctx != ctx) { if (s->free_ctx) s->free_ctx(s->ctx); else free(s->ctx); }
+    s->ctx = ctx;
+    s->free_ctx = free_fn;
+}
+
+// 只在服务任务中调用（处理函数或工作函数内）；本轮处理结束后关闭
+esp_err_t httpd_sess_trigger_close(httpd_handle_t handle, int sockfd) {
+    host_sess_t *s = sess_find(handle, sockfd);
+    if (!s) return ESP_ERR_NOT_FOUND;
+    s->close = true;
+    return ESP_OK;
+}
+
+// ===== 服务任务 =====
+static void httpd_task(void *arg) {
+    host_httpd_t *hd = arg;
+    for (;;) {
+        fd_set rd;
+        FD_ZERO(&rd);
+        FD_SET(hd->listen_fd, &rd);
+        FD_SET(hd->ctrl[0], &rd);
+        int maxfd = hd->listen_fd > hd->ctrl[0] ? hd->listen_fd : hd->ctrl[0];
+        for (int i = 0; i < hd->cfg.max_open_sockets; i++) {
+            int fd = hd->sess[i].fd;
+            if (fd < 0) continue;
+            FD_SET(fd, &rd);
+            if (fd > maxfd) maxfd = fd;
+        }
+        if (select(maxfd + 1, &rd, NULL, NULL, NULL) < 0) {
+            if (errno != EINTR) ESP_LOGE(TAG, "select: %s", strerror(errno));
+            continue;
+        }
+        if (FD_ISSET(hd->ctrl[0], &rd)) run_work(hd);
+        for (int i = 0; i < hd->cfg.max_open_sockets; i++) {
+            host_sess_t *s = &hd->sess[i];
+            if (s->fd >= 0 && !s->close && FD_ISSET(s->fd, &rd)) sess_readable(hd, s);
+            if (s->fd >= 0 && s->close) sess_close(s);
+        }
+        if (FD_ISSET(hd->listen_fd, &rd)) sess_accept(hd);
+    }
+}
+
+// 只监听回环地址：接口无鉴权，不暴露到主机所在网络
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config) {
+    host_httpd_t *hd = calloc(1, sizeof(*hd));
+    if (!hd) return ESP_ERR_NO_MEM;
+    hd->cfg = *config;
+    hd->listen_fd = hd->ctrl[0] = hd->ctrl[1] = -1;
+    hd->handlers = calloc(config->max_uri_handlers, sizeof(httpd_uri_t));
+    hd->sess = calloc(config->max_open_sockets, sizeof(host_sess_t));
+    if (!hd->handlers || !hd->sess) goto fail;
+    for (int i = 0; i < config->max_open_sockets; i++) hd->sess[i].fd = -1;
+    pthread_mutex_init(&hd->work_lock, NULL);
+    pthread_mutex_init(&hd->uri_lock, NULL);
+    hd->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (hd->listen_fd < 0) goto fail;
+    int one = 1;
+    setsockopt(hd->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr = { .sin_family = AF_INET, .sin_port = htons(config->server_port) };
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(hd->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+        listen(hd->listen_fd, config->backlog_conn) != 0) {
+        ESP_LOGE(TAG, "bind/listen port %u: %s", config->server_port, strerror(errno));
+        goto fail;
+    }
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, hd->ctrl) != 0) goto fail;
+    if (xTaskCreate(httpd_task, "httpd", config->stack_size, hd, config->task_priority, NULL) != pdPASS) goto fail;
+    *handle = hd;
+    ESP_LOGI(TAG, "listening on 127.0.0.1:%u", config->server_port);
+    return ESP_OK;
+fail:
+    if (hd->listen_fd >= 0) close(hd->listen_fd);
+    if (hd->ctrl[0] >= 0) { close(hd->ctrl[0]); close(hd->ctrl[1]); }
+    free(hd->handlers);
+    free(hd->sess);
+    free(hd);
+    return ESP_ERR_HTTPD_TASK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler) {
+    host_httpd_t *hd = handle;
+    if (!hd || !uri_handler) return ESP_ERR_INVALID_ARG;
+    esp_err_t ret = ESP_OK;
+    pthread_mutex_lock(&hd->uri_lock);
+    if (hd->n_handlers >= hd->cfg.max_uri_handlers) ret = ESP_ERR_HTTPD_HANDLERS_FULL;
+    else hd->handlers[hd->n_handlers++] = *uri_handler;
+    pthread_mutex_unlock(&hd->uri_lock);
+    return ret;
+}
@@ -0,0 +1,110 @@
+// 主机整机的 ESP-IDF 系统组件垫片：日志、NVS、事件循环、netif/Wi-Fi（空操作）、堆统计、应用描述
+#include <malloc.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "esp_log.h"
+#include "esp_event.h"
+#include "esp_netif.h"
+#include "esp_wifi.h"
+#include "esp_heap_caps.h"
+#include "esp_app_desc.h"
+#include "nvs_flash.h"
+
+// ===== 日志 =====
+void host_log_write(char level, const char *tag, const char *fmt, ...) {
+    static struct timespec t0;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    if (t0.tv_sec == 0 && t0.tv_nsec == 0) t0 = ts;
+    long ms = (long)(ts.tv_sec - t0.tv_sec) * 1000 + (ts.tv_nsec - t0.tv_nsec) / 1000000;
+    char line[512];
+    int w = snprintf(line, sizeof(line), "%c (%ld) %s: ", level, ms, tag);
+    va_list ap;
+    va_start(ap, fmt);
+    if (w > 0 && (size_t)w < sizeof(line)) w += vsnprintf(line + w, sizeof(line) - w, fmt, ap);
+    va_end(ap);
+    if (w < 0) return;
+    if ((size_t)w >= sizeof(line) - 1) w = sizeof(line) - 2;
+    line[w] = '\n';
+    line[w + 1] = 0;
+    // 一次写出整行，多任务日志不交错
+    fputs(line, stderr);
+}
+
+// ===== NVS：主机上无 flash，直接成功 =====
+esp_err_t nvs_flash_init(void) { return ESP_OK; }
+esp_err_t nvs_flash_erase(void) { return ESP_OK; }
+
+// ===== 事件循环与 Wi-Fi：登记的处理函数在 esp_wifi_start 时同步调用 =====
+#define HOST_EVENT_HANDLERS 8
+static struct {
+    esp_event_base_t base;
+    int32_t id;
+    esp_event_handler_t fn;
+    void *arg;
+} s_handlers[HOST_EVENT_HANDLERS];
+static int s_handler_count;
+
+const esp_event_base_t WIFI_EVENT = "WIFI_EVENT";
+
+esp_err_t esp_event_loop_create_default(void) { return ESP_OK; }
+
+esp_err_t esp_event_handler_register(esp_event_base_t base, int32_t id, esp_event_handler_t handler, void *arg) {
+    if (s_handler_count >= HOST_EVENT_HANDLERS) return ESP_ERR_NO_MEM;
+    s_handlers[s_handler_count].base = base;
+    s_handlers[s_handler_count].id = id;
+    s_handlers[s_handler_count].fn = handler;
+    s_handlers[s_handler_count++].arg = arg;
+    return ESP_OK;
+}
+
+static void event_post(esp_event_base_t base, int32_t id) {
+    for (int i = 0; i < s_handler_count; i++) {
+        if (s_handlers[i].base == base && (s_handlers[i].id == id || s_handlers[i].id == ESP_EVENT_ANY_ID)) {
+            s_handlers[i].fn(s_handlers[i].arg, base, id, NULL);
+        }
+    }
+}
+
+esp_err_t esp_netif_init(void) { return ESP_OK; }
+esp_netif_t *esp_netif_create_default_wifi_ap(void) { return NULL; }
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *config) { (void)config; return ESP_OK; }
+esp_err_t esp_wifi_set_mode(wifi_mode_t mode) { (void)mode; return ESP_OK; }
+esp_err_t esp_wifi_set_config(wifi_interface_t interface, wifi_config_t *conf) { (void)interface; (void)conf; return ESP_OK; }
+
+esp_err_t esp_wifi_start(void) {
+    event_post(WIFI_EVENT, WIFI_EVENT_AP_START);
+    return ESP_OK;
+}
+
+// ===== 堆：glibc 主分配区的空闲字节；主机上无 internal/DMA 之分，各 caps 返回相同数据 =====
+void heap_caps_get_info(multi_heap_info_t *info, uint32_t caps) {
+    static size_t s_min_free = (size_t)-1;
+    (void)caps;
+    struct mallinfo2 mi = mallinfo2();
+    if (mi.fordblks < s_min_free) s_min_free = mi.fordblks;
+    *info = (multi_heap_info_t){
+        .total_free_bytes = mi.fordblks,
+        .total_allocated_bytes = mi.uordblks,
+        .largest_free_block = mi.fordblks,
+        .minimum_free_bytes = s_min_free,
+        .allocated_blocks = 0,
+        .free_blocks = mi.ordblks,
+        .total_blocks = mi.ordblks,
+    };
+}
+
+// ===== 应用描述 =====
+const esp_app_desc_t *esp_app_get_description(void) {
+    static const esp_app_desc_t desc = {
+        .version = "host",
+        .project_name = "esp32_smart_thermostat",
+        .time = __TIME__,
+        .date = __DATE__,
+        .idf_ver = "host-shim",
+    };
+    return &desc;
+}
@@ -0,0 +1,11 @@
+#ifndef HOST_SDKCONFIG_H
+#define HOST_SDKCONFIG_H
+
+// 主机整机：CPU 频率与 Wi-Fi 缓冲数与 sdkconfig 一致；主机套接字无 lwIP 内存池统计
+#define CONFIG_ESP32_WIFI_STATIC_RX_BUFFER_NUM  10
+#define CONFIG_ESP32_WIFI_DYNAMIC_RX_BUFFER_NUM 32
+#define CONFIG_ESP32_WIFI_DYNAMIC_TX_BUFFER_NUM 32
+#define CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ 160
+#define CONFIG_LWIP_STATS 0
+
+#endif
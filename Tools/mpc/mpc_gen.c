@@ -0,0 +1,506 @@
+// 显式 MPC 离线生成：FOPDT 加热对象 + 输入限幅 + 超调约束的多参数 QP，按有效约束集枚举求分段仿射解，
+// 输出 main/mpc_table.c（区域半平面 + 首个控制量的仿射律），并在参数网格上与逐点求解对比、闭环仿真对比 PID
+//   mpc_gen -o main/mpc_table.c                          # 默认模型（与 hal_sim 对象一致，另加 10 s 滞后）
+//   mpc_gen --gain 1.2 --tau 90 --dead 8 --overshoot 0.3 -o main/mpc_table.c
+//   mpc_gen --verify --sp 120 --mismatch 1.2             # 只校验/仿真，不写文件
+//
+// 优化问题（p = (x, r)，模型温升坐标，u 为输出 %）：
+//   min  Σ_{i=1..N} q (x_i - r)^2 + rho Σ_{t=0..N-1} (u_t - r/gain)^2
+//   s.t. x_{i+1} = a x_i + b u_i,  out_min <= u_t <= out_max,  x_i <= r + overshoot (i = 1..N)
+// 控制量按分块保持（--blocks），决策变量为各块的取值
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mpc_controller.h"
+#include "pid_controller.h"
+
+#define NU_MAX    4                     // 决策变量（分块）上限
+#define N_MAX     120                   // 预测步数上限
+#define CON_MAX   (2 * NU_MAX + N_MAX)
+#define POLY_MAX  (CON_MAX + 8)
+#define AREA_EPS  1e-3                  // 区域面积下限 (°C²)，更小的视为低维（边界）
+#define VERT_EPS  1e-6                  // 顶点落在半平面上的容差（半平面已归一化）
+
+// ===== 问题设置 =====
+static double g_gain = 1.5, g_tau = 120.0, g_dead = 10.0, g_ts = 2.0, g_ambient = 25.0;
+static double g_umin = 0.0, g_umax = 100.0, g_over = 0.5, g_q = 1.0, g_rho = 0.02;
+static int g_n = 60;
+static int g_nu = 3;
+static int g_blocks[NU_MAX] = { 1, 4, 55 };
+static double g_a, g_b;
+
+// 约束 G z <= w + sx*x + sr*r
+typedef struct { double g[NU_MAX]; double w, sx, sr; } con_t;
+static con_t g_con[CON_MAX];
+static int g_ncon;
+
+// 代价 1/2 z'Hz + z'(Fx*x + Fr*r)
+static double g_H[NU_MAX][NU_MAX], g_Fx[NU_MAX], g_Fr[NU_MAX];
+
+// 半平面 ax*x + ar*r <= b
+typedef struct { double ax, ar, b; } hp_t;
+
+// 一个有效约束集的解：z = Z[.][0] + Z[.][1]*x + Z[.][2]*r
+typedef struct { double Z[NU_MAX][3]; } law_t;
+
+typedef struct {
+    law_t law;
+    hp_t hp[POLY_MAX];
+    int nhp;
+    double area;
+} region_t;
+
+static law_t *g_cand;                   // 全部非奇异有效集的解（逐点校验用）
+static int g_ncand, g_cap_cand;
+static region_t *g_reg;
+static int g_nreg, g_cap_reg;
+
+static double g_xlo, g_xhi, g_rlo, g_rhi;
+
+static void setup(void) {
+    g_a = exp(-g_ts / g_tau);
+    g_b = g_gain * (1.0 - g_a);
+    int blk_of[N_MAX];
+    int t = 0;
+    for (int j = 0; j < g_nu; j++) {
+        for (int k = 0; k < g_blocks[j] && t < g_n; k++) blk_of[t++] = j;
+    }
+    while (t < g_n) blk_of[t++] = g_nu - 1;
+
+    // x_i = phi_i x0 + Σ_j Gam[i][j] z_j
+    double Gam[N_MAX + 1][NU_MAX];
+    double phi[N_MAX + 1];
+    memset(Gam, 0, sizeof(Gam));
+    phi[0] = 1.0;
+    for (int i = 1; i <= g_n; i++) {
+        phi[i] = g_a * phi[i - 1];
+        for (int j = 0; j < g_nu; j++) Gam[i][j] = g_a * Gam[i - 1][j];
+        Gam[i][blk_of[i - 1]] += g_b;
+    }
+
+    memset(g_H, 0, sizeof(g_H));
+    memset(g_Fx, 0, sizeof(g_Fx));
+    memset(g_Fr, 0, sizeof(g_Fr));
+    for (int i = 1; i <= g_n; i++) {
+        for (int j = 0; j < g_nu; j++) {
+            for (int k = 0; k < g_nu; k++) g_H[j][k] += 2.0 * g_q * Gam[i][j] * Gam[i][k];
+            g_Fx[j] += 2.0 * g_q * Gam[i][j] * phi[i];
+            g_Fr[j] -= 2.0 * g_q * Gam[i][j];
+        }
+    }
+    for (int t2 = 0; t2 < g_n; t2++) {
+        int j = blk_of[t2];
+        g_H[j][j] += 2.0 * g_rho;
+        g_Fr[j] -= 2.0 * g_rho / g_gain;
+    }
+
+    g_ncon = 0;
+    for (int j = 0; j < g_nu; j++) {
+        con_t *c = &g_con[g_ncon++];
+        memset(c, 0, sizeof(*c));
+        c->g[j] = 1.0; c->w = g_umax;
+        c = &g_con[g_ncon++];
+        memset(c, 0, sizeof(*c));
+        c->g[j] = -1.0; c->w = -g_umin;
+    }
+    for (int i = 1; i <= g_n; i++) {
+        con_t *c = &g_con[g_ncon++];
+        memcpy(c->g, Gam[i], sizeof(c->g));
+        c->w = g_over; c->sx = -phi[i]; c->sr = 1.0;
+    }
+
+    g_xlo = g_gain * g_umin; g_xhi = g_gain * g_umax;
+    g_rlo = g_gain * g_umin; g_rhi = g_gain * g_umax;
+}
+
+// 高斯消元（列主元），A 为 n x n，B 为 n x 3；奇异返回 false
+static bool solve(int n, double A[][NU_MAX * 2], double B[][3]) {
+    for (int c = 0; c < n; c++) {
+        int piv = c;
+        for (int r = c + 1; r < n; r++) if (fabs(A[r][c]) > fabs(A[piv][c])) piv = r;
+        if (fabs(A[piv][c]) < 1e-9) return false;
+        if (piv != c) {
+            for (int k = 0; k < n; k++) { double t = A[c][k]; A[c][k] = A[piv][k]; A[piv][k] = t; }
+            for (int k = 0; k < 3; k++) { double t = B[c][k]; B[c][k] = B[piv][k]; B[piv][k] = t; }
+        }
+        for (int r = 0; r < n; r++) {
+            if (r == c) continue;
+            double f = A[r][c] / A[c][c];
+            if (f == 0.0) continue;
+            for (int k = c; k < n; k++) A[r][k] -= f * A[c][k];
+            for (int k = 0; k < 3; k++) B[r][k] -= f * B[c][k];
+        }
+    }
+    for (int r = 0; r < n; r++) for (int k = 0; k < 3; k++) B[r][k] /= A[r][r];
+    return true;
+}
+
+// ===== 凸多边形（参数域矩形逐半平面裁剪） =====
+typedef struct { double x, r; } pt_t;
+
+static double hp_eval(const hp_t *h, pt_t p) { return h->ax * p.x + h->ar * p.r - h->b; }
+
+static int clip(pt_t *poly, int n, const hp_t *h) {
+    pt_t out[POLY_MAX * 2];
+    int m = 0;
+    for (int i = 0; i < n; i++) {
+        pt_t p = poly[i], q = poly[(i + 1) % n];
+        double fp = hp_eval(h, p), fq = hp_eval(h, q);
+        if (fp <= 0) out[m++] = p;
+        if ((fp < 0 && fq > 0) || (fp > 0 && fq < 0)) {
+            double t = fp / (fp - fq);
+            out[m++] = (pt_t){ p.x + t * (q.x - p.x), p.r + t * (q.r - p.r) };
+        }
+        if (m >= POLY_MAX * 2 - 2) break;
+    }
+    memcpy(poly, out, sizeof(pt_t) * m);
+    return m;
+}
+
+static double poly_area(const pt_t *p, int n) {
+    double s = 0;
+    for (int i = 0; i < n; i++) s += p[i].x * p[(i + 1) % n].r - p[(i + 1) % n].x * p[i].r;
+    return fabs(s) * 0.5;
+}
+
+static bool hp_normalize(hp_t *h) {
+    double n = hypot(h->ax, h->ar);
+    if (n < 1e-12) return false;
+    h->ax /= n; h->ar /= n; h->b /= n;
+    return true;
+}
+
+// 处理一个有效约束集
+static void visit(const int *act, int m) {
+    int n = g_nu + m;
+    double A[NU_MAX * 2][NU_MAX * 2] = {{0}};
+    double B[NU_MAX * 2][3] = {{0}};
+    for (int j = 0; j < g_nu; j++) {
+        for (int k = 0; k < g_nu; k++) A[j][k] = g_H[j][k];
+        B[j][1] = -g_Fx[j];
+        B[j][2] = -g_Fr[j];
+    }
+    for (int a = 0; a < m; a++) {
+        const con_t *c = &g_con[act[a]];
+        for (int j = 0; j < g_nu; j++) {
+            A[j][g_nu + a] = c->g[j];
+            A[g_nu + a][j] = c->g[j];
+        }
+        B[g_nu + a][0] = c->w;
+        B[g_nu + a][1] = c->sx;
+        B[g_nu + a][2] = c->sr;
+    }
+    if (!solve(n, A, B)) return;
+
+    if (g_ncand == g_cap_cand) {
+        g_cap_cand = g_cap_cand ? g_cap_cand * 2 : 1024;
+        g_cand = realloc(g_cand, sizeof(law_t) * g_cap_cand);
+    }
+    law_t *law = &g_cand[g_ncand++];
+    for (int j = 0; j < g_nu; j++) for (int k = 0; k < 3; k++) law->Z[j][k] = B[j][k];
+
+    // 临界区域：非有效约束满足 + 乘子非负
+    hp_t hp[CON_MAX];
+    int nhp = 0;
+    bool active[CON_MAX] = { false };
+    for (int a = 0; a < m; a++) active[act[a]] = true;
+    for (int k = 0; k < g_ncon; k++) {
+        if (active[k]) continue;
+        const con_t *c = &g_con[k];
+        hp_t h = { -c->sx, -c->sr, c->w };
+        for (int j = 0; j < g_nu; j++) {
+            h.ax += c->g[j] * law->Z[j][1];
+            h.ar += c->g[j] * law->Z[j][2];
+            h.b -= c->g[j] * law->Z[j][0];
+        }
+        if (hp_normalize(&h)) hp[nhp++] = h;
+        else if (h.b < -1e-9) return;           // 0 <= b 恒不成立
+    }
+    for (int a = 0; a < m; a++) {
+        hp_t h = { -B[g_nu + a][1], -B[g_nu + a][2], B[g_nu + a][0] };
+        if (hp_normalize(&h)) hp[nhp++] = h;
+        else if (h.b < -1e-9) return;
+    }
+
+    pt_t poly[POLY_MAX * 2] = { { g_xlo, g_rlo }, { g_xhi, g_rlo }, { g_xhi, g_rhi }, { g_xlo, g_rhi } };
+    int np = 4;
+    for (int k = 0; k < nhp && np >= 3; k++) np = clip(poly, np, &hp[k]);
+    if (np < 3) return;
+    double area = poly_area(poly, np);
+    if (area < AREA_EPS) return;
+
+    if (g_nreg == g_cap_reg) {
+        g_cap_reg = g_cap_reg ? g_cap_reg * 2 : 64;
+        g_reg = realloc(g_reg, sizeof(region_t) * g_cap_reg);
+    }
+    region_t *rg = &g_reg[g_nreg++];
+    rg->law = *law;
+    rg->area = area;
+    rg->nhp = 0;
+    // 只保留构成多边形边的半平面；参数域边界不存（设备端先钳位）
+    bool used[CON_MAX] = { false };
+    for (int i = 0; i < np; i++) {
+        pt_t p = poly[i], q = poly[(i + 1) % np];
+        int best = -1;
+        double best_res = VERT_EPS;
+        for (int k = 0; k < nhp; k++) {
+            double res = fmax(fabs(hp_eval(&hp[k], p)), fabs(hp_eval(&hp[k], q)));
+            if (res < best_res) { best_res = res; best = k; }
+        }
+        if (best >= 0 && !used[best]) {
+            used[best] = true;
+            rg->hp[rg->nhp++] = hp[best];
+        }
+    }
+}
+
+// 枚举大小 0..nu 的有效约束集（同一变量的上下限不同时有效）
+static void enumerate(int *act, int m, int start) {
+    visit(act, m);
+    if (m >= g_nu || m >= NU_MAX) return;
+    for (int k = start; k < g_ncon; k++) {
+        if (k < 2 * g_nu) {
+            bool clash = false;
+            for (int a = 0; a < m; a++) if (act[a] < 2 * g_nu && act[a] / 2 == k / 2) clash = true;
+            if (clash) continue;
+        }
+        act[m] = k;
+        enumerate(act, m + 1, k + 1);
+    }
+}
+
+static int cmp_area(const void *a, const void *b) {
+    double d = ((const region_t *)b)->area - ((const region_t *)a)->area;
+    return d > 0 ? 1 : (d < 0 ? -1 : 0);
+}
+
+// ===== 设备表（内存中，与生成文件内容相同） =====
+static mpc_halfplane_t *s_thp;
+static mpc_region_t *s_treg;
+static mpc_table_t s_tbl;
+
+static void build_table(void) {
+    int total = 0;
+    for (int i = 0; i < g_nreg; i++) total += g_reg[i].nhp;
+    s_thp = calloc((size_t)(total > 0 ? total : 1), sizeof(mpc_halfplane_t));
+    s_treg = calloc((size_t)(g_nreg > 0 ? g_nreg : 1), sizeof(mpc_region_t));
+    int k = 0;
+    for (int i = 0; i < g_nreg; i++) {
+        const region_t *rg = &g_reg[i];
+        s_treg[i] = (mpc_region_t){ (uint16_t)k, (uint16_t)rg->nhp,
+                                    (float)rg->law.Z[0][1], (float)rg->law.Z[0][2], (float)rg->law.Z[0][0] };
+        for (int h = 0; h < rg->nhp; h++) s_thp[k++] = (mpc_halfplane_t){ (float)rg->hp[h].ax, (float)rg->hp[h].ar, (float)rg->hp[h].b };
+    }
+    s_tbl = (mpc_table_t){
+        .gain = (float)g_gain, .tau_s = (float)g_tau, .dead_s = (float)g_dead, .ts_s = (float)g_ts,
+        .ambient = (float)g_ambient, .a = (float)g_a, .b = (float)g_b, .delay = (int)lround(g_dead / g_ts),
+        .out_min = (float)g_umin, .out_max = (float)g_umax, .overshoot = (float)g_over,
+        .x_lo = (float)g_xlo, .x_hi = (float)g_xhi, .r_lo = (float)g_rlo, .r_hi = (float)g_rhi,
+        .halfplanes = s_thp, .regions = s_treg, .n_regions = (uint16_t)g_nreg,
+    };
+}
+
+// 浮点字面量：%.9g 可逐位还原 float，整数值补 ".0" 使 f 后缀合法
+static const char *lit(float v) {
+    static char buf[8][32];
+    static int slot = 0;
+    char *b = buf[slot++ % 8];
+    snprintf(b, sizeof(buf[0]), "%.9g", v == 0.0f ? 0.0f : v);
+    if (!strpbrk(b, ".eni")) strcat(b, ".0");
+    strcat(b, "f");
+    return b;
+}
+
+static int write_table(const char *path, int argc, char **argv) {
+    FILE *f = fopen(path, "w");
+    if (!f) { perror(path); return -1; }
+    fprintf(f, "// 由 Tools/mpc/mpc_gen 生成，勿手工修改：mpc_gen");
+    for (int i = 1; i < argc; i++) fprintf(f, " %s", argv[i]);
+    fprintf(f, "\n// 模型 gain=%g °C/%% tau=%g s dead=%g s ts=%g s ambient=%g °C；输出 %g~%g %%，超调 <= %g °C\n",
+            g_gain, g_tau, g_dead, g_ts, g_ambient, g_umin, g_umax, g_over);
+    fprintf(f, "// 代价 q=%g rho=%g，预测 %d 步，分块", g_q, g_rho, g_n);
+    for (int j = 0; j < g_nu; j++) fprintf(f, " %d", g_blocks[j]);
+    fprintf(f, "；%d 个区域，%d 个半平面\n#include \"mpc_controller.h\"\n\n", g_nreg, (int)(s_treg[g_nreg - 1].first + s_treg[g_nreg - 1].count));
+    fprintf(f, "static const mpc_halfplane_t HALFPLANES[] = {\n");
+    for (int i = 0; i < g_nreg; i++) {
+        for (int h = 0; h < s_treg[i].count; h++) {
+            const mpc_halfplane_t *p = &s_thp[s_treg[i].first + h];
+            fprintf(f, "    { %s, %s, %s },\n", lit(p->ax), lit(p->ar), lit(p->b));
+        }
+    }
+    fprintf(f, "};\n\n// { first, count, kx, kr, k0 }：按区域面积降序，常用区域先匹配\nstatic const mpc_region_t REGIONS[] = {\n");
+    for (int i = 0; i < g_nreg; i++) {
+        const mpc_region_t *r = &s_treg[i];
+        fprintf(f, "    { %3u, %u, %s, %s, %s },\n", r->first, r->count, lit(r->kx), lit(r->kr), lit(r->k0));
+    }
+    fprintf(f, "};\n\nconst mpc_table_t MPC_TABLE = {\n");
+    fprintf(f, "    .gain = %s, .tau_s = %s, .dead_s = %s, .ts_s = %s, .ambient = %s,\n",
+            lit(s_tbl.gain), lit(s_tbl.tau_s), lit(s_tbl.dead_s), lit(s_tbl.ts_s), lit(s_tbl.ambient));
+    fprintf(f, "    .a = %s, .b = %s, .delay = %d,\n", lit(s_tbl.a), lit(s_tbl.b), s_tbl.delay);
+    fprintf(f, "    .out_min = %s, .out_max = %s, .overshoot = %s,\n", lit(s_tbl.out_min), lit(s_tbl.out_max), lit(s_tbl.overshoot));
+    fprintf(f, "    .x_lo = %s, .x_hi = %s, .r_lo = %s, .r_hi = %s,\n", lit(s_tbl.x_lo), lit(s_tbl.x_hi), lit(s_tbl.r_lo), lit(s_tbl.r_hi));
+    fprintf(f, "    .halfplanes = HALFPLANES,\n    .regions = REGIONS,\n    .n_regions = %d,\n};\n", g_nreg);
+    fclose(f);
+    return 0;
+}
+
+// ===== 校验：参数网格上逐点求解（所有可行候选中代价最小者即最优）并与查表对比 =====
+static double cost(const double *z, double x, double r) {
+    double J = 0;
+    for (int j = 0; j < g_nu; j++) {
+        J += z[j] * (g_Fx[j] * x + g_Fr[j] * r);
+        for (int k = 0; k < g_nu; k++) J += 0.5 * z[j] * g_H[j][k] * z[k];
+    }
+    return J;
+}
+
+static void verify_grid(int steps) {
+    double max_du = 0, sum_sq = 0;
+    int n = 0, infeasible = 0, worst_x = 0, worst_r = 0;
+    for (int ix = 0; ix <= steps; ix++) {
+        for (int ir = 0; ir <= steps; ir++) {
+            double x = g_xlo + (g_xhi - g_xlo) * ix / steps;
+            double r = g_rlo + (g_rhi - g_rlo) * ir / steps;
+            double best = INFINITY, u0 = 0;
+            for (int c = 0; c < g_ncand; c++) {
+                double z[NU_MAX];
+                for (int j = 0; j < g_nu; j++) z[j] = g_cand[c].Z[j][0] + g_cand[c].Z[j][1] * x + g_cand[c].Z[j][2] * r;
+                bool ok = true;
+                for (int k = 0; k < g_ncon && ok; k++) {
+                    double lhs = 0;
+                    for (int j = 0; j < g_nu; j++) lhs += g_con[k].g[j] * z[j];
+                    ok = lhs <= g_con[k].w + g_con[k].sx * x + g_con[k].sr * r + 1e-7;
+                }
+                if (!ok) continue;
+                double J = cost(z, x, r);
+                if (J < best) { best = J; u0 = z[0]; }
+            }
+            if (!isfinite(best)) { infeasible++; continue; }
+            double du = fabs(mpc_table_eval(&s_tbl, (float)x, (float)r, NULL) - u0);
+            sum_sq += du * du;
+            n++;
+            if (du > max_du) { max_du = du; worst_x = ix; worst_r = ir; }
+        }
+    }
+    printf("grid %dx%d: %d feasible, %d infeasible (table falls back to nearest region)\n",
+           steps + 1, steps + 1, n, infeasible);
+    printf("  table vs point-wise QP: max |du| = %.4g %% (x=%.1f r=%.1f), rms = %.3g %%\n", max_du,
+           g_xlo + (g_xhi - g_xlo) * worst_x / steps, g_rlo + (g_rhi - g_rlo) * worst_r / steps, n ? sqrt(sum_sq / n) : 0.0);
+}
+
+// ===== 闭环仿真：真实对象 FOPDT（可加增益失配），200 ms 控制周期，自环境温度阶跃到设定 =====
+typedef struct { double over, iae, settle_s, tv; } sim_kpi_t;
+
+static sim_kpi_t simulate(bool use_mpc, double sp, double mismatch, double dur_s, const float pid_gains[3], FILE *csv) {
+    const double dt = PID_NOMINAL_DT_MS / 1000.0;
+    const double a = exp(-dt / g_tau);
+    const int dsteps = (int)lround(g_dead / dt);
+    double *ubuf = calloc(dsteps + 1, sizeof(double));
+    double T = g_ambient, last_u = 0;
+    mpc_state_t mpc;
+    pid_bank_t pid;
+    mpc_reset(&mpc, &s_tbl, (float)T, 0.0f);
+    pid_bank_init(&pid, 0, pid_gains[0], pid_gains[1], pid_gains[2], (float)sp);
+    pid.last_input[0] = (float)T;
+    sim_kpi_t k = { -INFINITY, 0, 0, 0 };
+    int steps = (int)(dur_s / dt);
+    for (int i = 0; i < steps; i++) {
+        float in = (float)T, out;
+        if (use_mpc) out = mpc_step(&mpc, (int64_t)(i * dt * 1e6), in, (float)sp);
+        else pid_compute_bank(&pid, 1, &in, &out, 1.0f);
+        // 输入经纯滞后作用到对象
+        double u_eff = dsteps ? ubuf[i % dsteps] : out;
+        if (dsteps) ubuf[i % dsteps] = out;
+        double target = g_ambient + g_gain * mismatch * u_eff;
+        T = target + (T - target) * a;
+        double e = T - sp;
+        if (e > k.over) k.over = e;
+        k.iae += fabs(e) * dt;
+        if (fabs(e) > 0.5) k.settle_s = (i + 1) * dt;
+        if (i) k.tv += fabs(out - last_u);
+        last_u = out;
+        if (csv) fprintf(csv, "%s,%.1f,%.3f,%.2f\n", use_mpc ? "mpc" : "pid", i * dt, T, out);
+    }
+    free(ubuf);
+    return k;
+}
+
+static void usage(void) {
+    fprintf(stderr,
+            "usage: mpc_gen [-o table.c] [--verify] [--gain K] [--tau s] [--dead s] [--ts s] [--ambient C]\n"
+            "               [--umin %%] [--umax %%] [--overshoot C] [--q w] [--rho w] [--horizon N] [--blocks 1,4,55]\n"
+            "               [--sp C] [--mismatch k] [--sim-s s] [--pid kp,ki,kd] [--csv sim.csv]\n");
+}
+
+int main(int argc, char **argv) {
+    const char *out = NULL, *csv_path = NULL;
+    bool verify = false;
+    double sp = 100.0, mismatch = 1.0, sim_s = 900.0;
+    float pid_gains[3] = { 2.0f, 0.1f, 0.5f };   // main.c 温区 0 默认参数
+    for (int i = 1; i < argc; i++) {
+        const char *a = argv[i];
+        const char *v = i + 1 < argc ? argv[i + 1] : NULL;
+        if (!strcmp(a, "-o") && v) { out = v; i++; }
+        else if (!strcmp(a, "--verify")) verify = true;
+        else if (!strcmp(a, "--gain") && v) { g_gain = atof(v); i++; }
+        else if (!strcmp(a, "--tau") && v) { g_tau = atof(v); i++; }
+        else if (!strcmp(a, "--dead") && v) { g_dead = atof(v); i++; }
+        else if (!strcmp(a, "--ts") && v) { g_ts = atof(v); i++; }
+        else if (!strcmp(a, "--ambient") && v) { g_ambient = atof(v); i++; }
+        else if (!strcmp(a, "--umin") && v) { g_umin = atof(v); i++; }
+        else if (!strcmp(a, "--umax") && v) { g_umax = atof(v); i++; }
+        else if (!strcmp(a, "--overshoot") && v) { g_over = atof(v); i++; }
+        else if (!strcmp(a, "--q") && v) { g_q = atof(v); i++; }
+        else if (!strcmp(a, "--rho") && v) { g_rho = atof(v); i++; }
+        else if (!strcmp(a, "--horizon") && v) { g_n = atoi(v); i++; }
+        else if (!strcmp(a, "--blocks") && v) {
+            g_nu = 0;
+            for (const char *p = v; *p && g_nu < NU_MAX; p = strchr(p, ',') ? strchr(p, ',') + 1 : p + strlen(p)) {
+                g_blocks[g_nu++] = atoi(p);
+            }
+            i++;
+        }
+        else if (!strcmp(a, "--sp") && v) { sp = atof(v); i++; }
+        else if (!strcmp(a, "--mismatch") && v) { mismatch = atof(v); i++; }
+        else if (!strcmp(a, "--sim-s") && v) { sim_s = atof(v); i++; }
+        else if (!strcmp(a, "--pid") && v) { sscanf(v, "%f,%f,%f", &pid_gains[0], &pid_gains[1], &pid_gains[2]); i++; }
+        else if (!strcmp(a, "--csv") && v) { csv_path = v; i++; }
+        else { usage(); return 2; }
+    }
+    if (!out && !verify) { usage(); return 2; }
+    if (g_n < 1 || g_n > N_MAX || g_nu < 1 || g_tau <= 0 || g_ts <= 0 || g_gain <= 0 || g_umax <= g_umin) {
+        fprintf(stderr, "invalid model/horizon (horizon 1..%d, blocks 1..%d)\n", N_MAX, NU_MAX);
+        return 2;
+    }
+    if (lround(g_dead / g_ts) > MPC_MAX_DELAY) {
+        fprintf(stderr, "dead time %.1f s is %ld samples at ts=%.1f s, device buffer holds %d; raise --ts\n",
+                g_dead, lround(g_dead / g_ts), g_ts, MPC_MAX_DELAY);
+        return 2;
+    }
+
+    setup();
+    int act[NU_MAX + 1];
+    enumerate(act, 0, 0);
+    if (!g_nreg) { fprintf(stderr, "no full-dimensional region found\n"); return 1; }
+    qsort(g_reg, g_nreg, sizeof(region_t), cmp_area);
+    build_table();
+    int total_hp = s_treg[g_nreg - 1].first + s_treg[g_nreg - 1].count;
+    printf("%d constraints, %d candidate active sets, %d regions, %d halfplanes, table %zu bytes\n",
+           g_ncon, g_ncand, g_nreg, total_hp, g_nreg * sizeof(mpc_region_t) + total_hp * sizeof(mpc_halfplane_t));
+
+    if (verify) {
+        verify_grid(120);
+        FILE *csv = csv_path ? fopen(csv_path, "w") : NULL;
+        if (csv) fprintf(csv, "ctl,t_s,temp,output\n");
+        sim_kpi_t km = simulate(true, sp, mismatch, sim_s, pid_gains, csv);
+        sim_kpi_t kp = simulate(false, sp, mismatch, sim_s, pid_gains, csv);
+        if (csv) fclose(csv);
+        printf("closed loop %.0f -> %.0f C, plant gain x%.2f, %.0f s:\n", g_ambient, sp, mismatch, sim_s);
+        printf("  %-4s overshoot %6.2f C  settle(0.5C) %6.1f s  IAE %8.1f C*s  TV %7.1f %%\n", "mpc", km.over, km.settle_s, km.iae, km.tv);
+        printf("  %-4s overshoot %6.2f C  settle(0.5C) %6.1f s  IAE %8.1f C*s  TV %7.1f %%\n", "pid", kp.over, kp.settle_s, kp.iae, kp.tv);
+    }
+    if (out && write_table(out, argc, argv) != 0) return 1;
+    return 0;
+}
@@ -0,0 +1,198 @@
+// 固件上传（/api/ota 客户端）：按块 POST，断线后查询设备进度从断点续传，校验通过后可选切换重启
+//   ota_push build/esp32_smart_thermostat.bin                      # 默认 192.168.4.1:80
+//   ota_push fw.bin -H 192.168.4.1 -c 8192 --apply                 # 较小分块（弱信号时）
+#include <errno.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "sha256.h"
+
+#define RETRY_MAX      20       // 连续失败次数上限
+#define RESP_MAX       1024
+
+static const char *s_host = "192.168.4.1";
+static const char *s_port = "80";
+
+static int connect_host(void) {
+    struct addrinfo hints = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM }, *res;
+    if (getaddrinfo(s_host, s_port, &hints, &res) != 0) return -1;
+    int fd = -1;
+    for (struct addrinfo *a = res; a; a = a->ai_next) {
+        fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (fd < 0) continue;
+        struct timeval tv = { .tv_sec = 10 };
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+        if (connect(fd, a->ai_addr, a->ai_addrlen) == 0) break;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    return fd;
+}
+
+static int send_all(int fd, const void *p, size_t n) {
+    const char *c = p;
+    while (n) {
+        ssize_t w = send(fd, c, n, MSG_NOSIGNAL);
+        if (w <= 0) return -1;
+        c += w;
+        n -= (size_t)w;
+    }
+    return 0;
+}
+
+// 单次请求（Connection: close）；返回 HTTP 状态码，连接/协议错误返回 -1；body 写入 resp（以 0 结尾）
+static int http_request(const char *method, const char *path, const void *body, size_t len, char *resp, size_t resp_len) {
+    int fd = connect_host();
+    if (fd < 0) return -1;
+    char hdr[512];
+    int h = snprintf(hdr, sizeof(hdr),
+                     "%s %s HTTP/1.1\r\nHost: %s\r\nContent-Type: application/octet-stream\r\n"
+                     "Content-Length: %zu\r\nConnection: close\r\n\r\n", method, path, s_host, len);
+    if (send_all(fd, hdr, (size_t)h) != 0 || (len && send_all(fd, body, len) != 0)) {
+        close(fd);
+        return -1;
+    }
+    char buf[RESP_MAX + 512];
+    size_t got = 0;
+    for (;;) {
+        ssize_t r = recv(fd, buf + got, sizeof(buf) - 1 - got, 0);
+        if (r <= 0) break;
+        got += (size_t)r;
+        if (got == sizeof(buf) - 1) break;
+    }
+    close(fd);
+    buf[got] = 0;
+    int status;
+    if (sscanf(buf, "HTTP/1.%*d %d", &status) != 1) return -1;
+    const char *b = strstr(buf, "\r\n\r\n");
+    snprintf(resp, resp_len, "%s", b ? b + 4 : "");
+    return status;
+}
+
+static long json_long(const char *json, const char *key) {
+    char pat[32];
+    snprintf(pat, sizeof(pat), "\"%s\":", key);
+    const char *p = strstr(json, pat);
+    return p ? strtol(p + strlen(pat), NULL, 10) : -1;
+}
+
+static int json_str(const char *json, const char *key, char *out, size_t len) {
+    char pat[32];
+    snprintf(pat, sizeof(pat), "\"%s\":\"", key);
+    const char *p = strstr(json, pat);
+    if (!p) return -1;
+    p += strlen(pat);
+    size_t n = strcspn(p, "\"");
+    if (n >= len) n = len - 1;
+    memcpy(out, p, n);
+    out[n] = 0;
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    static char host_buf[256];
+    size_t chunk = 16384;           // 设备端单个请求体上限 (WEB_ASYNC_BODY_MAX)
+    int apply = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-H") == 0 && i + 1 < argc) {
+            snprintf(host_buf, sizeof(host_buf), "%s", argv[++i]);
+            char *colon = strrchr(host_buf, ':');
+            if (colon) { *colon = 0; s_port = colon + 1; }
+            s_host = host_buf;
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            chunk = strtoul(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--apply") == 0) {
+            apply = 1;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (!path || chunk == 0) {
+        fprintf(stderr, "usage: %s <image.bin> [-H host[:port]] [-c chunk_bytes] [--apply]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (!f) { perror(path); return 1; }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *img = malloc(size > 0 ? (size_t)size : 1);
+    if (!img || fread(img, 1, (size_t)size, f) != (size_t)size) { fprintf(stderr, "read failed\n"); return 1; }
+    fclose(f);
+    sha256_ctx_t ctx;
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    char hex[SHA256_DIGEST_SIZE * 2 + 1];
+    sha256_init(&ctx);
+    sha256_update(&ctx, img, (size_t)size);
+    sha256_final(&ctx, digest);
+    sha256_to_hex(digest, hex);
+    printf("%s: %ld B sha256=%s\n", path, size, hex);
+
+    // 设备上已有同一镜像的未完成会话则从其进度续传
+    char resp[RESP_MAX], state[16] = "", dev_sha[72] = "";
+    long offset = 0;
+    if (http_request("GET", "/api/ota", NULL, 0, resp, sizeof(resp)) == 200 &&
+        json_str(resp, "state", state, sizeof(state)) == 0 && strcmp(state, "receiving") == 0 &&
+        json_long(resp, "size") == size && json_str(resp, "sha256", dev_sha, sizeof(dev_sha)) == 0 &&
+        strcmp(dev_sha, hex) == 0) {
+        offset = json_long(resp, "offset");
+        printf("resuming at %ld\n", offset);
+    }
+
+    int failures = 0;
+    while (offset < size) {
+        size_t n = (size_t)(size - offset) < chunk ? (size_t)(size - offset) : chunk;
+        char url[256];
+        if (offset == 0) snprintf(url, sizeof(url), "/api/ota?offset=0&size=%ld&sha256=%s", size, hex);
+        else snprintf(url, sizeof(url), "/api/ota?offset=%ld", offset);
+        int st = http_request("POST", url, img + offset, n, resp, sizeof(resp));
+        if (st == 200 || st == 409) {
+            // 409：偏移不一致，以设备记录为准；会话已失效（idle/failed）则从头开始
+            json_str(resp, "state", state, sizeof(state));
+            long dev = json_long(resp, "offset");
+            offset = strcmp(state, "receiving") == 0 || strcmp(state, "ready") == 0 ? dev : 0;
+            if (st == 200) failures = 0;
+            else if (++failures > RETRY_MAX) break;
+            printf("\r%ld / %ld (%.0f%%)", offset, size, 100.0 * offset / size);
+            fflush(stdout);
+            continue;
+        }
+        if (st == 503) {
+            // 设备工作队列满：按 Retry-After 稍后重发同一块
+            if (++failures > RETRY_MAX) break;
+            sleep(1);
+            continue;
+        }
+        if (st > 0) {
+            printf("\nrejected (%d): %s\n", st, resp);
+            return 1;
+        }
+        // 连接中断：稍后查询进度续传
+        if (++failures > RETRY_MAX) break;
+        fprintf(stderr, "\nconnection lost at %ld, retrying (%d/%d)\n", offset, failures, RETRY_MAX);
+        sleep(1);
+        if (http_request("GET", "/api/ota", NULL, 0, resp, sizeof(resp)) == 200 &&
+            json_str(resp, "state", state, sizeof(state)) == 0) {
+            offset = strcmp(state, "receiving") == 0 ? json_long(resp, "offset") : 0;
+        }
+    }
+    printf("\n");
+    if (offset < size || strcmp(state, "ready") != 0) {
+        fprintf(stderr, "upload failed: %s\n", resp);
+        return 1;
+    }
+    printf("verified: %s\n", resp);
+    if (apply) {
+        int st = http_request("POST", "/api/ota/apply", NULL, 0, resp, sizeof(resp));
+        printf("apply (%d): %s\n", st, resp);
+        return st == 200 ? 0 : 1;
+    }
+    return 0;
+}
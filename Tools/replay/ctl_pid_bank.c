@@ -0,0 +1,46 @@
+// 控制器插件：包装当前源码树的 pid_compute_bank（编译为 pid_ctl.so，供 pid_replay 加载）
+// 符号默认隐藏，只导出 ctl_plugin_get，多个版本同时加载时互不干扰
+#include <stdlib.h>
+#include "ctl_plugin.h"
+#include "pid_controller.h"
+#include "esp_log.h"
+
+// pid_controller.c 日志桩（插件内不输出）
+void stub_log_format(const char *tag, const char *fmt, ...) { (void)tag; (void)fmt; }
+
+static void *ctl_create(void) {
+    pid_bank_t *bank = calloc(1, sizeof(*bank));
+    if (!bank) return NULL;
+    for (int i = 0; i < PID_BANK_MAX; i++) pid_bank_init(bank, i, 0.0f, 0.0f, 0.0f, 0.0f);
+    return bank;
+}
+
+static void ctl_destroy(void *ctl) { free(ctl); }
+
+static void ctl_set_state(void *ctl, int zone, const ctl_state_t *st) {
+    pid_bank_t *bank = ctl;
+    if (zone < 0 || zone >= PID_BANK_MAX) return;
+    bank->Kp[zone] = st->kp;
+    bank->Ki[zone] = st->ki;
+    bank->Kd[zone] = st->kd;
+    bank->setpoint[zone] = st->setpoint;
+    bank->out_min[zone] = st->out_min;
+    bank->out_max[zone] = st->out_max;
+    bank->integral[zone] = st->integral;
+    bank->last_input[zone] = st->last_input;
+}
+
+static void ctl_step(void *ctl, uint32_t mask, const float *input, float *output, float dt_ratio) {
+    pid_compute_bank(ctl, mask & ((1u << PID_BANK_MAX) - 1), input, output, dt_ratio);
+}
+
+static const ctl_plugin_t PLUGIN = {
+    .abi = CTL_PLUGIN_ABI,
+    .max_zones = PID_BANK_MAX,
+    .create = ctl_create,
+    .destroy = ctl_destroy,
+    .set_state = ctl_set_state,
+    .step = ctl_step,
+};
+
+__attribute__((visibility("default"))) const ctl_plugin_t *ctl_plugin_get(void) { return &PLUGIN; }
@@ -0,0 +1,31 @@
+#ifndef CTL_PLUGIN_H
+#define CTL_PLUGIN_H
+
+#include <stdint.h>
+
+// 回放用控制器插件接口：每个固件版本把自己的控制算法编译成一个 .so（Tools/ 下 pid_ctl 目标），
+// pid_replay 以 dlopen 同时加载多个版本，按同一捕获输入逐周期对比。接口只用基本类型，
+// 与各版本 pid_bank_t 的内存布局无关；不兼容修改时递增 CTL_PLUGIN_ABI
+#define CTL_PLUGIN_ABI    1
+#define CTL_PLUGIN_SYMBOL "ctl_plugin_get"
+
+// 与捕获帧 telem_cap_state_t 对应的单温区状态
+typedef struct {
+    float kp, ki, kd, setpoint;
+    float out_min, out_max;
+    float integral, last_input;
+} ctl_state_t;
+
+typedef struct {
+    int abi;                // CTL_PLUGIN_ABI
+    int max_zones;          // 支持的温区数（超出的位在回放端忽略）
+    void *(*create)(void);
+    void (*destroy)(void *ctl);
+    void (*set_state)(void *ctl, int zone, const ctl_state_t *st);
+    // 与 pid_compute_bank 语义相同：对 mask 中的温区计算，input/output 按温区编号索引
+    void (*step)(void *ctl, uint32_t mask, const float *input, float *output, float dt_ratio);
+} ctl_plugin_t;
+
+typedef const ctl_plugin_t *(*ctl_plugin_get_fn)(void);
+
+#endif
@@ -0,0 +1,247 @@
+// 控制输入捕获离线回放：把 /api/capture 录下的输入流（telemetry_rx --raw）逐周期喂给一个或多个控制器版本，
+// 与固件记录的输出及彼此对比，并统计 KPI
+//   pid_replay cap.bin                                   # 默认加载本目录下的 pid_ctl.so（当前源码树）
+//   pid_replay cap1.bin cap2.bin --ctl build_host/pid_ctl.so --ctl /tmp/other/pid_ctl.so --csv out.csv
+// 其它版本的插件：在该版本源码树下 cmake -S Tools -B <dir> && cmake --build <dir> --target pid_ctl
+#include <dlfcn.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "telemetry_frame.h"
+#include "pid_controller.h"
+#include "ctl_plugin.h"
+
+#define MAX_CTLS (8)
+#define MAX_COLS (MAX_CTLS + 1)          // 第 0 列为固件记录的输出
+
+typedef struct {
+    const char *path;
+    const ctl_plugin_t *api;
+    void *inst;
+} ctl_t;
+
+// 每列（记录值/各插件）每个温区的输出统计
+typedef struct {
+    uint64_t n;                 // 参与比较的周期数
+    double max_diff;            // 与记录输出的最大偏差
+    double sum_sq_diff;
+    double first_div_s;         // 首次偏差超过容差的时刻（<0 表示无）
+    double sum_u;
+    double tv;                  // 输出总变差（执行器动作量）
+    uint64_t sat;               // 输出处于上/下限的周期数
+    float last_u;
+    bool has_last;
+} out_stats_t;
+
+// 每个温区的输入侧 KPI（所有列共用同一输入，与控制器无关）
+typedef struct {
+    uint64_t ticks;
+    double time_s;
+    double iae;                 // ∫|SP - T| dt (°C·s)
+    double max_over;            // max(T - SP) (°C)
+    float setpoint, out_min, out_max;
+    bool synced;                // 已收到该温区状态帧且之后无丢帧
+} zone_kpi_t;
+
+static ctl_t s_ctl[MAX_CTLS];
+static int s_nctl = 0;
+static double s_tol = 1e-4;
+static FILE *s_csv = NULL;
+
+static int load_ctl(const char *path) {
+    if (s_nctl >= MAX_CTLS) { fprintf(stderr, "too many --ctl (max %d)\n", MAX_CTLS); return -1; }
+    void *h = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!h) { fprintf(stderr, "%s\n", dlerror()); return -1; }
+    ctl_plugin_get_fn get = (ctl_plugin_get_fn)dlsym(h, CTL_PLUGIN_SYMBOL);
+    const ctl_plugin_t *api = get ? get() : NULL;
+    if (!api || api->abi != CTL_PLUGIN_ABI) {
+        fprintf(stderr, "%s: missing %s or ABI mismatch\n", path, CTL_PLUGIN_SYMBOL);
+        return -1;
+    }
+    s_ctl[s_nctl].path = path;
+    s_ctl[s_nctl].api = api;
+    s_nctl++;
+    return 0;
+}
+
+static unsigned char *read_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) { perror(path); return NULL; }
+    fseek(f, 0, SEEK_END);
+    long n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    unsigned char *buf = malloc(n > 0 ? (size_t)n : 1);
+    if (!buf || fread(buf, 1, (size_t)n, f) != (size_t)n) { perror(path); fclose(f); free(buf); return NULL; }
+    fclose(f);
+    *len = (size_t)n;
+    return buf;
+}
+
+static void stats_add(out_stats_t *s, float u, float rec, const zone_kpi_t *k, double t_s) {
+    double d = fabs((double)u - (double)rec);
+    s->n++;
+    if (d > s->max_diff) s->max_diff = d;
+    s->sum_sq_diff += d * d;
+    if (d > s_tol && s->first_div_s < 0) s->first_div_s = t_s;
+    s->sum_u += u;
+    if (s->has_last) s->tv += fabs((double)u - (double)s->last_u);
+    s->last_u = u;
+    s->has_last = true;
+    if (u <= k->out_min || u >= k->out_max) s->sat++;
+}
+
+static int replay_file(const char *path) {
+    size_t len;
+    unsigned char *data = read_file(path, &len);
+    if (!data) return -1;
+
+    static out_stats_t st[MAX_COLS][TELEM_MAX_ZONES];
+    static zone_kpi_t kpi[TELEM_MAX_ZONES];
+    memset(st, 0, sizeof(st));
+    memset(kpi, 0, sizeof(kpi));
+    for (int c = 0; c < MAX_COLS; c++)
+        for (int z = 0; z < TELEM_MAX_ZONES; z++) st[c][z].first_div_s = -1;
+    for (int i = 0; i < s_nctl; i++) s_ctl[i].inst = s_ctl[i].api->create();
+
+    long ticks = 0, states = 0, other = 0, bad = 0, gaps = 0, unsynced = 0;
+    int last_seq = -1;
+    double t_s = 0;
+    uint8_t pkt[TELEM_MAX_PACKET];
+    size_t start = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] != 0) continue;
+        size_t fl = i - start;
+        const unsigned char *frame = data + start;
+        start = i + 1;
+        if (fl == 0) continue;
+        size_t pl = telem_frame_decode(frame, fl, pkt, sizeof(pkt));
+        if (pl < 1) { bad++; continue; }
+        if (pkt[0] != TELEM_TYPE_CAP_TICK && pkt[0] != TELEM_TYPE_CAP_STATE) { other++; continue; }
+
+        // 两类捕获帧共用 seq：出现缺口后各温区的积分等状态不再可信，直到收到新的状态帧
+        uint16_t seq = (uint16_t)(pkt[2] | (pkt[3] << 8));
+        if (last_seq >= 0 && seq != (uint16_t)(last_seq + 1)) {
+            gaps++;
+            for (int z = 0; z < TELEM_MAX_ZONES; z++) kpi[z].synced = false;
+        }
+        last_seq = seq;
+
+        if (pkt[0] == TELEM_TYPE_CAP_STATE) {
+            telem_cap_state_t cs;
+            if (pl < sizeof(cs)) { bad++; continue; }
+            memcpy(&cs, pkt, sizeof(cs));
+            if (cs.zone >= TELEM_MAX_ZONES) { bad++; continue; }
+            ctl_state_t s = {
+                .kp = cs.kp, .ki = cs.ki, .kd = cs.kd, .setpoint = cs.setpoint,
+                .out_min = cs.out_min, .out_max = cs.out_max,
+                .integral = cs.integral, .last_input = cs.last_input,
+            };
+            for (int c = 0; c < s_nctl; c++) s_ctl[c].api->set_state(s_ctl[c].inst, cs.zone, &s);
+            kpi[cs.zone].setpoint = cs.setpoint;
+            kpi[cs.zone].out_min = cs.out_min;
+            kpi[cs.zone].out_max = cs.out_max;
+            kpi[cs.zone].synced = true;
+            states++;
+            continue;
+        }
+
+        telem_cap_tick_t hdr;
+        memcpy(&hdr, pkt, sizeof(hdr));
+        int nz = __builtin_popcount(hdr.mask);
+        if (pl < sizeof(hdr) + (size_t)nz * sizeof(telem_cap_zone_t)) { bad++; continue; }
+        float in[TELEM_MAX_ZONES] = {0}, rec[TELEM_MAX_ZONES] = {0};
+        const uint8_t *p = pkt + sizeof(hdr);
+        for (uint32_t m = hdr.mask; m; m &= m - 1) {
+            telem_cap_zone_t zs;
+            memcpy(&zs, p, sizeof(zs));
+            p += sizeof(zs);
+            int z = __builtin_ctz(m);
+            in[z] = zs.temp;
+            rec[z] = zs.output;
+        }
+        float out[MAX_CTLS][TELEM_MAX_ZONES];
+        for (int c = 0; c < s_nctl; c++) {
+            uint32_t mask = hdr.mask & ((1u << s_ctl[c].api->max_zones) - 1);
+            memcpy(out[c], rec, sizeof(rec));
+            s_ctl[c].api->step(s_ctl[c].inst, mask, in, out[c], hdr.dt_ratio);
+        }
+
+        double dt = hdr.dt_ratio * (PID_NOMINAL_DT_MS / 1000.0);
+        t_s += dt;
+        ticks++;
+        for (uint32_t m = hdr.mask; m; m &= m - 1) {
+            int z = __builtin_ctz(m);
+            zone_kpi_t *k = &kpi[z];
+            if (!k->synced) { unsynced++; continue; }
+            double e = (double)k->setpoint - in[z];
+            k->ticks++;
+            k->time_s += dt;
+            k->iae += fabs(e) * dt;
+            if (-e > k->max_over) k->max_over = -e;
+            stats_add(&st[0][z], rec[z], rec[z], k, t_s);
+            for (int c = 0; c < s_nctl; c++) stats_add(&st[c + 1][z], out[c][z], rec[z], k, t_s);
+            if (s_csv) {
+                fprintf(s_csv, "%s,%.3f,%d,%.4f,%.3f,%.4f", path, t_s, z, in[z], k->setpoint, rec[z]);
+                for (int c = 0; c < s_nctl; c++) fprintf(s_csv, ",%.4f", out[c][z]);
+                fputc('\n', s_csv);
+            }
+        }
+    }
+    for (int i = 0; i < s_nctl; i++) s_ctl[i].api->destroy(s_ctl[i].inst);
+    free(data);
+
+    printf("%s: %ld ticks, %.1f s, %ld state frames, %ld other frames, %ld crc/format errors, %ld seq gaps, %ld zone-ticks skipped (unsynced)\n",
+           path, ticks, t_s, states, other, bad, gaps, unsynced);
+    for (int z = 0; z < TELEM_MAX_ZONES; z++) {
+        const zone_kpi_t *k = &kpi[z];
+        if (!k->ticks) continue;
+        printf("  zone %d: %llu ticks, %.1f s, IAE %.1f C*s, mean |e| %.3f C, max T-SP %.2f C\n", z,
+               (unsigned long long)k->ticks, k->time_s, k->iae, k->iae / k->time_s, k->max_over);
+        printf("    %-32s %10s %10s %12s %8s %6s %10s\n", "controller", "max|du|", "rms du", "first div s", "mean u", "sat%", "TV");
+        for (int c = 0; c <= s_nctl; c++) {
+            const out_stats_t *s = &st[c][z];
+            if (!s->n) continue;
+            char div[16] = "-";
+            if (s->first_div_s >= 0) snprintf(div, sizeof(div), "%.1f", s->first_div_s);
+            printf("    %-32s %10.4g %10.4g %12s %8.2f %6.1f %10.1f\n", c ? s_ctl[c - 1].path : "(recorded)",
+                   s->max_diff, sqrt(s->sum_sq_diff / s->n), div, s->sum_u / s->n, 100.0 * s->sat / s->n, s->tv);
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *files[64];
+    int nfiles = 0;
+    const char *csv_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ctl") == 0 && i + 1 < argc) { if (load_ctl(argv[++i]) != 0) return 1; }
+        else if (strcmp(argv[i], "--tol") == 0 && i + 1 < argc) s_tol = atof(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csv_path = argv[++i];
+        else if (nfiles < (int)(sizeof(files) / sizeof(files[0]))) files[nfiles++] = argv[i];
+    }
+    if (!nfiles) {
+        fprintf(stderr, "usage: %s <capture.bin>... [--ctl plugin.so]... [--tol 1e-4] [--csv out.csv]\n", argv[0]);
+        return 2;
+    }
+    // 未指定插件时加载与本程序同目录的 pid_ctl.so
+    static char def[4096];
+    if (!s_nctl) {
+        const char *slash = strrchr(argv[0], '/');
+        snprintf(def, sizeof(def), "%.*spid_ctl.so", slash ? (int)(slash - argv[0] + 1) : 2, slash ? argv[0] : "./");
+        if (load_ctl(def) != 0) return 1;
+    }
+    if (csv_path) {
+        s_csv = fopen(csv_path, "w");
+        if (!s_csv) { perror(csv_path); return 1; }
+        fprintf(s_csv, "file,t_s,zone,temp_c,setpoint_c,recorded");
+        for (int c = 0; c < s_nctl; c++) fprintf(s_csv, ",ctl%d", c + 1);
+        fputc('\n', s_csv);
+    }
+    int rc = 0;
+    for (int i = 0; i < nfiles; i++) rc |= replay_file(files[i]) != 0;
+    if (s_csv) fclose(s_csv);
+    return rc;
+}
@@ -0,0 +1,25 @@
+#ifndef STUB_ESP_ERR_H
+#define STUB_ESP_ERR_H
+
+// 主机端桩：仅提供固件源码编译所需的最小 ESP-IDF 声明
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK                 0
+#define ESP_FAIL              -1
+#define ESP_ERR_NO_MEM         0x101
+#define ESP_ERR_INVALID_ARG    0x102
+#define ESP_ERR_INVALID_STATE  0x103
+#define ESP_ERR_INVALID_SIZE   0x104
+#define ESP_ERR_NOT_FOUND      0x105
+#define ESP_ERR_NOT_SUPPORTED  0x106
+#define ESP_ERR_TIMEOUT        0x107
+#define ESP_ERR_INVALID_CRC    0x109
+
+#define ESP_ERROR_CHECK(x) do { esp_err_t err_rc_ = (x); (void)err_rc_; } while (0)
+
+#endif
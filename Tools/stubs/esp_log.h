@@ -0,0 +1,16 @@
+#ifndef STUB_ESP_LOG_H
+#define STUB_ESP_LOG_H
+
+#include "esp_err.h"
+
+// 日志桩：I/W/E 级别照常格式化到内部缓冲区（保留 newlib 格式化开销，但不产生 I/O），
+// D/V 级别与固件默认最大日志级别一致，编译期剔除
+void stub_log_format(const char *tag, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+#define ESP_LOGE(tag, fmt, ...) stub_log_format(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) stub_log_format(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) stub_log_format(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) do { (void)(tag); } while (0)
+#define ESP_LOGV(tag, fmt, ...) do { (void)(tag); } while (0)
+
+#endif
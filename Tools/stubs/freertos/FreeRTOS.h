@@ -0,0 +1,24 @@
+#ifndef STUB_FREERTOS_H
+#define STUB_FREERTOS_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ 100
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)((ms) / portTICK_PERIOD_MS))
+#define portMAX_DELAY      0xFFFFFFFFu
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+
+typedef struct { int unused; } portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED { 0 }
+#define portENTER_CRITICAL(mux) (void)(mux)
+#define portEXIT_CRITICAL(mux)  (void)(mux)
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef STUB_FREERTOS_SEMPHR_H
+#define STUB_FREERTOS_SEMPHR_H
+
+#include "freertos/FreeRTOS.h"
+
+// 主机工具单线程运行：互斥量为空操作（创建返回 NULL，调用方按未创建处理）
+typedef void *SemaphoreHandle_t;
+#define xSemaphoreCreateRecursiveMutex()       ((SemaphoreHandle_t)0)
+static inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticks) { (void)sem; (void)ticks; return pdTRUE; }
+static inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem) { (void)sem; return pdTRUE; }
+
+#endif
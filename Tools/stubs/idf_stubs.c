@@ -0,0 +1,38 @@
+// 主机端 ESP-IDF 桩实现（日志与 FreeRTOS）；外设由 Hardware/hal_sim.c 仿真
+#include <stdarg.h>
+#include <stdio.h>
+#include <time.h>
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// ===== 日志 =====
+void stub_log_format(const char *tag, const char *fmt, ...) {
+    static char line[256];
+    (void)tag;
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+}
+
+// ===== FreeRTOS =====
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack, void *arg, UBaseType_t prio, TaskHandle_t *out) {
+    (void)fn; (void)name; (void)stack; (void)arg; (void)prio;
+    if (out) *out = NULL;
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) { (void)task; }
+
+void vTaskDelay(TickType_t ticks) { (void)ticks; }
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) { (void)clear; (void)ticks; return 0; }
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) { (void)task; return pdPASS; }
+
+TickType_t xTaskGetTickCount(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)((ts.tv_sec * 1000 + ts.tv_nsec / 1000000) / portTICK_PERIOD_MS);
+}
@@ -0,0 +1,127 @@
+// UART 遥测接收/记录：读取串口（或 pty / 文件），按 0x00 分帧、COBS 解码、CRC 校验，输出 CSV
+//   telemetry_rx /dev/ttyUSB0 -b 921600 -o rec.csv
+//   telemetry_rx /dev/ttyUSB0 -b 921600 --raw cap.bin   # 同时原样保存字节流（控制输入捕获，Tools/replay 回放）
+//   socat -d -d pty,raw,echo=0 pty,raw,echo=0   # 得到两个 pty，一端给 HAL_SIM_UART_PATH，一端给本工具
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include "telemetry_frame.h"
+
+static volatile sig_atomic_t s_stop = 0;
+static void on_sigint(int sig) { (void)sig; s_stop = 1; }
+
+static speed_t baud_const(int baud) {
+    switch (baud) {
+    case 115200:  return B115200;
+    case 230400:  return B230400;
+    case 460800:  return B460800;
+    case 921600:  return B921600;
+    case 1000000: return B1000000;
+    case 1500000: return B1500000;
+    case 2000000: return B2000000;
+    case 3000000: return B3000000;
+    case 4000000: return B4000000;
+    default:      return 0;
+    }
+}
+
+// 串口设为 raw 模式；pty/普通文件跳过
+static int setup_tty(int fd, int baud) {
+    if (!isatty(fd)) return 0;
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) return -1;
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    speed_t sp = baud_const(baud);
+    if (sp) {
+        cfsetispeed(&tio, sp);
+        cfsetospeed(&tio, sp);
+    } else {
+        fprintf(stderr, "warning: unsupported baud %d, keeping current setting\n", baud);
+    }
+    return tcsetattr(fd, TCSANOW, &tio);
+}
+
+int main(int argc, char **argv) {
+    const char *dev = NULL, *out_path = NULL, *raw_path = NULL;
+    int baud = 921600;
+    long max_frames = -1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) baud = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) max_frames = atol(argv[++i]);
+        else if (strcmp(argv[i], "--raw") == 0 && i + 1 < argc) raw_path = argv[++i];
+        else dev = argv[i];
+    }
+    if (!dev) {
+        fprintf(stderr, "usage: %s <tty|pty|file|-> [-b baud] [-o out.csv] [--raw out.bin] [-n frames]\n", argv[0]);
+        return 2;
+    }
+    int fd = strcmp(dev, "-") == 0 ? STDIN_FILENO : open(dev, O_RDONLY | O_NOCTTY);
+    if (fd < 0) { perror(dev); return 1; }
+    if (setup_tty(fd, baud) != 0) { perror("tcsetattr"); return 1; }
+    FILE *out = out_path ? fopen(out_path, "w") : stdout;
+    if (!out) { perror(out_path); return 1; }
+    FILE *raw = raw_path ? fopen(raw_path, "wb") : NULL;
+    if (raw_path && !raw) { perror(raw_path); return 1; }
+    signal(SIGINT, on_sigint);
+
+    fprintf(out, "ts_us,seq,zone,adc_raw,temp_c,output_pct,running,sensor_fault\n");
+    uint8_t rx[4096], frame[TELEM_MAX_FRAME], pkt[TELEM_MAX_PACKET];
+    size_t flen = 0;
+    long frames = 0, cap_frames = 0, bad = 0, lost = 0;
+    int last_seq = -1;
+    while (!s_stop && (max_frames < 0 || frames < max_frames)) {
+        ssize_t n = read(fd, rx, sizeof(rx));
+        if (n == 0) break;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("read");
+            break;
+        }
+        if (raw) fwrite(rx, 1, (size_t)n, raw);
+        for (ssize_t i = 0; i < n; i++) {
+            uint8_t b = rx[i];
+            if (b != 0) {
+                if (flen < sizeof(frame)) frame[flen] = b;
+                flen++;
+                continue;
+            }
+            size_t fl = flen;
+            flen = 0;
+            if (fl == 0) continue;      // 连续分隔符
+            // 中途接入时首帧可能不完整，CRC 校验失败计入 errors
+            size_t pl = fl <= sizeof(frame) ? telem_frame_decode(frame, fl, pkt, sizeof(pkt)) : 0;
+            if (pl < sizeof(telem_hdr_t)) { bad++; continue; }
+            telem_hdr_t hdr;
+            memcpy(&hdr, pkt, sizeof(hdr));
+            // 捕获帧只随原始流保存，由回放工具解析
+            if (hdr.type == TELEM_TYPE_CAP_TICK || hdr.type == TELEM_TYPE_CAP_STATE) { cap_frames++; continue; }
+            if (hdr.type != TELEM_TYPE_SAMPLE || pl < sizeof(hdr) + hdr.nzones * sizeof(telem_zone_t)) { bad++; continue; }
+            if (last_seq >= 0) lost += (uint16_t)(hdr.seq - last_seq - 1);
+            last_seq = hdr.seq;
+            frames++;
+            for (int z = 0; z < hdr.nzones; z++) {
+                telem_zone_t zs;
+                memcpy(&zs, pkt + sizeof(hdr) + z * sizeof(zs), sizeof(zs));
+                // 传感器故障时温度列留空
+                bool fault = zs.flags & TELEM_ZONE_SENSOR_FAULT;
+                char temp[16] = "";
+                if (!fault) snprintf(temp, sizeof(temp), "%.1f", zs.temp_c10 / 10.0);
+                fprintf(out, "%u,%u,%d,%u,%s,%.2f,%d,%d\n", (unsigned)hdr.ts_us, (unsigned)hdr.seq, z,
+                        (unsigned)zs.adc_raw, temp, zs.output_c100 / 100.0, (zs.flags & TELEM_ZONE_RUNNING) != 0, fault);
+            }
+        }
+    }
+    if (out != stdout) fclose(out);
+    if (raw) fclose(raw);
+    fprintf(stderr, "frames=%ld capture frames=%ld crc/format errors=%ld seq gaps=%ld\n", frames, cap_frames, bad, lost);
+    return 0;
+}
@@ -0,0 +1,87 @@
+// 显式 MPC 区域查找：手写三区域表（命中、边界、钳位、缝隙取最近区域），以及生成表 MPC_TABLE 的稳态与限幅
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "mpc_controller.h"
+
+#define NEAR(a, b, tol) (fabsf((a) - (b)) <= (tol))
+
+// 以误差 e = r - x 划分：e >= 10 满输出，|e| <= 10 比例段 u = 5e + 50，e <= -10 关断
+static const mpc_halfplane_t HP[] = {
+    { 1.0f, -1.0f, -10.0f },                            // R0: x - r <= -10
+    { -1.0f, 1.0f, 10.0f }, { 1.0f, -1.0f, 10.0f },     // R1: |r - x| <= 10
+    { -1.0f, 1.0f, -10.0f },                            // R2: r - x <= -10
+};
+static const mpc_region_t RG[] = {
+    { 0, 1, 0.0f, 0.0f, 100.0f },
+    { 1, 2, -5.0f, 5.0f, 50.0f },
+    { 3, 1, 0.0f, 0.0f, 0.0f },
+};
+static const mpc_table_t TBL = {
+    .out_min = 0.0f, .out_max = 80.0f,
+    .x_lo = 0.0f, .x_hi = 100.0f, .r_lo = 0.0f, .r_hi = 100.0f,
+    .halfplanes = HP, .regions = RG, .n_regions = 3,
+};
+// 去掉比例段：|e| < 10 落在缝隙中
+static const mpc_region_t RG_GAP[] = {
+    { 0, 1, 0.0f, 0.0f, 100.0f },
+    { 3, 1, 0.0f, 0.0f, 0.0f },
+};
+
+static void test_lookup(void) {
+    int rg;
+    assert(mpc_table_eval(&TBL, 0.0f, 50.0f, &rg) == 80.0f && rg == 0);     // 满输出后按 out_max 限幅
+    assert(mpc_table_eval(&TBL, 50.0f, 50.0f, &rg) == 50.0f && rg == 1);
+    assert(mpc_table_eval(&TBL, 50.0f, 52.0f, &rg) == 60.0f && rg == 1);
+    assert(mpc_table_eval(&TBL, 50.0f, 58.0f, &rg) == 80.0f && rg == 1);    // 仿射结果同样限幅
+    assert(mpc_table_eval(&TBL, 80.0f, 20.0f, &rg) == 0.0f && rg == 2);
+    // 边界（含容差）归首个匹配区域
+    assert(mpc_table_eval(&TBL, 40.0f, 50.0f, &rg) == 80.0f && rg == 0);
+    assert(mpc_table_eval(&TBL, 40.0005f, 50.0f, &rg) == 80.0f && rg == 0);
+    assert(mpc_table_eval(&TBL, 40.01f, 50.0f, &rg) == 80.0f && rg == 1);
+    // 参数先钳位到域内：x = -20 按 0，r = 130 按 100
+    assert(mpc_table_eval(&TBL, -20.0f, 0.0f, &rg) == 50.0f && rg == 1);
+    assert(mpc_table_eval(&TBL, 95.0f, 130.0f, &rg) == 75.0f && rg == 1);
+    // region 可为 NULL
+    assert(mpc_table_eval(&TBL, 50.0f, 50.0f, NULL) == 50.0f);
+}
+
+static void test_gap(void) {
+    mpc_table_t t = TBL;
+    t.regions = RG_GAP;
+    t.n_regions = 2;
+    int rg;
+    // 缝隙中取越界最小的区域
+    assert(mpc_table_eval(&t, 50.0f, 53.0f, &rg) == 80.0f && rg == 0);
+    assert(mpc_table_eval(&t, 50.0f, 47.0f, &rg) == 0.0f && rg == 1);
+    // 空表：输出下限，区域 -1
+    t.n_regions = 0;
+    assert(mpc_table_eval(&t, 50.0f, 50.0f, &rg) == t.out_min && rg == -1);
+}
+
+// 生成表：设定处稳态输出 = r / K；远低于设定满输出、远高于设定关断；全域输出在限幅内且命中有效区域
+static void test_generated(void) {
+    const mpc_table_t *t = &MPC_TABLE;
+    for (float r = 15.0f; r <= 135.0f; r += 15.0f) {
+        assert(NEAR(mpc_table_eval(t, r, r, NULL), r / t->gain, 0.01f * t->out_max));
+    }
+    assert(mpc_table_eval(t, 0.0f, 100.0f, NULL) == t->out_max);
+    assert(mpc_table_eval(t, 100.0f, 50.0f, NULL) == t->out_min);
+    for (float x = t->x_lo; x <= t->x_hi; x += 2.5f) {
+        for (float r = t->r_lo; r <= t->r_hi; r += 2.5f) {
+            int rg;
+            float u = mpc_table_eval(t, x, r, &rg);
+            assert(u >= t->out_min && u <= t->out_max);
+            assert(rg >= 0 && rg < t->n_regions);
+        }
+    }
+}
+
+int main(void) {
+    test_lookup();
+    test_gap();
+    test_generated();
+    printf("test_mpc: ok\n");
+    return 0;
+}
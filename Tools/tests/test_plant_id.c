@@ -0,0 +1,96 @@
+// 在线辨识：已知一阶加纯滞后对象上的 RLS 收敛、纯滞后候选选择、激励不足暂停与 SIMC 建议参数
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "plant_id.h"
+#include "pid_controller.h"
+
+#define NEAR_REL(a, b, rel) (fabsf((a) - (b)) <= (rel) * fabsf(b))
+
+// 对象：K = 1.5 °C/%，tau = 120 s，纯滞后 5 个采样，环境 25 °C
+#define K_TRUE     1.5f
+#define TAU_TRUE   120.0f
+#define DEAD_TRUE  5
+#define AMB_TRUE   25.0f
+#define N_SAMPLES  3000
+
+static float s_u[N_SAMPLES + 1];
+
+// 输入：20% / 60% 方波，半周期在 23~41 个采样间变化（避免与候选纯滞后同步）
+static float input_at(int k) {
+    static const int HALF[] = { 37, 23, 41, 29 };
+    int t = 0, i = 0, level = 0;
+    while (t + HALF[i] <= k) { t += HALF[i]; i = (i + 1) % 4; level ^= 1; }
+    return level ? 60.0f : 20.0f;
+}
+
+static void run_plant(plant_id_t *id, int n) {
+    const float ts = PLANT_ID_TS_MS / 1000.0f;
+    const float a = expf(-ts / TAU_TRUE), b = K_TRUE * (1.0f - a), c = AMB_TRUE * (1.0f - a);
+    float y = AMB_TRUE;
+    for (int k = 0; k <= n; k++) s_u[k] = input_at(k);
+    for (int k = 1; k <= n; k++) {
+        int kd = k - 1 - DEAD_TRUE;
+        y = a * y + b * s_u[kd < 0 ? 0 : kd] + c;
+        // u 为上一采样周期内的平均输出
+        plant_id_update(id, y, s_u[k - 1]);
+    }
+}
+
+static void test_converge(void) {
+    static plant_id_t id;
+    plant_id_reset(&id);
+    run_plant(&id, N_SAMPLES);
+    plant_model_t m;
+    plant_id_model(&id, &m);
+    assert(m.valid);
+    assert(m.updates >= PLANT_ID_MIN_UPDATES && m.samples == N_SAMPLES);
+    assert(m.dead_s == DEAD_TRUE * (PLANT_ID_TS_MS / 1000.0f));
+    assert(NEAR_REL(m.gain, K_TRUE, 0.02f));
+    assert(NEAR_REL(m.tau_s, TAU_TRUE, 0.03f));
+    assert(fabsf(m.ambient - AMB_TRUE) < 0.5f);
+    assert(m.rmse < 0.05f);
+
+    // SIMC：tau_c = max(theta, 10 s) = 10，Kc = tau / (K (tau_c + theta)) = 5.33，tau_I = min(tau, 4 (tau_c + theta)) = 60 s
+    const float kc = TAU_TRUE / (K_TRUE * (10.0f + DEAD_TRUE));
+    const float ti = 4.0f * (10.0f + DEAD_TRUE);
+    assert(NEAR_REL(m.kp, kc, 0.05f));
+    assert(NEAR_REL(m.ki, kc * (PID_NOMINAL_DT_MS / 1000.0f) / ti, 0.05f));
+    assert(m.kd == 0.0f);
+}
+
+// 恒定输出（稳态保温）：激励不足，不更新参数，模型不给出建议
+static void test_no_excitation(void) {
+    static plant_id_t id;
+    plant_id_reset(&id);
+    for (int k = 0; k < 600; k++) plant_id_update(&id, 80.0f, 35.0f);
+    plant_model_t m;
+    plant_id_model(&id, &m);
+    assert(id.updates == 0 && m.samples == 600);
+    assert(m.excitation < PLANT_ID_EXC_MIN);
+    assert(!m.valid);
+}
+
+// resync 只清历史：参数保留，下一采样不更新（缺少 y(k-1)）
+static void test_resync(void) {
+    static plant_id_t id;
+    plant_id_reset(&id);
+    run_plant(&id, 1000);
+    plant_model_t before, after;
+    plant_id_model(&id, &before);
+    uint32_t updates = id.updates;
+    plant_id_resync(&id);
+    plant_id_update(&id, 50.0f, 40.0f);
+    plant_id_model(&id, &after);
+    assert(id.updates == updates);
+    assert(after.a == before.a && after.b == before.b);
+}
+
+int main(void) {
+    test_converge();
+    test_no_excitation();
+    test_resync();
+    printf("test_plant_id: ok\n");
+    return 0;
+}
@@ -0,0 +1,122 @@
+// 遥测分帧：CRC-16/CCITT-FALSE 校验值、COBS 标准向量、包 <-> 帧往返与损坏帧拒收
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "telemetry_frame.h"
+
+static void test_crc16(void) {
+    assert(telem_crc16((const uint8_t *)"123456789", 9) == 0x29B1);
+    assert(telem_crc16(NULL, 0) == 0xFFFF);
+}
+
+static void check_cobs(const uint8_t *in, size_t len, const uint8_t *want, size_t want_len) {
+    uint8_t enc[600], dec[600];
+    size_t n = telem_cobs_encode(in, len, enc);
+    assert(n == want_len && memcmp(enc, want, n) == 0);
+    // 解码输入不含 0x00 分隔
+    assert(telem_cobs_decode(enc, n - 1, dec, sizeof(dec)) == len);
+    assert(memcmp(dec, in, len) == 0);
+}
+
+static void test_cobs_vectors(void) {
+    check_cobs((const uint8_t[]){ 0x00 }, 1, (const uint8_t[]){ 0x01, 0x01, 0x00 }, 3);
+    check_cobs((const uint8_t[]){ 0x00, 0x00 }, 2, (const uint8_t[]){ 0x01, 0x01, 0x01, 0x00 }, 4);
+    check_cobs((const uint8_t[]){ 0x11, 0x22, 0x00, 0x33 }, 4, (const uint8_t[]){ 0x03, 0x11, 0x22, 0x02, 0x33, 0x00 }, 6);
+    check_cobs((const uint8_t[]){ 0x11, 0x22, 0x33, 0x44 }, 4, (const uint8_t[]){ 0x05, 0x11, 0x22, 0x33, 0x44, 0x00 }, 6);
+    check_cobs((const uint8_t[]){ 0x11, 0x00, 0x00, 0x00 }, 4, (const uint8_t[]){ 0x02, 0x11, 0x01, 0x01, 0x01, 0x00 }, 6);
+
+    // 254 个非零字节：满块 0xFF 后接空块，长度恰为最坏开销上限
+    uint8_t in[255], want[258];
+    for (int i = 0; i < 254; i++) in[i] = (uint8_t)(i + 1);
+    want[0] = 0xFF;
+    memcpy(&want[1], in, 254);
+    want[255] = 0x01;
+    want[256] = 0x00;
+    check_cobs(in, 254, want, 257);
+    assert(257 == 254 + 254 / 254 + 2);
+
+    // 格式错误：0 码字节、块长度越界、块内出现 0x00、输出缓冲不足
+    uint8_t out[8];
+    assert(telem_cobs_decode((const uint8_t[]){ 0x00, 0x11 }, 2, out, sizeof(out)) == 0);
+    assert(telem_cobs_decode((const uint8_t[]){ 0x05, 0x11, 0x22 }, 3, out, sizeof(out)) == 0);
+    assert(telem_cobs_decode((const uint8_t[]){ 0x03, 0x11, 0x00 }, 3, out, sizeof(out)) == 0);
+    assert(telem_cobs_decode((const uint8_t[]){ 0x05, 0x11, 0x22, 0x33, 0x44 }, 5, out, 3) == 0);
+}
+
+// 随机包（含大量 0x00）往返；帧内除末尾分隔外不含 0x00
+static void test_frame_roundtrip(void) {
+    uint8_t pkt[TELEM_MAX_PACKET], frame[TELEM_MAX_FRAME], back[TELEM_MAX_PACKET];
+    srand(1234);
+    for (int iter = 0; iter < 2000; iter++) {
+        size_t len = 1 + (size_t)rand() % (TELEM_MAX_PACKET - 2);
+        for (size_t i = 0; i < len; i++) pkt[i] = (rand() & 3) ? (uint8_t)rand() : 0;
+        size_t n = telem_frame_encode(pkt, len, frame);
+        assert(n >= len + 3 && n <= TELEM_MAX_FRAME);
+        assert(frame[n - 1] == 0x00 && memchr(frame, 0, n - 1) == NULL);
+        assert(telem_frame_decode(frame, n - 1, back, sizeof(back)) == len);
+        assert(memcmp(back, pkt, len) == 0);
+    }
+    // 超出最大包长拒绝编码；解码输出缓冲不足拒绝
+    assert(telem_frame_encode(pkt, TELEM_MAX_PACKET - 1, frame) == 0);
+    size_t n = telem_frame_encode(pkt, 16, frame);
+    assert(telem_frame_decode(frame, n - 1, back, 15) == 0);
+}
+
+// 样本帧任一字节的单比特翻转都被 CRC 或 COBS 结构检查拒收
+static void test_frame_corrupt(void) {
+    uint8_t pkt[TELEM_SAMPLE_MAX], frame[TELEM_MAX_FRAME], bad[TELEM_MAX_FRAME], back[TELEM_MAX_PACKET];
+    telem_hdr_t hdr = { .type = TELEM_TYPE_SAMPLE, .nzones = 2, .seq = 0x0102, .ts_us = 123456789u };
+    telem_zone_t z[2] = {
+        { .adc_raw = 2048, .temp_c10 = 654, .output_c100 = 0, .flags = TELEM_ZONE_RUNNING },
+        { .adc_raw = 0, .temp_c10 = -12, .output_c100 = 10000, .flags = TELEM_ZONE_SENSOR_FAULT },
+    };
+    memcpy(pkt, &hdr, sizeof(hdr));
+    memcpy(pkt + sizeof(hdr), z, sizeof(z));
+    size_t len = sizeof(hdr) + sizeof(z);
+    size_t n = telem_frame_encode(pkt, len, frame);
+    for (size_t i = 0; i + 1 < n; i++) {
+        for (int b = 0; b < 8; b++) {
+            memcpy(bad, frame, n);
+            bad[i] ^= (uint8_t)(1u << b);
+            if (bad[i] == 0) continue;      // 变为分隔符时接收端按两帧切分，不属于本检查
+            assert(telem_frame_decode(bad, n - 1, back, sizeof(back)) == 0);
+        }
+    }
+}
+
+// 温区样本定点换算：开路/短路哨兵值与热电偶高温不溢出，无效温度置故障位，输出饱和到 0~655.35%
+static void test_zone_fill(void) {
+    telem_zone_t zs;
+    telem_zone_fill(&zs, 1234, 65.44f, true, 37.5f, true);
+    assert(zs.adc_raw == 1234 && zs.temp_c10 == 654 && zs.output_c100 == 3750 && zs.flags == TELEM_ZONE_RUNNING);
+    telem_zone_fill(&zs, 0, -1.25f, true, 0.0f, false);
+    assert(zs.temp_c10 == -13 && zs.flags == 0);
+    // K 型热电偶上限 1372°C 超出旧 x100 的 int16 范围
+    telem_zone_fill(&zs, 0, 1372.0f, true, 100.0f, true);
+    assert(zs.temp_c10 == 13720 && zs.output_c100 == 10000);
+    // 999/-999 哨兵：温度为 0，只看故障位
+    telem_zone_fill(&zs, 4095, 999.0f, false, 0.0f, true);
+    assert(zs.temp_c10 == 0 && zs.flags == (TELEM_ZONE_RUNNING | TELEM_ZONE_SENSOR_FAULT));
+    telem_zone_fill(&zs, 0, -999.0f, false, 0.0f, false);
+    assert(zs.temp_c10 == 0 && zs.flags == TELEM_ZONE_SENSOR_FAULT);
+    // 超范围饱和，NaN 为 0
+    telem_zone_fill(&zs, 0, 1e6f, true, 1e6f, false);
+    assert(zs.temp_c10 == INT16_MAX && zs.output_c100 == UINT16_MAX);
+    telem_zone_fill(&zs, 0, -1e6f, true, -5.0f, false);
+    assert(zs.temp_c10 == INT16_MIN && zs.output_c100 == 0);
+    telem_zone_fill(&zs, 0, NAN, true, NAN, false);
+    assert(zs.temp_c10 == 0 && zs.output_c100 == 0);
+}
+
+int main(void) {
+    test_crc16();
+    test_cobs_vectors();
+    test_frame_roundtrip();
+    test_frame_corrupt();
+    test_zone_fill();
+    printf("test_telemetry_frame: ok\n");
+    return 0;
+}
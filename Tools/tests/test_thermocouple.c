@@ -0,0 +1,90 @@
+// 热电偶解码与 NIST K 型修正：数据手册示例帧、故障位、NIST ITS-90 参考点
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "thermocouple.h"
+
+#define NEAR(a, b, tol) (fabsf((a) - (b)) <= (tol))
+
+// MAX31855 读数：冷端温度加线性电势换算（41.276 µV/°C），与器件内部算法一致
+static float max31855_reading(float e_hot_mv, float e_cj_mv, float cj_c) {
+    return cj_c + (e_hot_mv - e_cj_mv) / 0.041276f;
+}
+
+static void test_max31855(void) {
+    temp_sample_t s;
+    // +1000.00 °C，冷端 +25.0000 °C
+    tc_decode_max31855(0x3E801900u, &s);
+    assert(s.fault == TEMP_FAULT_NONE);
+    assert(s.temp == 1000.0f && s.cold_junction == 25.0f);
+    assert(s.raw == 0x3E801900u);
+    // -250.00 °C，冷端 -0.0625 °C（负数为二进制补码）
+    tc_decode_max31855(0xF060FFF0u, &s);
+    assert(s.fault == TEMP_FAULT_NONE);
+    assert(s.temp == -250.0f && s.cold_junction == -0.0625f);
+    // +0.25 °C 最小分辨率
+    tc_decode_max31855(1u << 18, &s);
+    assert(s.fault == TEMP_FAULT_NONE && s.temp == 0.25f);
+
+    // 故障位 D16 + SCV/SCG/OC；冷端仍有效
+    tc_decode_max31855(0x00011901u, &s);
+    assert(s.fault == TEMP_FAULT_OPEN && s.cold_junction == 25.0f);
+    tc_decode_max31855(0x00011902u, &s);
+    assert(s.fault == TEMP_FAULT_SHORT_GND);
+    tc_decode_max31855(0x00011904u, &s);
+    assert(s.fault == TEMP_FAULT_SHORT_VCC);
+
+    // 保留位 D17/D3 非 0 或 MISO 悬空（全 1）视为无器件
+    tc_decode_max31855(0x3E821900u, &s);
+    assert(s.fault == TEMP_FAULT_NO_DEVICE && isnan(s.cold_junction));
+    tc_decode_max31855(0x3E801908u, &s);
+    assert(s.fault == TEMP_FAULT_NO_DEVICE);
+    tc_decode_max31855(0xFFFFFFFFu, &s);
+    assert(s.fault == TEMP_FAULT_NO_DEVICE);
+}
+
+static void test_max6675(void) {
+    temp_sample_t s;
+    tc_decode_max6675(400u << 3, &s);
+    assert(s.fault == TEMP_FAULT_NONE && s.temp == 100.0f && isnan(s.cold_junction));
+    tc_decode_max6675(0x7FF8u, &s);
+    assert(s.fault == TEMP_FAULT_NONE && s.temp == 1023.75f);
+    tc_decode_max6675(0, &s);
+    assert(s.fault == TEMP_FAULT_NONE && s.temp == 0.0f);
+    // D2 开路；D15 恒 0、D1 器件 ID 恒 0
+    tc_decode_max6675(0x0C84u, &s);
+    assert(s.fault == TEMP_FAULT_OPEN);
+    tc_decode_max6675(0x8C80u, &s);
+    assert(s.fault == TEMP_FAULT_NO_DEVICE);
+    tc_decode_max6675(0x0C82u, &s);
+    assert(s.fault == TEMP_FAULT_NO_DEVICE);
+    tc_decode_max6675(0xFFFFu, &s);
+    assert(s.fault == TEMP_FAULT_NO_DEVICE);
+}
+
+// NIST ITS-90 K 型参考值 (mV)：E(-100)=-3.554，E(25)=1.000，E(200)=8.138，E(500)=20.644，E(1200)=48.838
+static void test_nist(void) {
+    const float e_cj = 1.000f, cj = 25.0f;
+    assert(NEAR(tc_k_nist_correct(max31855_reading(8.138f, e_cj, cj), cj), 200.0f, 0.1f));
+    assert(NEAR(tc_k_nist_correct(max31855_reading(20.644f, e_cj, cj), cj), 500.0f, 0.1f));
+    assert(NEAR(tc_k_nist_correct(max31855_reading(48.838f, e_cj, cj), cj), 1200.0f, 0.1f));
+    assert(NEAR(tc_k_nist_correct(max31855_reading(-3.554f, e_cj, cj), cj), -100.0f, 0.1f));
+    // 冷端 0 °C、热端 0 °C：无修正
+    assert(NEAR(tc_k_nist_correct(0.0f, 0.0f), 0.0f, 0.01f));
+    // 经帧量化（0.25 °C）后仍在一个 LSB 内
+    temp_sample_t s;
+    float r = max31855_reading(8.138f, e_cj, cj);
+    uint32_t frame = (uint32_t)(int32_t)lrintf(r * 4.0f) << 18 | (uint32_t)(cj * 16.0f) << 4;
+    tc_decode_max31855(frame, &s);
+    assert(s.fault == TEMP_FAULT_NONE);
+    assert(NEAR(tc_k_nist_correct(s.temp, s.cold_junction), 200.0f, 0.25f));
+}
+
+int main(void) {
+    test_max31855();
+    test_max6675();
+    test_nist();
+    printf("test_thermocouple: ok\n");
+    return 0;
+}
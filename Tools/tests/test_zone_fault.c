@@ -0,0 +1,97 @@
+// 温区传感器故障：运行中的温区读数无效后输出置 0 并保持，不被跟踪实际输出的手动分支覆盖
+//   NTC 短路（读数 -999）；温度源读取卡住、采集缓存超过 SAFETY_SRC_STALE_MS 未更新
+// 链接 host/ 多线程 FreeRTOS 垫片，采集任务与控制任务真实运行
+#include <assert.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "zone_bank.h"
+#include "safety.h"
+#include "hal.h"
+#include "relay.h"
+#include "sensors.h"
+#include "temperature.h"
+
+#define NTC_CH   0
+
+static void wait_ms(int ms) { vTaskDelay(pdMS_TO_TICKS(ms)); }
+
+// 输出须为 0 且之后每个周期保持 0；温区仍在运行（由安全监控决定是否切断）
+static void expect_off(int z, int out) {
+    for (int i = 0; i < 10; i++) {
+        zone_status_t st;
+        zone_bank_get_status(z, &st);
+        assert(!temperature_valid(st.temp));
+        assert(st.running);
+        assert(st.output == 0.0f);
+        assert(relay_get_output_percent_f(out) == 0.0f);
+        wait_ms(100);
+    }
+}
+
+// 设定远高于环境温度：PID 输出饱和
+static void expect_heating(int z, int out) {
+    zone_status_t st;
+    zone_bank_get_status(z, &st);
+    assert(temperature_valid(st.temp));
+    assert(st.output > 50.0f && relay_get_output_percent_f(out) > 50.0f);
+}
+
+static void test_ntc_short(void) {
+    zone_config_t cfg = { .adc_channel = NTC_CH, .output = 0, .output_gpio = 10,
+                          .kp = 2.0f, .ki = 0.1f, .kd = 0.5f, .setpoint = 200.0f, .max_temp = 300.0f };
+    int z = zone_bank_add(&cfg);
+    assert(z >= 0);
+    assert(zone_bank_start(z));
+    wait_ms(300);
+    expect_heating(z, cfg.output);
+
+    hal_sim_set_adc_mv(NTC_CH, 0);
+    wait_ms(300);
+    expect_off(z, cfg.output);
+
+    // 传感器恢复后重新参与 PID
+    hal_sim_set_adc_mv(NTC_CH, -1);
+    wait_ms(300);
+    expect_heating(z, cfg.output);
+    zone_bank_stop(z);
+}
+
+// 温度源：读数固定 25°C；s_hang 置位时 end 阻塞，采集缓存不再更新
+static volatile int s_hang;
+static esp_err_t hang_begin(temp_source_t *src) { (void)src; return ESP_OK; }
+static void hang_end(temp_source_t *src, temp_sample_t *out) {
+    (void)src;
+    while (s_hang) vTaskDelay(1);
+    *out = (temp_sample_t){ .temp = 25.0f, .fault = TEMP_FAULT_NONE };
+}
+static temp_source_t s_hang_src = { .name = "hang", .begin = hang_begin, .end = hang_end };
+
+static void test_source_stale(void) {
+    zone_config_t cfg = { .adc_channel = SENSOR_SRC_ID(0), .source = &s_hang_src, .output = 1, .output_gpio = 11,
+                          .kp = 2.0f, .ki = 0.1f, .kd = 0.5f, .setpoint = 200.0f, .max_temp = 300.0f };
+    int z = zone_bank_add(&cfg);
+    assert(z >= 0);
+    assert(zone_bank_start(z));
+    wait_ms(300);
+    expect_heating(z, cfg.output);
+
+    // 缓存值本身有效，只是过期
+    s_hang = 1;
+    wait_ms(SAFETY_SRC_STALE_MS + 300);
+    expect_off(z, cfg.output);
+
+    s_hang = 0;
+    wait_ms(300);
+    expect_heating(z, cfg.output);
+    zone_bank_stop(z);
+}
+
+int main(void) {
+    temperature_init(NTC_CH, 100000.0f, 3.3f);
+    test_ntc_short();
+    test_source_stale();
+    printf("test_zone_fault: ok\n");
+    return 0;
+}
@@ -0,0 +1,64 @@
+// trace 解码器：把 /api/trace 导出的二进制缓冲还原为文本日志
+//   curl -o trace.bin http://192.168.4.1/api/trace
+//   trace_decode trace.bin [--module temp] [--level 3]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace_fmt.h"
+
+static int module_by_name(const char *name) {
+    for (int m = 0; m < TRACE_MOD_COUNT; m++) {
+        if (strcmp(trace_module_name(m), name) == 0) return m;
+    }
+    return -1;
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    int only_module = -1;
+    int max_level = TRACE_LVL_DEBUG;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--module") == 0 && i + 1 < argc) {
+            only_module = module_by_name(argv[++i]);
+            if (only_module < 0) { fprintf(stderr, "unknown module %s\n", argv[i]); return 2; }
+        } else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            max_level = atoi(argv[++i]);
+        } else {
+            path = argv[i];
+        }
+    }
+    FILE *f = (path && strcmp(path, "-") != 0) ? fopen(path, "rb") : stdin;
+    if (!f) { perror(path); return 1; }
+
+    trace_dump_hdr_t hdr;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1 || hdr.magic != TRACE_DUMP_MAGIC) {
+        fprintf(stderr, "not a trace dump\n");
+        return 1;
+    }
+    if (hdr.rec_size != sizeof(trace_rec_t)) {
+        fprintf(stderr, "record size %u, expected %u\n", (unsigned)hdr.rec_size, (unsigned)sizeof(trace_rec_t));
+        return 1;
+    }
+    if (hdr.event_count != TRACE_ID_COUNT) {
+        fprintf(stderr, "warning: firmware has %u events, decoder %d (event table out of sync?)\n",
+                (unsigned)hdr.event_count, TRACE_ID_COUNT);
+    }
+    if (hdr.dropped) fprintf(stderr, "note: %u records dropped before export\n", (unsigned)hdr.dropped);
+
+    char line[256];
+    trace_rec_t r;
+    uint32_t base = 0;
+    for (uint32_t i = 0; i < hdr.count && fread(&r, sizeof(r), 1, f) == 1; i++) {
+        if (i == 0) base = r.ts_us;
+        int mod = trace_event_module(r.id);
+        int lvl = trace_event_level(r.id);
+        if (only_module >= 0 && mod != only_module) continue;
+        if (lvl > max_level) continue;
+        trace_format(line, sizeof(line), &r);
+        // 相对首条记录的时间（32 位回绕差值仍正确）
+        printf("%12.6f %s %-5s %s\n", (double)(uint32_t)(r.ts_us - base) / 1e6,
+               trace_level_name(lvl), trace_module_name(mod), line);
+    }
+    if (f != stdin) fclose(f);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "api_json.h"
+#include <stdio.h>
+
+int api_json_temp(char *buf, size_t len, float temp) {
+    return snprintf(buf, len, "{\"value\":%.2f}", temp);
+}
+
+int api_json_battery(char *buf, size_t len, float voltage, float percent) {
+    return snprintf(buf, len, "{\"voltage\":%.2f,\"percent\":%.0f}", voltage, percent);
+}
+
+int api_json_relay(char *buf, size_t len, bool relay_on, bool pid_running) {
+    return snprintf(buf, len, "{\"ok\":true,\"relay\":%s,\"pid_running\":%s}",
+                    relay_on ? "true" : "false", pid_running ? "true" : "false");
+}
+
+int api_json_pid_params(char *buf, size_t len, const PID_t *pid, float max_temp) {
+    return snprintf(buf, len, "{\"ok\":true,\"setpoint\":%.1f,\"kp\":%.2f,\"ki\":%.3f,\"kd\":%.2f,\"max\":%.1f}",
+                    pid->setpoint, pid->Kp, pid->Ki, pid->Kd, max_temp);
+}
+
+int api_json_pid_start(char *buf, size_t len, const PID_t *pid) {
+    return snprintf(buf, len, "{\"ok\":true,\"running\":true,\"setpoint\":%.1f,\"kp\":%.2f,\"ki\":%.3f,\"kd\":%.2f}",
+                    pid->setpoint, pid->Kp, pid->Ki, pid->Kd);
+}
+
+// 闭合状态对象：级联温区先追加内环字段；n 为已写入（期望）长度
+static int status_tail(char *buf, size_t len, int n, const api_pid_status_t *st) {
+    if (n < 0) return n;
+    size_t off = (size_t)n < len ? (size_t)n : len;
+    if (!st->cascade || !st->inner) return n + snprintf(buf + off, len - off, "}");
+    const PID_t *in = st->inner;
+    return n + snprintf(buf + off, len - off, ",\"cascade\":{\"element\":%.2f,\"element_sp\":%.1f,\"kp\":%.2f,\"ki\":%.3f,\"kd\":%.2f}}",
+                        st->element_temp, st->element_sp, in->Kp, in->Ki, in->Kd);
+}
+
+int api_json_pid_status(char *buf, size_t len, const api_pid_status_t *st) {
+    const PID_t *pid = st->pid;
+    int n = snprintf(buf, len, "{\"running\":%s,\"manual\":%s,\"ctl\":\"%s\",\"setpoint\":%.1f,\"kp\":%.2f,\"ki\":%.3f,\"kd\":%.2f,\"max\":%.1f,\"temp\":%.2f,\"output\":%.0f,\"adc\":%d,\"mv\":%d,\"pwm\":%d",
+                     st->running ? "true" : "false", st->manual ? "true" : "false", st->ctl ? st->ctl : "pid", pid->setpoint, pid->Kp, pid->Ki, pid->Kd, st->max_temp,
+                     st->temp, st->output, st->adc, st->mv, st->pwm);
+    return status_tail(buf, len, n, st);
+}
+
+int api_json_zone_status(char *buf, size_t len, int zone, const api_pid_status_t *st) {
+    const PID_t *pid = st->pid;
+    int n = snprintf(buf, len, "{\"zone\":%d,\"running\":%s,\"manual\":%s,\"ctl\":\"%s\",\"setpoint\":%.1f,\"kp\":%.2f,\"ki\":%.3f,\"kd\":%.2f,\"max\":%.1f,\"temp\":%.2f,\"output\":%.0f,\"adc\":%d,\"pwm\":%d",
+                     zone, st->running ? "true" : "false", st->manual ? "true" : "false", st->ctl ? st->ctl : "pid", pid->setpoint, pid->Kp, pid->Ki, pid->Kd, st->max_temp,
+                     st->temp, st->output, st->adc, st->pwm);
+    return status_tail(buf, len, n, st);
+}
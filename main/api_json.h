@@ -0,0 +1,37 @@
+#ifndef API_JSON_H
+#define API_JSON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "pid_controller.h"
+
+// API 响应 JSON 构造（纯函数，仅 snprintf 到调用方缓冲区，不分配内存）
+// 返回值同 snprintf：期望写入的长度
+
+// /api/pid/status 所需的快照
+typedef struct {
+    bool running;
+    bool manual;
+    const char *ctl;        // 自动控制算法 "pid" / "mpc"
+    const PID_t *pid;
+    float max_temp;
+    float temp;
+    float output;
+    int adc;
+    int mv;
+    int pwm;
+    bool cascade;           // 级联温区追加 "cascade":{元件温度/目标、内环增益}
+    float element_temp;
+    float element_sp;
+    const PID_t *inner;
+} api_pid_status_t;
+
+int api_json_temp(char *buf, size_t len, float temp);
+int api_json_battery(char *buf, size_t len, float voltage, float percent);
+int api_json_relay(char *buf, size_t len, bool relay_on, bool pid_running);
+int api_json_pid_params(char *buf, size_t len, const PID_t *pid, float max_temp);
+int api_json_pid_start(char *buf, size_t len, const PID_t *pid);
+int api_json_pid_status(char *buf, size_t len, const api_pid_status_t *st);
+int api_json_zone_status(char *buf, size_t len, int zone, const api_pid_status_t *st);
+
+#endif
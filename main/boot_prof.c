@@ -0,0 +1,53 @@
+#include "boot_prof.h"
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "../Hardware/hal.h"
+
+static const char *TAG = "BOOT";
+
+typedef struct {
+    const char *name;
+    int64_t t_us;
+} boot_mark_t;
+
+static boot_mark_t s_marks[BOOT_PROF_MAX_MARKS];
+static int s_count = 0;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+void boot_mark(const char *name) {
+    int64_t t = hal_time_us();
+    portENTER_CRITICAL(&s_lock);
+    if (s_count < BOOT_PROF_MAX_MARKS) {
+        s_marks[s_count].name = name;
+        s_marks[s_count].t_us = t;
+        s_count++;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+int64_t boot_mark_time(const char *name) {
+    for (int i = 0; i < s_count; i++) {
+        if (strcmp(s_marks[i].name, name) == 0) return s_marks[i].t_us;
+    }
+    return -1;
+}
+
+void boot_prof_report(void) {
+    int64_t prev = 0;
+    for (int i = 0; i < s_count; i++) {
+        ESP_LOGI(TAG, "%8.1f ms  (+%6.1f)  %s", s_marks[i].t_us / 1000.0, (s_marks[i].t_us - prev) / 1000.0, s_marks[i].name);
+        prev = s_marks[i].t_us;
+    }
+}
+
+int boot_prof_to_json(char *buf, size_t len) {
+    int w = snprintf(buf, len, "{\"marks\":[");
+    for (int i = 0; i < s_count && w > 0 && (size_t)w < len; i++) {
+        w += snprintf(buf + w, len - w, "%s{\"name\":\"%s\",\"t_us\":%lld}",
+                      i ? "," : "", s_marks[i].name, (long long)s_marks[i].t_us);
+    }
+    if (w > 0 && (size_t)w < len) w += snprintf(buf + w, len - w, "]}");
+    return w;
+}
@@ -0,0 +1,23 @@
+#ifndef BOOT_PROF_H
+#define BOOT_PROF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 启动里程碑：记录自 esp_timer 启动以来的时间戳（us），启动结束后输出一次并可经 /api/boot 查询
+// 多个初始化任务并行打点，记录按调用先后排列
+#define BOOT_PROF_MAX_MARKS 24
+
+// 记录里程碑；name 须为静态字符串；超出容量的打点被丢弃
+void boot_mark(const char *name);
+
+// 查询某里程碑时间 (us)，未记录返回 -1
+int64_t boot_mark_time(const char *name);
+
+// 按时间输出里程碑表（时刻与相邻间隔）到控制台
+void boot_prof_report(void);
+
+// 输出 JSON，返回写入长度
+int boot_prof_to_json(char *buf, size_t len);
+
+#endif
@@ -0,0 +1,94 @@
+#include "capture.h"
+#include <string.h>
+#include "esp_log.h"
+
+#include "../Hardware/hal.h"
+#include "../Hardware/uart.h"
+#include "telemetry_frame.h"
+
+static const char *TAG = "CAPTURE";
+
+static volatile bool s_active = false;
+static volatile uint32_t s_dirty = 0;       // 待记录状态的温区位图
+static uint16_t s_seq = 0;
+static uint32_t s_frames = 0;
+static uint32_t s_dropped = 0;
+static uint32_t s_bytes = 0;
+
+// 帧整体写入 UART 缓冲；写不下则丢弃并安排全量状态重同步，回放端按 seq 缺口定位
+static void capture_send(const uint8_t *pkt, size_t len) {
+    uint8_t frame[TELEM_MAX_FRAME];
+    size_t flen = telem_frame_encode(pkt, len, frame);
+    if (uart_write(frame, flen) == (int)flen) {
+        s_frames++;
+        s_bytes += flen;
+    } else {
+        s_dropped++;
+        s_dirty = ~0u;
+    }
+}
+
+void capture_start(void) {
+    s_dirty = ~0u;
+    s_active = true;
+    ESP_LOGI(TAG, "capture started");
+}
+
+void capture_stop(void) {
+    if (s_active) ESP_LOGI(TAG, "capture stopped: %lu frames, %lu dropped", (unsigned long)s_frames, (unsigned long)s_dropped);
+    s_active = false;
+}
+
+bool capture_active(void) { return s_active; }
+
+void capture_get_stats(capture_stats_t *out) {
+    out->active = s_active;
+    out->frames = s_frames;
+    out->dropped = s_dropped;
+    out->bytes = s_bytes;
+}
+
+void capture_mark_dirty(int zone) {
+    s_dirty |= zone < 0 ? ~0u : 1u << zone;
+}
+
+void capture_sync_state(const pid_bank_t *bank, int count) {
+    if (!s_active || !s_dirty) return;
+    uint32_t dirty = s_dirty;
+    s_dirty = 0;
+    for (int z = 0; z < count && z < TELEM_MAX_ZONES; z++) {
+        if (!(dirty & (1u << z))) continue;
+        telem_cap_state_t st = {
+            .type = TELEM_TYPE_CAP_STATE,
+            .zone = (uint8_t)z,
+            .seq = s_seq++,
+            .ts_us = (uint32_t)hal_time_us(),
+            .kp = bank->Kp[z], .ki = bank->Ki[z], .kd = bank->Kd[z], .setpoint = bank->setpoint[z],
+            .out_min = bank->out_min[z], .out_max = bank->out_max[z],
+            .integral = bank->integral[z], .last_input = bank->last_input[z],
+        };
+        capture_send((const uint8_t *)&st, sizeof(st));
+    }
+}
+
+void capture_tick(uint32_t mask, float dt_ratio, const int *raw, const float *input, const float *output) {
+    if (!s_active) return;
+    uint8_t pkt[TELEM_CAP_TICK_MAX];
+    mask &= (1u << TELEM_MAX_ZONES) - 1;
+    telem_cap_tick_t hdr = {
+        .type = TELEM_TYPE_CAP_TICK,
+        .mask = (uint8_t)mask,
+        .seq = s_seq++,
+        .ts_us = (uint32_t)hal_time_us(),
+        .dt_ratio = dt_ratio,
+    };
+    memcpy(pkt, &hdr, sizeof(hdr));
+    size_t len = sizeof(hdr);
+    for (uint32_t m = mask; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        telem_cap_zone_t zs = { .adc_raw = (uint16_t)raw[z], .temp = input[z], .output = output[z] };
+        memcpy(pkt + len, &zs, sizeof(zs));
+        len += sizeof(zs);
+    }
+    capture_send(pkt, len);
+}
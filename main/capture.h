@@ -0,0 +1,30 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pid_controller.h"
+
+// 控制输入捕获：记录 pid_compute_bank 每个周期看到的全部输入（时间戳、周期折算、ADC 原始值、温度）
+// 及其输出，参数/设定修改时记录该温区完整 PID 状态。帧格式见 telemetry_frame.h（TELEM_TYPE_CAP_*），
+// 经 UART1 与遥测共用链路输出，主机用 telemetry_rx --raw 录制，Tools/replay 离线回放对比
+typedef struct {
+    bool active;
+    uint32_t frames;        // 已写出帧数
+    uint32_t dropped;       // UART 缓冲满未写出的帧（随后对全部温区重新记录状态）
+    uint32_t bytes;
+} capture_stats_t;
+
+void capture_start(void);
+void capture_stop(void);
+bool capture_active(void);
+void capture_get_stats(capture_stats_t *out);
+
+// 标记温区状态需重新记录（参数修改、温区启动）；zone < 0 表示全部
+void capture_mark_dirty(int zone);
+
+// 控制任务中调用：计算前写出已标记温区的状态，计算后写出本周期输入与输出
+void capture_sync_state(const pid_bank_t *bank, int count);
+void capture_tick(uint32_t mask, float dt_ratio, const int *raw, const float *input, const float *output);
+
+#endif
@@ -2,10 +2,10 @@
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/event_groups.h"
 #include "esp_log.h"
 #include "nvs_flash.h"
-#include "driver/uart.h"
-#include "driver/i2c.h"
+#include "sdkconfig.h"
 #include "esp_event.h"
 #include "esp_netif.h"
 #include "esp_wifi.h"
@@ -19,7 +19,17 @@
 #include "../Hardware/uart.h"
 #include "../Hardware/battery_monitor.h"
 #include "../Hardware/relay.h"
+#include "../Hardware/sensors.h"
+#include "../Hardware/thermocouple.h"
 #include "web_server.h"
+#include "zone_bank.h"
+#include "safety.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "sys_stats.h"
+#include "boot_prof.h"
+#include "ota_update.h"
+#include "hw_bench.h"
 
 static const char *TAG = "MAIN";
 // Wi-Fi SoftAP 配置（如需 STA，可后续扩展）
@@ -27,13 +37,21 @@ static const char *TAG = "MAIN";
 #define WIFI_AP_PASS     "12345678"  // 至少8位
 #define WIFI_AP_MAX_CONN 4
 
-static void wifi_init_softap(void) {
+static void on_wifi_ap_start(void *arg, esp_event_base_t base, int32_t id, void *data) {
+    boot_mark("wifi_ap_up");
+}
+
+// 协议栈与事件循环：HTTP 服务只依赖这一步，可先于 Wi-Fi 启动监听
+static void net_stack_init(void) {
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
     esp_netif_create_default_wifi_ap();
+}
 
+static void wifi_init_softap(void) {
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
+    esp_event_handler_register(WIFI_EVENT, WIFI_EVENT_AP_START, on_wifi_ap_start, NULL);
 
     wifi_config_t ap_cfg = { 0 };
     snprintf((char*)ap_cfg.ap.ssid, sizeof(ap_cfg.ap.ssid), "%s", WIFI_AP_SSID);
@@ -45,6 +63,7 @@ static void wifi_init_softap(void) {
 
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_AP));
     ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_AP, &ap_cfg));
+    // 射频校准在此进行（sdkconfig 已启用 NVS 保存校准数据 + 部分校准）
     ESP_ERROR_CHECK(esp_wifi_start());
 
     ESP_LOGI(TAG, "WiFi SoftAP 启动完成，SSID: %s，IP: 192.168.4.1", WIFI_AP_SSID);
@@ -54,13 +73,30 @@ static void wifi_init_softap(void) {
 #define RELAY_GPIO 10
 
 // UART1
-#define UART_PORT_CFG UART_NUM_1
+#define UART_PORT_CFG 1             // UART_NUM_1
 #define UART_TX_GPIO 20
 #define UART_RX_GPIO 21
 #define UART_BAUD    115200
 
+// UART1 遥测（Tools/telemetry 接收）：RATE 为 0 时不启动，可通过 /api/telemetry 开启
+#define TELEMETRY_RATE_HZ 0
+#define TELEMETRY_BAUD    921600
+
+// 系统状态周期输出到控制台 (ms)，0 关闭；随时可通过 /api/sys 查询
+#define SYS_STATS_DUMP_MS 0
+
+// 启动完成后运行一次外设基准（Test/hw_bench.h），报告输出到控制台；也可随时 POST /api/selftest
+#define HW_BENCH_ON_BOOT 0
+
+// 启动并行化：app_main 以 BOOT_MAIN_PRIO 先完成控制通路，OLED 与网络初始化在 BOOT_HELPER_PRIO
+// 辅助任务中执行，利用主通路阻塞的空隙；启动报告最多等待 BOOT_REPORT_TIMEOUT_MS
+#define BOOT_MAIN_PRIO          4
+#define BOOT_HELPER_PRIO        3
+#define BOOT_REPORT_TIMEOUT_MS  5000
+#define BOOT_VALIDATE_TIMEOUT_MS 30000   // OTA 新固件自检：启动任务须在此时间内完成
+
 // I2C0 for OLED
-#define I2C_PORT_CFG I2C_NUM_0
+#define I2C_PORT_CFG 0              // I2C_NUM_0
 #define I2C_SDA_IO   8
 #define I2C_SCL_IO   9
 #define I2C_CLK_HZ   400000
@@ -77,33 +113,126 @@ static void wifi_init_softap(void) {
 #define BUTTON3_GPIO 2
 
 // Temperature/Battery ADC
-#define TEMP_ADC_CH   ADC_CHANNEL_0
-#define BATT_ADC_CH   ADC_CHANNEL_4
+#define TEMP_ADC_CH   0             // ADC1_CH0
+#define BATT_ADC_CH   4             // ADC1_CH4
 #define NTC_REF_RES_CFG   100000.0f    // 若上拉电阻为1kΩ，这里设为1000
 #define VCC_SUPPLY    3.3f
 
-static void hardware_init(void);
+// 加热输出调制：MOSFET/随机导通 SSR 用 1kHz PWM；
+// 机械继电器改用 RELAY_MODE_WINDOW（WINDOW_SIZE 窗口），过零 SSR 改用 RELAY_MODE_SIGMA_DELTA
+#define HEATER_MODULATION { .mode = RELAY_MODE_PWM, .window_ms = WINDOW_SIZE, .min_on_ms = 100, .min_off_ms = 100, .dither = true }
 
-// 已移除旧的任务逻辑，仅保留硬件自检
+// 温区配置：NTC 通道 + 加热输出 + 默认 PID；温区 0 对应 /api/pid/*
+// 增加温区：NTC 接 ADC1_CH1/CH2，输出 1/2 接对应 SSR 引脚（RELAY_MAX_OUTPUTS 以内）
+static const zone_config_t ZONES[] = {
+    { .adc_channel = TEMP_ADC_CH, .output = 0, .output_gpio = RELAY_GPIO, .modulation = HEATER_MODULATION,
+      .kp = 2.0f, .ki = 0.1f, .kd = 0.5f, .setpoint = 40.0f, .max_temp = 80.0f },
+    // { .adc_channel = 1, .output = 1, .output_gpio = 1,
+    //   .kp = 2.0f, .ki = 0.1f, .kd = 0.5f, .setpoint = 40.0f, .max_temp = 80.0f },
+};
+
+// 温区 0 改用 K 型热电偶（NTC 上限不足的高温工况）：MAX31855/MAX6675 接 SPI2，只需 SCLK/MISO/CS
+// 控制台在 UART0，GPIO18/19（USB）可复用；仿真目标下 SPI 设备 0 测量温区 0 的加热对象
+#define ZONE0_THERMOCOUPLE 0
+#define TC_SPI_HOST   1             // SPI2_HOST
+#define TC_SCLK_GPIO  18
+#define TC_MISO_GPIO  19
+#define TC_CS_GPIO    1
+#define TC_CHIP       TC_MAX31855
+
+// 温区 0 级联控制：加热元件 NTC 的 ADC 通道（-1 为单回路）；启用后温区 0 的 kp/ki/kd 为外环增益
+// 元件 NTC 与产品 NTC 共用分压参数：100kΩ 上拉时约 90°C 以上电压低于 SAFETY_SENSOR_MIN_MV（判为短路），element_max 须留余量
+#define ZONE0_ELEMENT_ADC_CH  -1
+#define ZONE0_CASCADE { .enable = true, .element_channel = ZONE0_ELEMENT_ADC_CH, .kp = 3.0f, .ki = 0.03f, .kd = 0.0f, \
+                        .element_min = 25.0f, .element_max = 80.0f, .inner_ms = 100, .outer_ms = 1000 }
+
+static void control_init(void);
+static void peripheral_init(void);
+
+// 并行初始化任务完成位
+#define BOOT_BIT_OLED (1u << 0)
+#define BOOT_BIT_NET  (1u << 1)
+static EventGroupHandle_t s_boot_events;
+
+// OLED：探测 + 初始化序列 + 清屏（约 90 次 I2C 事务），期间 CPU 可让给其它初始化
+static void boot_oled_task(void *arg) {
+    display_init(I2C_PORT_CFG, I2C_SDA_IO, I2C_SCL_IO, I2C_CLK_HZ, OLED_ADDR);
+    boot_mark("oled_ready");
+    xEventGroupSetBits(s_boot_events, BOOT_BIT_OLED);
+    vTaskDelete(NULL);
+}
+
+// 网络：先启动 HTTP 监听，再初始化/启动 Wi-Fi（AP 就绪由事件回调打点）
+// HTTP 启动失败时不置完成位，新固件不会被确认
+static void boot_net_task(void *arg) {
+    net_stack_init();
+    esp_err_t err = web_server_start();
+    boot_mark("http_ready");
+    wifi_init_softap();
+    boot_mark("wifi_started");
+    if (err == ESP_OK) xEventGroupSetBits(s_boot_events, BOOT_BIT_NET);
+    vTaskDelete(NULL);
+}
 
 void app_main(void) {
+    boot_mark("app_main");
     ESP_LOGI(TAG, "ESP32硬件自检模式启动");
 
-    // 初始化NVS
+    // 初始化NVS（Wi-Fi 校准数据依赖 NVS，须先于网络任务）
     esp_err_t ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) {
         ESP_ERROR_CHECK(nvs_flash_erase());
         ret = nvs_flash_init();
     }
     ESP_ERROR_CHECK(ret);
+    boot_mark("nvs");
 
-    // 仅初始化自检所需模块
-    ESP_LOGI(TAG, "初始化自检相关硬件...");
-    hardware_init();
+    // 热路径日志走二进制 trace，由 drain 任务延迟格式化
+    trace_init();
+    sys_stats_init(SYS_STATS_DUMP_MS);
 
-    // 启动 Web 服务（提供前端与 API）
-    wifi_init_softap();
-    web_server_start();
+    // 控制通路优先：主任务临时提升优先级，辅助任务只在主任务阻塞时运行
+    UBaseType_t main_prio = uxTaskPriorityGet(NULL);
+    vTaskPrioritySet(NULL, BOOT_MAIN_PRIO);
+    s_boot_events = xEventGroupCreate();
+    xTaskCreate(boot_oled_task, "boot_oled", 3072, NULL, BOOT_HELPER_PRIO, NULL);
+    xTaskCreate(boot_net_task, "boot_net", 4096, NULL, BOOT_HELPER_PRIO, NULL);
+
+    control_init();
+    // 加热输出可用即启动安全监控（早于网络与 OLED）
+    safety_init();
+    boot_mark("control_ready");
+    peripheral_init();
+    boot_mark("peripherals");
+
+    if (TELEMETRY_RATE_HZ > 0) telemetry_start(TELEMETRY_RATE_HZ, TELEMETRY_BAUD);
+    vTaskPrioritySet(NULL, main_prio);
+
+    // 等待并行任务结束后输出启动报告（/api/boot 可随时查询）
+    EventBits_t bits = xEventGroupWaitBits(s_boot_events, BOOT_BIT_OLED | BOOT_BIT_NET, pdFALSE, pdTRUE,
+                                           pdMS_TO_TICKS(BOOT_REPORT_TIMEOUT_MS));
+    if ((bits & (BOOT_BIT_OLED | BOOT_BIT_NET)) != (BOOT_BIT_OLED | BOOT_BIT_NET)) {
+        ESP_LOGW(TAG, "启动任务未在 %d ms 内完成 (bits=0x%x)", BOOT_REPORT_TIMEOUT_MS, (unsigned)bits);
+    }
+    boot_mark("boot_done");
+    boot_prof_report();
+    // 控制通路、OLED 与网络（httpd 在监听）均已起来才确认新固件；
+    // 慢启动再等到 BOOT_VALIDATE_TIMEOUT_MS，仍未完成或 httpd 未启动则 OTA 后首次启动回滚到上一固件
+    if ((bits & (BOOT_BIT_OLED | BOOT_BIT_NET)) != (BOOT_BIT_OLED | BOOT_BIT_NET)) {
+        bits = xEventGroupWaitBits(s_boot_events, BOOT_BIT_OLED | BOOT_BIT_NET, pdFALSE, pdTRUE,
+                                   pdMS_TO_TICKS(BOOT_VALIDATE_TIMEOUT_MS - BOOT_REPORT_TIMEOUT_MS));
+    }
+    if ((bits & (BOOT_BIT_OLED | BOOT_BIT_NET)) == (BOOT_BIT_OLED | BOOT_BIT_NET) && web_server_port()) {
+        ota_update_mark_valid();
+    } else {
+        ota_update_rollback();
+    }
+
+    if (HW_BENCH_ON_BOOT) {
+        static char report[HW_BENCH_REPORT_MAX];
+        hw_bench_cfg_t cfg = { .http_port = web_server_port(), .flash_bytes = HW_BENCH_FLASH_BYTES };
+        hw_bench_run(&cfg, report, sizeof(report));
+    }
 
     ESP_LOGI(TAG, "初始化完成，进入待机/WEB服务模式");
     while (1) {
@@ -111,14 +240,26 @@ void app_main(void) {
     }
 }
 
-static void hardware_init(void) {
+// 控制通路：ADC/NTC + 温区（继电器输出），完成即可启动 PID；温区注册时 NTC 通道加入采集服务
+static void control_init(void) {
+    temperature_init(TEMP_ADC_CH, NTC_REF_RES_CFG, VCC_SUPPLY);
+    for (size_t i = 0; i < sizeof(ZONES) / sizeof(ZONES[0]); i++) {
+        zone_config_t cfg = ZONES[i];
+        if (i == 0 && ZONE0_THERMOCOUPLE && thermocouple_bus_init(TC_SPI_HOST, TC_SCLK_GPIO, TC_MISO_GPIO) == ESP_OK) {
+            cfg.source = thermocouple_add(&(tc_cfg_t){ .chip = TC_CHIP, .spi_host = TC_SPI_HOST, .cs_io = TC_CS_GPIO, .nist = true });
+            if (cfg.source) cfg.adc_channel = SENSOR_SRC_ID(0);
+        }
+        if (i == 0 && ZONE0_ELEMENT_ADC_CH >= 0) cfg.cascade = (zone_cascade_cfg_t)ZONE0_CASCADE;
+        zone_bank_add(&cfg);
+    }
+}
+
+// 其余外设：均为寄存器配置，耗时很短
+static void peripheral_init(void) {
     uart_init(UART_PORT_CFG, UART_TX_GPIO, UART_RX_GPIO, UART_BAUD);
     key_init(BUTTON1_GPIO, BUTTON2_GPIO, BUTTON3_GPIO);
     rgb_init(RGB_R_GPIO, RGB_G_GPIO, RGB_B_GPIO);
     buzzer_init(7);
-    display_init(I2C_PORT_CFG, I2C_SDA_IO, I2C_SCL_IO, I2C_CLK_HZ, OLED_ADDR);
-    temperature_init(TEMP_ADC_CH, NTC_REF_RES_CFG, VCC_SUPPLY);
-    // 补充：继电器 PWM 与电池监控
-    relay_init_pwm(RELAY_GPIO, 1000);
     battery_monitor_init(BATT_ADC_CH, 2.0f, 3.0f, 4.2f);
-}
\ No newline at end of file
+    sensors_add_channel(BATT_ADC_CH, SENSOR_BATTERY, SENSOR_BATT_PERIOD_MS);
+}
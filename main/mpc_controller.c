@@ -0,0 +1,72 @@
+#include "mpc_controller.h"
+#include <string.h>
+
+// 查找容差：区域边界上的浮点误差不至于落入缝隙
+#define MPC_EDGE_EPS 1e-3f
+
+static inline float clampf(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+float mpc_table_eval(const mpc_table_t *tbl, float x, float r, int *region) {
+    x = clampf(x, tbl->x_lo, tbl->x_hi);
+    r = clampf(r, tbl->r_lo, tbl->r_hi);
+    // 首个包含 p 的区域；都不包含（缝隙/约束不可行，如已远高于设定）时取越界最小的区域
+    int best = -1;
+    float best_viol = 0.0f;
+    for (int i = 0; i < tbl->n_regions; i++) {
+        const mpc_region_t *rg = &tbl->regions[i];
+        const mpc_halfplane_t *h = &tbl->halfplanes[rg->first];
+        float viol = 0.0f;
+        for (int k = 0; k < rg->count; k++) {
+            float v = h[k].ax * x + h[k].ar * r - h[k].b;
+            if (v > viol) viol = v;
+        }
+        if (viol <= MPC_EDGE_EPS) {
+            best = i;
+            break;
+        }
+        if (best < 0 || viol < best_viol) {
+            best = i;
+            best_viol = viol;
+        }
+    }
+    if (region) *region = best;
+    if (best < 0) return tbl->out_min;
+    const mpc_region_t *rg = &tbl->regions[best];
+    return clampf(rg->kx * x + rg->kr * r + rg->k0, tbl->out_min, tbl->out_max);
+}
+
+void mpc_reset(mpc_state_t *st, const mpc_table_t *tbl, float temp, float output) {
+    memset(st, 0, sizeof(*st));
+    st->tbl = tbl;
+    st->output = clampf(output, tbl->out_min, tbl->out_max);
+    st->xm = tbl->gain * st->output;
+    for (int i = 0; i < MPC_MAX_DELAY; i++) st->hist[i] = st->xm;
+    st->dist = temp - tbl->ambient - st->xm;
+    st->last_region = -1;
+}
+
+float mpc_step(mpc_state_t *st, int64_t now_us, float temp, float setpoint) {
+    const mpc_table_t *tbl = st->tbl;
+    if (now_us < st->next_us) return st->output;
+    // 按采样周期对齐；控制曾暂停超过一个周期时从当前时刻重新计时
+    int64_t ts_us = (int64_t)(tbl->ts_s * 1e6f);
+    st->next_us = (st->next_us && now_us - st->next_us < ts_us) ? st->next_us + ts_us : now_us + ts_us;
+
+    // 滞后模型输出 = delay 个周期前的无滞后模型状态；与实测之差为扰动估计
+    int d = tbl->delay < MPC_MAX_DELAY ? tbl->delay : MPC_MAX_DELAY;
+    float xm_delayed = d > 0 ? st->hist[st->head] : st->xm;
+    st->dist = temp - tbl->ambient - xm_delayed;
+
+    int region;
+    st->output = mpc_table_eval(tbl, st->xm, setpoint - tbl->ambient - st->dist, &region);
+    st->last_region = (int16_t)region;
+
+    if (d > 0) {
+        st->hist[st->head] = st->xm;
+        st->head = (uint8_t)((st->head + 1) % d);
+    }
+    st->xm = tbl->a * st->xm + tbl->b * st->output;
+    return st->output;
+}
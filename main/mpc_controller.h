@@ -0,0 +1,70 @@
+#ifndef MPC_CONTROLLER_H
+#define MPC_CONTROLLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 显式 MPC：一阶加纯滞后 (FOPDT) 加热对象，输入限幅 + 超调约束的 QP 由主机工具 Tools/mpc/mpc_gen
+// 离线求成分段仿射解，生成 mpc_table.c 常量表放在 flash；设备端每个采样周期只做区域查找 + 一次仿射计算
+//
+// 参数 p = (x, r)，均为模型“温升”坐标（相对 ambient）：
+//   x —— 无滞后内部模型状态，即 dead_s 之后的预测温升（Smith 预估）
+//   r —— 设定温升，已扣除输出扰动估计 dist = 实测温升 - 滞后模型输出（消除静差）
+// 区域为凸多边形，边以半平面 ax*x + ar*r <= b 给出；区域内首个控制量 u = kx*x + kr*r + k0
+
+#define MPC_MAX_DELAY 32        // 纯滞后最多采样周期数（模型输出历史环形缓冲）
+
+typedef struct {
+    float ax, ar, b;
+} mpc_halfplane_t;
+
+typedef struct {
+    uint16_t first;             // 在 halfplanes 中的起始下标
+    uint16_t count;
+    float kx, kr, k0;
+} mpc_region_t;
+
+typedef struct {
+    // 对象模型与采样
+    float gain;                 // 稳态增益 (°C/%)
+    float tau_s;                // 时间常数 (s)
+    float dead_s;               // 纯滞后 (s)
+    float ts_s;                 // 采样周期 (s)
+    float ambient;              // 环境温度 (°C)
+    float a, b;                 // 离散模型 x+ = a*x + b*u
+    int delay;                  // dead_s / ts_s（采样周期数）
+    // 约束
+    float out_min, out_max;     // 输出 (%)
+    float overshoot;            // 允许超调 (°C)
+    // 参数域（查找前钳位到此范围）
+    float x_lo, x_hi, r_lo, r_hi;
+    const mpc_halfplane_t *halfplanes;
+    const mpc_region_t *regions;
+    uint16_t n_regions;
+} mpc_table_t;
+
+// 生成的默认表（main/mpc_table.c）
+extern const mpc_table_t MPC_TABLE;
+
+// 单路显式 MPC 状态
+typedef struct {
+    const mpc_table_t *tbl;
+    float xm;                   // 无滞后内部模型温升
+    float hist[MPC_MAX_DELAY];  // 最近 delay 个采样周期的 xm，读出即 delay 前的值
+    uint8_t head;
+    float dist;                 // 输出扰动估计 (°C)
+    float output;               // 当前输出（两次采样之间保持）
+    int64_t next_us;            // 下次采样时间
+    int16_t last_region;        // 最近命中的区域（-1 为域外按最近区域处理）
+} mpc_state_t;
+
+// 查表：返回首个控制量（已限幅）；region 可为 NULL
+float mpc_table_eval(const mpc_table_t *tbl, float x, float r, int *region);
+
+// 无扰接入：假设对象已在当前输出 output 下稳态，模型状态与扰动估计由当前温度反推
+void mpc_reset(mpc_state_t *st, const mpc_table_t *tbl, float temp, float output);
+
+// 控制周期调用；未到采样时刻时返回保持的输出。控制周期可变，采样按 ts_s 对齐
+float mpc_step(mpc_state_t *st, int64_t now_us, float temp, float setpoint);
+
+#endif
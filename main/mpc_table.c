@@ -0,0 +1,62 @@
+// 由 Tools/mpc/mpc_gen 生成，勿手工修改：mpc_gen -o main/mpc_table.c
+// 模型 gain=1.5 °C/% tau=120 s dead=10 s ts=2 s ambient=25 °C；输出 0~100 %，超调 <= 0.5 °C
+// 代价 q=1 rho=0.02，预测 60 步，分块 1 4 55；11 个区域，30 个半平面
+#include "mpc_controller.h"
+
+static const mpc_halfplane_t HALFPLANES[] = {
+    { -0.345257759f, 0.938507915f, 88.5182648f },
+    { 0.666037798f, -0.745917976f, -12.1632023f },
+    { 0.677074254f, -0.735914707f, -9.90670204f },
+    { 0.345257759f, -0.938507915f, -88.5182648f },
+    { 0.453006595f, -0.891507149f, -65.7750854f },
+    { 0.673750639f, -0.738958776f, 0.0f },
+    { 0.707106769f, -0.707106769f, 0.435039014f },
+    { -0.673750639f, 0.738958776f, 9.78122807f },
+    { -0.707106769f, 0.707106769f, 3.77014709f },
+    { -0.674841166f, 0.737963021f, 9.58902454f },
+    { 0.707106769f, -0.707106769f, -3.77014709f },
+    { -0.666037798f, 0.745917976f, 12.1632023f },
+    { 0.674841166f, -0.737963021f, -9.58902454f },
+    { 0.701189995f, -0.712974429f, -4.85706425f },
+    { 0.701189995f, -0.712974429f, 0.356487215f },
+    { -0.707106769f, 0.707106769f, -0.435039014f },
+    { 0.673750639f, -0.738958776f, -9.78122807f },
+    { -0.663796902f, 0.747912884f, 12.6173983f },
+    { -0.701189995f, 0.712974429f, 4.85706425f },
+    { 0.663796902f, -0.747912884f, -12.6173983f },
+    { -0.453006595f, 0.891507149f, 65.7750854f },
+    { -0.677074254f, 0.735914707f, 9.90670204f },
+    { 0.453006595f, -0.891507149f, 0.0f },
+    { 0.701189995f, -0.712974429f, 0.356487215f },
+    { -0.663796902f, 0.747912884f, 0.0f },
+    { 0.663796902f, -0.747912884f, 0.0f },
+    { 0.701189995f, -0.712974429f, 0.356487215f },
+    { -0.673750639f, 0.738958776f, 0.0f },
+    { 0.701189995f, -0.712974429f, 0.356487215f },
+    { -0.453006595f, 0.891507149f, 0.0f },
+};
+
+// { first, count, kx, kr, k0 }：按区域面积降序，常用区域先匹配
+static const mpc_region_t REGIONS[] = {
+    {   0, 3, 0.0f, 0.0f, 100.0f },
+    {   3, 2, 0.0f, 0.0f, 100.0f },
+    {   5, 4, -6.88820076f, 7.55486727f, 0.0f },
+    {   9, 2, -7.12739515f, 7.79406166f, -1.27533507f },
+    {  11, 3, 0.0f, 0.0f, 100.0f },
+    {  14, 2, -39.6675911f, 40.334259f, 20.1671295f },
+    {  16, 3, 0.0f, 0.0f, 100.0f },
+    {  19, 3, 0.0f, 0.0f, 100.0f },
+    {  22, 3, 0.0f, 0.0f, 0.0f },
+    {  25, 3, 0.0f, 0.0f, 0.0f },
+    {  28, 2, 0.0f, 0.0f, 0.0f },
+};
+
+const mpc_table_t MPC_TABLE = {
+    .gain = 1.5f, .tau_s = 120.0f, .dead_s = 10.0f, .ts_s = 2.0f, .ambient = 25.0f,
+    .a = 0.983471453f, .b = 0.0247928184f, .delay = 5,
+    .out_min = 0.0f, .out_max = 100.0f, .overshoot = 0.5f,
+    .x_lo = 0.0f, .x_hi = 150.0f, .r_lo = 0.0f, .r_hi = 150.0f,
+    .halfplanes = HALFPLANES,
+    .regions = REGIONS,
+    .n_regions = 11,
+};
@@ -0,0 +1,154 @@
+#include "ota_update.h"
+#include <stdbool.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "../Hardware/hal.h"
+#include "sha256.h"
+
+static const char *TAG = "OTA";
+
+// 会话状态：begin/write/apply/abort 由调用方串行（web_server 的 s_ota_lock，取不到即 409）；
+// get_status 可在任意任务调用，s_st 的修改与快照由 s_st_lock 保护
+static ota_status_t s_st;
+static portMUX_TYPE s_st_lock = portMUX_INITIALIZER_UNLOCKED;
+static hal_ota_t s_ota = NULL;
+static sha256_ctx_t s_sha;
+static uint8_t s_expect[SHA256_DIGEST_SIZE];
+static int64_t s_start_us;
+
+const char *ota_state_name(ota_state_t st) {
+    switch (st) {
+    case OTA_STATE_IDLE:      return "idle";
+    case OTA_STATE_RECEIVING: return "receiving";
+    case OTA_STATE_READY:     return "ready";
+    case OTA_STATE_FAILED:    return "failed";
+    default:                  return "?";
+    }
+}
+
+static void ota_fail(esp_err_t err, const char *what) {
+    ESP_LOGE(TAG, "%s failed at %lu/%lu: 0x%x", what, (unsigned long)s_st.written, (unsigned long)s_st.size, err);
+    if (s_ota) hal_ota_abort(s_ota);
+    s_ota = NULL;
+    uint32_t elapsed_ms = (uint32_t)((hal_time_us() - s_start_us) / 1000);
+    portENTER_CRITICAL(&s_st_lock);
+    s_st.state = OTA_STATE_FAILED;
+    s_st.last_err = err;
+    s_st.elapsed_ms = elapsed_ms;
+    portEXIT_CRITICAL(&s_st_lock);
+}
+
+esp_err_t ota_update_begin(uint32_t size, const char *sha256_hex) {
+    uint8_t expect[SHA256_DIGEST_SIZE];
+    if (size == 0 || size > OTA_MAX_IMAGE_SIZE || size > hal_ota_partition_size()) return ESP_ERR_INVALID_ARG;
+    if (!sha256_hex || sha256_from_hex(sha256_hex, expect) != 0) return ESP_ERR_INVALID_ARG;
+
+    ota_update_abort();
+    esp_err_t err = hal_ota_begin(&s_ota);
+    if (err != ESP_OK) {
+        s_ota = NULL;
+        portENTER_CRITICAL(&s_st_lock);
+        s_st.state = OTA_STATE_FAILED;
+        s_st.last_err = err;
+        portEXIT_CRITICAL(&s_st_lock);
+        return err;
+    }
+    memcpy(s_expect, expect, sizeof(expect));
+    sha256_init(&s_sha);
+    ota_status_t st = { .state = OTA_STATE_RECEIVING, .size = size };
+    sha256_to_hex(expect, st.sha256);
+    int64_t now_us = hal_time_us();
+    portENTER_CRITICAL(&s_st_lock);
+    s_st = st;
+    s_start_us = now_us;
+    portEXIT_CRITICAL(&s_st_lock);
+    ESP_LOGI(TAG, "begin: %lu B sha256=%s", (unsigned long)size, st.sha256);
+    return ESP_OK;
+}
+
+// 写满后：先比较整文件摘要，再由 HAL 校验镜像格式
+static void ota_finish(void) {
+    uint8_t got[SHA256_DIGEST_SIZE];
+    sha256_final(&s_sha, got);
+    if (memcmp(got, s_expect, sizeof(got)) != 0) {
+        char hex[65];
+        sha256_to_hex(got, hex);
+        ESP_LOGE(TAG, "sha256 mismatch: got %s", hex);
+        ota_fail(ESP_ERR_INVALID_CRC, "hash");
+        return;
+    }
+    esp_err_t err = hal_ota_end(s_ota);
+    s_ota = NULL;
+    if (err != ESP_OK) {
+        ota_fail(err, "image verify");
+        return;
+    }
+    uint32_t elapsed_ms = (uint32_t)((hal_time_us() - s_start_us) / 1000);
+    portENTER_CRITICAL(&s_st_lock);
+    s_st.state = OTA_STATE_READY;
+    s_st.elapsed_ms = elapsed_ms;
+    portEXIT_CRITICAL(&s_st_lock);
+    ESP_LOGI(TAG, "image verified (%lu B in %lu ms)", (unsigned long)s_st.size, (unsigned long)s_st.elapsed_ms);
+}
+
+esp_err_t ota_update_write(uint32_t offset, const void *data, size_t len) {
+    if (s_st.state != OTA_STATE_RECEIVING || offset != s_st.written) return ESP_ERR_INVALID_STATE;
+    if (len > s_st.size - s_st.written) return ESP_ERR_INVALID_SIZE;
+    esp_err_t err = hal_ota_write(s_ota, data, len);
+    if (err != ESP_OK) {
+        ota_fail(err, "write");
+        return err;
+    }
+    sha256_update(&s_sha, data, len);
+    portENTER_CRITICAL(&s_st_lock);
+    s_st.written += len;
+    portEXIT_CRITICAL(&s_st_lock);
+    if (s_st.written == s_st.size) ota_finish();
+    return s_st.state == OTA_STATE_FAILED ? s_st.last_err : ESP_OK;
+}
+
+static void ota_restart_task(void *arg) {
+    vTaskDelay(pdMS_TO_TICKS(OTA_RESTART_DELAY_MS));
+    hal_restart();
+}
+
+esp_err_t ota_update_apply(void) {
+    if (s_st.state != OTA_STATE_READY) return ESP_ERR_INVALID_STATE;
+    esp_err_t err = hal_ota_set_boot();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "set boot partition failed: 0x%x", err);
+        return err;
+    }
+    ESP_LOGW(TAG, "boot partition switched, restarting in %d ms", OTA_RESTART_DELAY_MS);
+    xTaskCreate(ota_restart_task, "ota_restart", 2048, NULL, 1, NULL);
+    return ESP_OK;
+}
+
+void ota_update_abort(void) {
+    if (s_ota) {
+        hal_ota_abort(s_ota);
+        s_ota = NULL;
+        ESP_LOGW(TAG, "session aborted at %lu/%lu", (unsigned long)s_st.written, (unsigned long)s_st.size);
+    }
+    portENTER_CRITICAL(&s_st_lock);
+    memset(&s_st, 0, sizeof(s_st));
+    portEXIT_CRITICAL(&s_st_lock);
+}
+
+void ota_update_get_status(ota_status_t *out) {
+    portENTER_CRITICAL(&s_st_lock);
+    *out = s_st;
+    int64_t start_us = s_start_us;
+    portEXIT_CRITICAL(&s_st_lock);
+    if (out->state == OTA_STATE_RECEIVING) out->elapsed_ms = (uint32_t)((hal_time_us() - start_us) / 1000);
+}
+
+void ota_update_mark_valid(void) {
+    hal_ota_mark_valid();
+}
+
+void ota_update_rollback(void) {
+    hal_ota_rollback();
+}
@@ -0,0 +1,51 @@
+#ifndef OTA_UPDATE_H
+#define OTA_UPDATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+// 固件在线升级：镜像按固定块流式写入非运行 OTA 分区，不在 RAM 中缓存整个镜像
+// 断点续传：每段数据携带 offset，须等于已写入字节数；连接中断后查询进度，从该偏移继续
+// 写满后先比较 SHA-256（整文件，客户端提供）再由 HAL 校验镜像格式，均通过才允许切换启动分区
+// begin/write/apply/abort 不可并发，由调用方串行；get_status 可随时从任意任务调用
+#define OTA_CHUNK_SIZE      4096        // 单次接收/写入块（一个 flash 扇区）
+#define OTA_MAX_IMAGE_SIZE  0xF0000     // 与 partitions.csv 中 ota_0/ota_1 一致
+#define OTA_RESTART_DELAY_MS 500        // 切换后延迟重启，留出响应发送时间
+
+typedef enum {
+    OTA_STATE_IDLE = 0,
+    OTA_STATE_RECEIVING,        // 会话进行中，可续传
+    OTA_STATE_READY,            // 校验通过，等待切换
+    OTA_STATE_FAILED,           // 写入/校验失败，须从 offset 0 重新开始
+} ota_state_t;
+
+typedef struct {
+    ota_state_t state;
+    uint32_t size;              // 镜像总长
+    uint32_t written;           // 已写入字节数（续传偏移）
+    esp_err_t last_err;
+    char sha256[65];            // 期望摘要（十六进制）
+    uint32_t elapsed_ms;        // 会话开始至今（READY/FAILED 时为总耗时）
+} ota_status_t;
+
+// 开始新会话（丢弃未完成的旧会话）；size 超出分区或摘要格式错误返回 ESP_ERR_INVALID_ARG
+esp_err_t ota_update_begin(uint32_t size, const char *sha256_hex);
+
+// 写入一段；offset != written 返回 ESP_ERR_INVALID_STATE（调用方据此返回当前偏移）
+// 写满 size 时自动校验，结果反映在状态中
+esp_err_t ota_update_write(uint32_t offset, const void *data, size_t len);
+
+// 校验通过后设为启动分区，OTA_RESTART_DELAY_MS 后重启
+esp_err_t ota_update_apply(void);
+
+void ota_update_abort(void);
+void ota_update_get_status(ota_status_t *out);
+const char *ota_state_name(ota_state_t st);
+
+// 启动完成后调用：新固件运行正常，取消回滚
+void ota_update_mark_valid(void);
+// 启动自检失败时调用：新固件回滚到上一固件并重启；非 OTA 后首次启动时无操作
+void ota_update_rollback(void);
+
+#endif
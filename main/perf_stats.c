@@ -0,0 +1,93 @@
+#include "perf_stats.h"
+
+#if PERF_STATS_ENABLE
+
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+
+// 直方图：每个 2 的幂区间再四等分，32 位周期数共 124 个桶（相对误差 < 25%，p99 取桶上界）
+#define PERF_SUB_BITS 2
+#define PERF_SUB      (1 << PERF_SUB_BITS)
+#define PERF_BUCKETS  ((32 - PERF_SUB_BITS + 1) * PERF_SUB)
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t hist[PERF_BUCKETS];
+} perf_stat_t;
+
+static const char *const STAGE_NAMES[PERF_STAGE_COUNT] = {
+    "adc", "ntc", "pid", "output", "oled", "log", "tick",
+};
+
+static perf_stat_t s_stats[PERF_STAGE_COUNT];
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static inline int bucket_of(uint32_t v) {
+    if (v < 2 * PERF_SUB) return (int)v;
+    int m = 31 - __builtin_clz(v);
+    return (m - PERF_SUB_BITS + 1) * PERF_SUB + (int)((v >> (m - PERF_SUB_BITS)) & (PERF_SUB - 1));
+}
+
+// 桶上界（含）
+static uint64_t bucket_upper(int idx) {
+    if (idx < 2 * PERF_SUB) return (uint64_t)idx;
+    int m = idx / PERF_SUB + PERF_SUB_BITS - 1;
+    uint64_t s = (uint64_t)(idx % PERF_SUB);
+    return ((PERF_SUB + s + 1) << (m - PERF_SUB_BITS)) - 1;
+}
+
+void perf_record(perf_stage_t stage, uint32_t cycles) {
+    if ((unsigned)stage >= PERF_STAGE_COUNT) return;
+    perf_stat_t *st = &s_stats[stage];
+    portENTER_CRITICAL(&s_lock);
+    if (st->count == 0 || cycles < st->min) st->min = cycles;
+    if (cycles > st->max) st->max = cycles;
+    st->count++;
+    st->sum += cycles;
+    st->hist[bucket_of(cycles)]++;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void perf_reset(void) {
+    portENTER_CRITICAL(&s_lock);
+    memset(s_stats, 0, sizeof(s_stats));
+    portEXIT_CRITICAL(&s_lock);
+}
+
+static uint32_t p99_of(const perf_stat_t *st) {
+    if (st->count == 0) return 0;
+    uint32_t target = st->count - st->count / 100; // ceil(0.99*n) 的近似
+    uint32_t acc = 0;
+    for (int i = 0; i < PERF_BUCKETS; i++) {
+        acc += st->hist[i];
+        if (acc >= target) {
+            uint64_t up = bucket_upper(i);
+            return up < st->max ? (uint32_t)up : st->max;
+        }
+    }
+    return st->max;
+}
+
+int perf_to_json(char *buf, size_t len) {
+    const float mhz = (float)PERF_CPU_MHZ;
+    int n = snprintf(buf, len, "{\"cpu_mhz\":%d,\"unit\":\"us\",\"stages\":{", PERF_CPU_MHZ);
+    for (int i = 0; i < PERF_STAGE_COUNT && n > 0 && (size_t)n < len; i++) {
+        perf_stat_t st;
+        portENTER_CRITICAL(&s_lock);
+        st = s_stats[i];
+        portEXIT_CRITICAL(&s_lock);
+        float avg = st.count ? (float)st.sum / (float)st.count : 0.0f;
+        n += snprintf(buf + n, len - n,
+                      "%s\"%s\":{\"n\":%lu,\"min\":%.1f,\"avg\":%.1f,\"p99\":%.1f,\"max\":%.1f}",
+                      i ? "," : "", STAGE_NAMES[i], (unsigned long)st.count,
+                      st.min / mhz, avg / mhz, p99_of(&st) / mhz, st.max / mhz);
+    }
+    if (n > 0 && (size_t)n < len) n += snprintf(buf + n, len - n, "}}");
+    return n;
+}
+
+#endif
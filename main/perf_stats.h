@@ -0,0 +1,49 @@
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 控制周期分阶段耗时统计（CPU 周期计数 + 固定桶直方图）
+// 置 0 后所有打点宏展开为空，/api/perf 也不注册
+#ifndef PERF_STATS_ENABLE
+#define PERF_STATS_ENABLE 1
+#endif
+
+typedef enum {
+    PERF_STAGE_ADC = 0,   // 读取采集服务缓存（采样与换算在 sensors 任务中）
+    PERF_STAGE_NTC,       // 升降温速率滤波
+    PERF_STAGE_PID,       // pid_compute
+    PERF_STAGE_OUTPUT,    // PWM 更新 + 超温告警
+    PERF_STAGE_OLED,      // OLED 格式化与 I2C 刷新
+    PERF_STAGE_LOG,       // 周期日志（trace 记录）
+    PERF_STAGE_TICK,      // 整个控制周期（不含 vTaskDelay）
+    PERF_STAGE_COUNT
+} perf_stage_t;
+
+#if PERF_STATS_ENABLE
+
+#include "sdkconfig.h"
+
+#include "esp_cpu.h"
+#define PERF_CPU_MHZ CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#define perf_cycle_count() esp_cpu_get_cycle_count()
+
+// 记录一次阶段耗时（周期数）
+void perf_record(perf_stage_t stage, uint32_t cycles);
+// 清空全部统计
+void perf_reset(void);
+// 输出 JSON（count/min/max/avg/p99，单位 CPU 周期与 us），返回写入长度
+int perf_to_json(char *buf, size_t len);
+
+#define PERF_BEGIN(var)       uint32_t var = perf_cycle_count()
+#define PERF_END(stage, var)  perf_record((stage), perf_cycle_count() - (var))
+
+#else
+
+#define PERF_BEGIN(var)       do {} while (0)
+#define PERF_END(stage, var)  do {} while (0)
+
+#endif
+
+#endif
@@ -20,17 +20,17 @@ float pid_compute(PID_t *pid, float input) {
     float error = pid->setpoint - input;
     float dInput = input - pid->last_input;
 
-    // 积分项 (防风饱和: 限制积分)
+    // 积分项 (防风饱和由下方反算法完成)
     pid->integral += pid->Ki * error;
-    if (pid->integral > 100.0) pid->integral = 100.0;
-    if (pid->integral < 0.0) pid->integral = 0.0;
 
     // PID公式
-    float output = pid->Kp * error + pid->integral - pid->Kd * dInput;
+    float raw = pid->Kp * error + pid->integral - pid->Kd * dInput;
 
-    // 限幅0-100%
+    // 限幅0-100%；饱和时按反算法回收积分
+    float output = raw;
     if (output > 100.0) output = 100.0;
     if (output < 0.0) output = 0.0;
+    if (output != raw) pid->integral += PID_AW_GAIN * (output - raw);
 
     pid->last_error = error;
     pid->last_input = input;
@@ -38,4 +38,67 @@ float pid_compute(PID_t *pid, float input) {
     ESP_LOGD(TAG, "PID output: %.2f (Error: %.2f, Integral: %.2f, dInput: %.2f)", output, error, pid->integral, dInput);
 
     return output;
-}
\ No newline at end of file
+}
+
+void pid_bank_init(pid_bank_t *bank, int i, float kp, float ki, float kd, float setpoint) {
+    if (i < 0 || i >= PID_BANK_MAX) return;
+    bank->Kp[i] = kp;
+    bank->Ki[i] = ki;
+    bank->Kd[i] = kd;
+    bank->setpoint[i] = setpoint;
+    bank->out_min[i] = 0.0f;
+    bank->out_max[i] = 100.0f;
+    bank->integral[i] = 0.0f;
+    bank->last_input[i] = 0.0f;
+    bank->last_output[i] = 0.0f;
+}
+
+void pid_bank_track(pid_bank_t *bank, int i, float output, float input) {
+    if (i < 0 || i >= PID_BANK_MAX) return;
+    if (output > bank->out_max[i]) output = bank->out_max[i];
+    if (output < bank->out_min[i]) output = bank->out_min[i];
+    // 积分可超出输出范围（大误差时为负），由反算法约束，不再硬限幅
+    bank->integral[i] = output - bank->Kp[i] * (bank->setpoint[i] - input);
+    bank->last_input[i] = input;     // 微分从当前输入起算，无微分冲击
+    bank->last_output[i] = output;
+}
+
+void pid_bank_retune(pid_bank_t *bank, int i, float kp, float ki, float kd) {
+    if (i < 0 || i >= PID_BANK_MAX) return;
+    bank->Kp[i] = kp;
+    bank->Ki[i] = ki;
+    bank->Kd[i] = kd;
+    // 积分保存的是已乘 Ki 的积分项，Ki 变化只影响此后的累加，无需换算；Kp 变化由积分吸收
+    pid_bank_track(bank, i, bank->last_output[i], bank->last_input[i]);
+}
+
+// 批量计算：热路径不打日志，分支只剩限幅
+void pid_compute_bank(pid_bank_t *bank, uint32_t mask, const float *input, float *output, float dt_ratio) {
+    // 过短/过长的周期会放大微分噪声或积分跳变，折算比例限制在 [0.1, 10]
+    if (!(dt_ratio >= 0.1f)) dt_ratio = 0.1f;
+    if (dt_ratio > 10.0f) dt_ratio = 10.0f;
+    const float inv_dt = 1.0f / dt_ratio;
+    for (int i = 0; i < PID_BANK_MAX; i++) {
+        if (!(mask & (1u << i))) continue;
+        float in = input[i];
+        float error = bank->setpoint[i] - in;
+        float dInput = in - bank->last_input[i];
+        float lo = bank->out_min[i], hi = bank->out_max[i];
+
+        float integral = bank->integral[i] + bank->Ki[i] * error * dt_ratio;
+        float raw = bank->Kp[i] * error + integral - bank->Kd[i] * dInput * inv_dt;
+        float out = raw;
+        if (out > hi) out = hi;
+        if (out < lo) out = lo;
+        // 反算法：限幅量按 dt 比例回收到积分（单周期最多回收到恰好饱和）；积分由此保持有界
+        if (out != raw) {
+            float k = PID_AW_GAIN * dt_ratio;
+            integral += (k < 1.0f ? k : 1.0f) * (out - raw);
+        }
+        bank->integral[i] = integral;
+
+        bank->last_input[i] = in;
+        bank->last_output[i] = out;
+        output[i] = out;
+    }
+}
@@ -20,7 +20,42 @@ void pid_init(PID_t *pid, float kp, float ki, float kd, float setpoint);
 // 计算PID输出 (0-100%)
 float pid_compute(PID_t *pid, float input);
 
-// 时间比例控制窗口 (s)
+// 多温区 PID 组（结构数组布局：同一字段连续存放，便于一个循环批量更新）
+#define PID_BANK_MAX 3
+
+typedef struct {
+    float Kp[PID_BANK_MAX];
+    float Ki[PID_BANK_MAX];
+    float Kd[PID_BANK_MAX];
+    float setpoint[PID_BANK_MAX];
+    float out_min[PID_BANK_MAX];     // 输出下限 (%)
+    float out_max[PID_BANK_MAX];     // 输出上限 (%)
+    float integral[PID_BANK_MAX];    // 积分项（已乘 Ki，单位为输出 %）
+    float last_input[PID_BANK_MAX];
+    float last_output[PID_BANK_MAX]; // 最近一次输出（限幅后），修改增益时据此保持输出连续
+} pid_bank_t;
+
+// 初始化组内第 i 路（限幅 0-100%）
+void pid_bank_init(pid_bank_t *bank, int i, float kp, float ki, float kd, float setpoint);
+
+// 增益按名义周期整定（Ki、Kd 为“每个 200ms 周期”的量），变周期时按 dt 折算
+#define PID_NOMINAL_DT_MS 200
+
+// 抗积分饱和（反算法）：输出被限幅时，每个名义周期把积分向“恰好产生限幅输出”的值回收该比例
+// （跟踪时间常数 Tt = PID_NOMINAL_DT_MS / PID_AW_GAIN）。积分不再硬限幅到输出范围：
+// 大误差时积分可为负以抵消比例项，无扰切换才能在任意误差下成立
+#define PID_AW_GAIN 0.5f
+
+// 批量计算：对 mask 中置位的每一路执行与 pid_compute 相同的算法，结果写入 output[i]
+// dt_ratio = 实际周期 / PID_NOMINAL_DT_MS：积分按 dt 累加，微分按 dInput/dt
+void pid_compute_bank(pid_bank_t *bank, uint32_t mask, const float *input, float *output, float dt_ratio);
+
+// 无扰切换：按当前实际输出 output 与输入反推积分，使下一周期从该输出继续（手动 -> 自动、手动期间跟踪）
+void pid_bank_track(pid_bank_t *bank, int i, float output, float input);
+// 修改增益并保持输出连续：积分按新 Kp 重算，而不是清零
+void pid_bank_retune(pid_bank_t *bank, int i, float kp, float ki, float kd);
+
+// 时间比例控制窗口 (ms)，用于继电器 RELAY_MODE_WINDOW
 #define WINDOW_SIZE 5000  // 5秒窗口
 
 #endif
\ No newline at end of file
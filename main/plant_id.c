@@ -0,0 +1,110 @@
+#include "plant_id.h"
+#include <math.h>
+#include <string.h>
+#include "pid_controller.h"
+
+// 候选纯滞后（采样数），覆盖 0 ~ 20 s
+static const uint8_t DELAYS[PLANT_ID_NDELAY] = { 0, 2, 5, 10, 20 };
+
+#define EXC_ALPHA  (1.0f / 60.0f)       // 激励统计窗口约 60 个采样
+#define ERR_ALPHA  0.02f
+
+static void rls_init(plant_rls_t *r) {
+    memset(r, 0, sizeof(*r));
+    r->theta[0] = 0.99f;        // 缓慢对象的合理先验，收敛前不至于给出荒谬模型
+    for (int i = 0; i < 3; i++) r->P[i][i] = PLANT_ID_P0;
+}
+
+void plant_id_reset(plant_id_t *id) {
+    memset(id, 0, sizeof(*id));
+    for (int i = 0; i < PLANT_ID_NDELAY; i++) rls_init(&id->rls[i]);
+}
+
+void plant_id_resync(plant_id_t *id) {
+    id->primed = false;
+    id->filled = 0;
+}
+
+// 单个候选：先验误差、增益向量、协方差按对称形式更新
+static void rls_step(plant_rls_t *r, const float phi[3], float y) {
+    float Pphi[3];
+    for (int i = 0; i < 3; i++) Pphi[i] = r->P[i][0] * phi[0] + r->P[i][1] * phi[1] + r->P[i][2] * phi[2];
+    float e = y - (r->theta[0] * phi[0] + r->theta[1] * phi[1] + r->theta[2] * phi[2]);
+    float denom = PLANT_ID_LAMBDA + phi[0] * Pphi[0] + phi[1] * Pphi[1] + phi[2] * Pphi[2];
+    float inv = 1.0f / denom;
+    float trace = 0.0f;
+    for (int i = 0; i < 3; i++) {
+        float k = Pphi[i] * inv;
+        r->theta[i] += k * e;
+        for (int j = 0; j <= i; j++) {
+            float p = (r->P[i][j] - k * Pphi[j]) * (1.0f / PLANT_ID_LAMBDA);
+            r->P[i][j] = p;
+            r->P[j][i] = p;
+        }
+        trace += r->P[i][i];
+    }
+    if (trace > PLANT_ID_TRACE_MAX) {
+        float s = PLANT_ID_TRACE_MAX / trace;
+        for (int i = 0; i < 3; i++) for (int j = 0; j < 3; j++) r->P[i][j] *= s;
+    }
+    r->err2 += ERR_ALPHA * (e * e - r->err2);
+}
+
+void plant_id_update(plant_id_t *id, float y, float u) {
+    // 首个采样作为输入均值起点，否则复位后的第一个输入被当作从 0 开始的阶跃激励
+    if (id->samples++ == 0) id->u_mean = u;
+    float du = u - id->u_mean;
+    id->u_mean += EXC_ALPHA * du;
+    id->u_var += EXC_ALPHA * (du * du - id->u_var);
+
+    id->head = (uint8_t)((id->head + 1) % (PLANT_ID_MAX_DELAY + 1));
+    id->u_hist[id->head] = u;
+    if (id->filled < PLANT_ID_MAX_DELAY + 1) id->filled++;
+
+    if (id->primed && id->u_var >= PLANT_ID_EXC_MIN * PLANT_ID_EXC_MIN) {
+        bool any = false;
+        for (int i = 0; i < PLANT_ID_NDELAY; i++) {
+            int d = DELAYS[i];
+            if (d >= id->filled) continue;
+            float phi[3] = { id->y_prev, id->u_hist[(id->head + PLANT_ID_MAX_DELAY + 1 - d) % (PLANT_ID_MAX_DELAY + 1)], 1.0f };
+            rls_step(&id->rls[i], phi, y);
+            any = true;
+        }
+        if (any) id->updates++;
+    }
+    id->y_prev = y;
+    id->primed = true;
+}
+
+void plant_id_model(const plant_id_t *id, plant_model_t *out) {
+    memset(out, 0, sizeof(*out));
+    int best = 0;
+    for (int i = 1; i < PLANT_ID_NDELAY; i++) {
+        if (id->rls[i].err2 < id->rls[best].err2) best = i;
+    }
+    const plant_rls_t *r = &id->rls[best];
+    const float ts = PLANT_ID_TS_MS / 1000.0f;
+    out->a = r->theta[0];
+    out->b = r->theta[1];
+    out->c = r->theta[2];
+    out->dead_s = DELAYS[best] * ts;
+    out->rmse = sqrtf(r->err2);
+    out->excitation = sqrtf(id->u_var);
+    out->samples = id->samples;
+    out->updates = id->updates;
+    // 稳定、正增益的一阶对象才可换算
+    if (!(out->a > 0.0f && out->a < 1.0f && out->b > 0.0f)) return;
+    out->gain = out->b / (1.0f - out->a);
+    out->tau_s = -ts / logf(out->a);
+    out->ambient = out->c / (1.0f - out->a);
+    out->valid = id->updates >= PLANT_ID_MIN_UPDATES;
+
+    // SIMC：tau_c = max(theta, 下限)，Kc = tau / (K (tau_c + theta))，tau_I = min(tau, 4 (tau_c + theta))
+    float tc = out->dead_s > PLANT_ID_TAUC_MIN_S ? out->dead_s : PLANT_ID_TAUC_MIN_S;
+    float kc = out->tau_s / (out->gain * (tc + out->dead_s));
+    float ti = 4.0f * (tc + out->dead_s);
+    if (out->tau_s < ti) ti = out->tau_s;
+    out->kp = kc;
+    out->ki = kc * (PID_NOMINAL_DT_MS / 1000.0f) / ti;
+    out->kd = 0.0f;
+}
@@ -0,0 +1,59 @@
+#ifndef PLANT_ID_H
+#define PLANT_ID_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// 在线对象辨识：递推最小二乘 (RLS) 拟合一阶加纯滞后 ARX 模型
+//   y(k) = a*y(k-1) + b*u(k-1-d) + c        （y 温度 °C，u 输出 %，c 吸收环境温度）
+// 纯滞后 d 无法线性辨识：对若干候选 d 各跑一个 3 参数 RLS，取先验预测误差最小者。每次采样 O(n²)，n = 3
+// 带遗忘因子；输入激励不足（稳态保温时输出几乎不变）时暂停更新，避免协方差发散与参数漂移
+#define PLANT_ID_TS_MS        1000          // 采样周期（输入取周期内时间平均）
+#define PLANT_ID_NDELAY       5             // 候选纯滞后个数（见 plant_id.c）
+#define PLANT_ID_MAX_DELAY    20            // 最大候选纯滞后（采样数）
+#define PLANT_ID_LAMBDA       0.998f        // 遗忘因子：记忆约 1/(1-λ) = 500 个采样
+#define PLANT_ID_P0           1000.0f       // 初始协方差
+#define PLANT_ID_TRACE_MAX    1e5f          // 协方差迹上限（暂停/低激励后防止爆发）
+#define PLANT_ID_EXC_MIN      1.0f          // 输入标准差 (%) 低于此值视为激励不足
+#define PLANT_ID_MIN_UPDATES  120           // 有效更新次数达到后模型才给出建议
+#define PLANT_ID_TAUC_MIN_S   10.0f         // SIMC 闭环时间常数下限 (s)
+
+typedef struct {
+    float theta[3];             // a, b, c
+    float P[3][3];
+    float err2;                 // 先验预测误差平方的滑动平均
+} plant_rls_t;
+
+typedef struct {
+    plant_rls_t rls[PLANT_ID_NDELAY];
+    float u_hist[PLANT_ID_MAX_DELAY + 1];   // 最近的采样输入，u_hist[head] 为最新
+    uint8_t head;
+    uint8_t filled;             // 历史中有效个数
+    bool primed;                // 已有上一采样 y(k-1)
+    float y_prev;
+    float u_mean, u_var;        // 输入激励（滑动均值/方差）
+    uint32_t samples, updates;
+} plant_id_t;
+
+// 当前模型与建议参数（SIMC PI，Ki/Kd 按 PID_NOMINAL_DT_MS 折算，可直接写入 PID）
+typedef struct {
+    bool valid;
+    float a, b, c;
+    float gain;                 // 稳态增益 K (°C/%)
+    float tau_s;                // 时间常数 (s)
+    float dead_s;               // 纯滞后 (s)
+    float ambient;              // c / (1 - a)：零输出时的平衡温度 (°C)
+    float rmse;                 // 一步预测误差 (°C)
+    float excitation;           // 输入标准差 (%)
+    uint32_t samples, updates;
+    float kp, ki, kd;
+} plant_model_t;
+
+void plant_id_reset(plant_id_t *id);
+// 数据中断（温区停止后重新启动）：保留参数与协方差，只清除历史
+void plant_id_resync(plant_id_t *id);
+// 每个采样周期调用：y 为当前温度，u 为上一采样周期内的平均输出
+void plant_id_update(plant_id_t *id, float y, float u);
+void plant_id_model(const plant_id_t *id, plant_model_t *out);
+
+#endif
@@ -0,0 +1,170 @@
+#include "safety.h"
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "../Hardware/hal.h"
+#include "../Hardware/relay.h"
+#include "../Hardware/temperature.h"
+#include "../Hardware/sensors.h"
+#include "../Hardware/buzzer.h"
+#include "../Hardware/rgb.h"
+
+static const char *TAG = "SAFETY";
+
+static TaskHandle_t s_task = NULL;
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static safety_status_t s_st = { .zone = -1 };
+static volatile bool s_latched = false;
+static volatile bool s_ack_req = false;
+static int s_bad_samples = 0;
+static int64_t s_first_bad_us = 0;
+
+// 定时器回调只做通知
+static void safety_tick(void *arg) {
+    (void)arg;
+    if (s_task) xTaskNotifyGive(s_task);
+}
+
+// 单个温度通道：传感器故障或超过 limit (+余量) 时返回故障位，t 为读数
+static uint32_t check_channel(int ch, float limit, float *t) {
+    *t = 0.0f;
+    if (ch >= SENSOR_SRC_ID(0)) {
+        sensor_reading_t r;
+        if (!sensors_get(ch, &r) || hal_time_us() - r.t_us > SAFETY_SRC_STALE_MS * 1000LL) return SAFETY_FAULT_SENSOR;
+        *t = r.value;
+    } else {
+        int raw = hal_adc_read_raw(ch);
+        int mv = hal_adc_raw_to_mv(raw);
+        if (mv < SAFETY_SENSOR_MIN_MV || mv > SAFETY_SENSOR_MAX_MV) return SAFETY_FAULT_SENSOR;
+        *t = temperature_from_raw(raw);
+    }
+    if (!temperature_valid(*t)) return SAFETY_FAULT_SENSOR;
+    if (*t > limit + SAFETY_OVERTEMP_MARGIN_C) return SAFETY_FAULT_OVERTEMP;
+    return 0;
+}
+
+// 单次检查：返回当前故障位，并给出首个故障温区与温度（级联温区另查元件 NTC，按 element_max 判超温）
+static uint32_t safety_check(int *zone, float *temp) {
+    uint32_t faults = 0;
+    *zone = -1;
+    *temp = 0.0f;
+    for (int z = 0; z < zone_bank_count(); z++) {
+        float t;
+        uint32_t f = check_channel(zone_bank_adc_channel(z), zone_bank_max_temp(z), &t);
+        int ech = zone_bank_element_channel(z);
+        if (!f && ech >= 0) f = check_channel(ech, zone_bank_element_max(z), &t);
+        if (f && *zone < 0) {
+            *zone = z;
+            *temp = t;
+        }
+        faults |= f;
+    }
+    if (zone_bank_active_mask() && hal_time_us() - zone_bank_heartbeat_us() > SAFETY_CTRL_STALL_MS * 1000LL) {
+        faults |= SAFETY_FAULT_CTRL_STALL;
+    }
+    return faults;
+}
+
+// 切断：先关输出（时间关键），再停温区、记录与告警
+static void safety_trip(uint32_t faults, int zone, float temp) {
+    relay_safety_cutoff();
+    uint32_t latency = (uint32_t)(hal_time_us() - s_first_bad_us);
+    s_latched = true;
+    for (int z = 0; z < zone_bank_count(); z++) zone_bank_stop(z);
+
+    portENTER_CRITICAL(&s_lock);
+    s_st.latched = true;
+    s_st.faults = faults;
+    s_st.zone = zone;
+    s_st.temp = temp;
+    s_st.trips++;
+    s_st.last_latency_us = latency;
+    if (latency > s_st.max_latency_us) s_st.max_latency_us = latency;
+    portEXIT_CRITICAL(&s_lock);
+
+    set_rgb(255, 0, 0);
+    ESP_LOGE(TAG, "heater cut off: faults=0x%lx zone=%d temp=%.1f latency=%luus",
+             (unsigned long)faults, zone, temp, (unsigned long)latency);
+}
+
+static void safety_task(void *arg) {
+    (void)arg;
+    if (hal_wdt_add_self() != ESP_OK) ESP_LOGW(TAG, "task watchdog registration failed");
+    for (;;) {
+        // 定时器失效时按两倍周期自行计时，检查不停
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SAFETY_PERIOD_US * 2 / 1000));
+        hal_wdt_feed();
+
+        int64_t t0 = hal_time_us();
+        int zone;
+        float temp;
+        uint32_t faults = safety_check(&zone, &temp);
+
+        if (!s_latched) {
+            if (faults) {
+                if (s_bad_samples++ == 0) s_first_bad_us = t0;
+                if (s_bad_samples >= SAFETY_TRIP_SAMPLES) safety_trip(faults, zone, temp);
+            } else {
+                s_bad_samples = 0;
+            }
+        } else if (s_ack_req && !faults) {
+            s_ack_req = false;
+            s_latched = false;
+            s_bad_samples = 0;
+            relay_safety_release();
+            buzzer_set(false);
+            ESP_LOGW(TAG, "fault acknowledged, heater outputs released (zones stay stopped)");
+        } else {
+            // 锁存期间：每周期重新切断（覆盖其它任务并发写输出的竞争），蜂鸣 1s 内响 250ms
+            s_ack_req = false;
+            relay_safety_cutoff();
+            buzzer_set((t0 / 1000) % 1000 < 250);
+        }
+
+        uint32_t dt = (uint32_t)(hal_time_us() - t0);
+        portENTER_CRITICAL(&s_lock);
+        s_st.latched = s_latched;
+        s_st.active = faults;
+        s_st.checks++;
+        if (dt > s_st.max_check_us) s_st.max_check_us = dt;
+        portEXIT_CRITICAL(&s_lock);
+    }
+}
+
+void safety_init(void) {
+    if (s_task) return;
+    xTaskCreate(safety_task, "safety", 3072, NULL, SAFETY_TASK_PRIO, &s_task);
+    if (hal_timer_start_periodic("safety", SAFETY_PERIOD_US, safety_tick, NULL, NULL) != ESP_OK) {
+        ESP_LOGE(TAG, "timer create failed, falling back to tick-based period");
+    }
+    ESP_LOGI(TAG, "supervisor: period %dus, cutoff bound %dus, %d zones",
+             SAFETY_PERIOD_US, SAFETY_CUTOFF_BOUND_US, zone_bank_count());
+}
+
+bool safety_latched(void) { return s_latched; }
+
+esp_err_t safety_ack(void) {
+    if (!s_latched) return ESP_OK;
+    safety_status_t st;
+    safety_get_status(&st);
+    if (st.active) return ESP_ERR_INVALID_STATE;
+    s_ack_req = true;
+    return ESP_OK;
+}
+
+void safety_get_status(safety_status_t *out) {
+    portENTER_CRITICAL(&s_lock);
+    *out = s_st;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+const char *safety_fault_name(uint32_t bit) {
+    switch (bit) {
+    case SAFETY_FAULT_OVERTEMP:   return "overtemp";
+    case SAFETY_FAULT_SENSOR:     return "sensor";
+    case SAFETY_FAULT_CTRL_STALL: return "ctrl_stall";
+    default:                      return "?";
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef SAFETY_H
+#define SAFETY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "zone_bank.h"
+
+// 独立热安全监控：最高优先级任务，由 SAFETY_PERIOD_US 定时器唤醒，自行对各温区 NTC（级联温区含元件 NTC）做单次转换
+// （不经采集缓存），检查超温、传感器开路/短路与控制任务停滞。连续 SAFETY_TRIP_SAMPLES 次异常即切断
+// 全部加热输出、停止全部温区并锁存，条件消失并确认后才解除。任务注册任务看门狗，自身停滞由看门狗复位兜底
+#define SAFETY_PERIOD_US          5000
+#define SAFETY_TRIP_SAMPLES       2
+// 最坏切断延迟：异常出现到输出关断 ≤ SAFETY_TRIP_SAMPLES 个周期（另加一次检查耗时，数十 µs）
+#define SAFETY_CUTOFF_BOUND_US    (SAFETY_PERIOD_US * SAFETY_TRIP_SAMPLES)
+#define SAFETY_TASK_PRIO          (configMAX_PRIORITIES - 1)
+
+// 超温切断点 = 温区告警阈值 max_temp + 余量（红灯/蜂鸣告警先于切断）
+#define SAFETY_OVERTEMP_MARGIN_C  5.0f
+// NTC 分压有效电压范围 (mV)，之外视为开路/短路
+#define SAFETY_SENSOR_MIN_MV      30
+#define SAFETY_SENSOR_MAX_MV      3250
+// 外部温度源（热电偶，SPI 事务只由采集任务发起）改查采集缓存：读数超过该时间未更新视为传感器故障
+#define SAFETY_SRC_STALE_MS       1000
+// 有运行/手动温区时，控制任务心跳超过该时间未更新视为停滞
+#define SAFETY_CTRL_STALL_MS      (ZONE_TICK_MAX_MS * 3)
+
+#define SAFETY_FAULT_OVERTEMP     (1u << 0)
+#define SAFETY_FAULT_SENSOR       (1u << 1)
+#define SAFETY_FAULT_CTRL_STALL   (1u << 2)
+
+typedef struct {
+    bool latched;
+    uint32_t faults;            // 锁存时的故障位
+    uint32_t active;            // 最近一次检查仍存在的故障位
+    int zone;                   // 触发温区（控制停滞为 -1）
+    float temp;                 // 触发时温度 (°C)
+    uint32_t trips;
+    uint32_t last_latency_us;   // 首个异常采样到切断完成
+    uint32_t max_latency_us;
+    uint32_t max_check_us;      // 单次检查耗时最大值
+    uint32_t checks;
+} safety_status_t;
+
+// 在温区注册之后调用
+void safety_init(void);
+bool safety_latched(void);
+// 确认并解除锁存：故障条件仍存在时返回 ESP_ERR_INVALID_STATE；解除由监控任务在下一周期执行，温区保持停止
+esp_err_t safety_ack(void);
+void safety_get_status(safety_status_t *out);
+const char *safety_fault_name(uint32_t bit);
+
+#endif
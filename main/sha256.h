@@ -0,0 +1,25 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// SHA-256（FIPS 180-4）增量计算：固件 OTA 流式校验与主机端上传工具共用
+#define SHA256_DIGEST_SIZE 32
+
+typedef struct {
+    uint32_t state[8];
+    uint64_t total;         // 已输入字节数
+    uint8_t block[64];
+    size_t fill;            // block 中待处理字节数
+} sha256_ctx_t;
+
+void sha256_init(sha256_ctx_t *ctx);
+void sha256_update(sha256_ctx_t *ctx, const void *data, size_t len);
+void sha256_final(sha256_ctx_t *ctx, uint8_t out[SHA256_DIGEST_SIZE]);
+
+// 十六进制（64 字符）互转；解析失败返回 -1
+int sha256_from_hex(const char *hex, uint8_t out[SHA256_DIGEST_SIZE]);
+void sha256_to_hex(const uint8_t digest[SHA256_DIGEST_SIZE], char out[SHA256_DIGEST_SIZE * 2 + 1]);
+
+#endif
@@ -0,0 +1,157 @@
+#include "sys_stats.h"
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "../Hardware/hal.h"
+
+#include "esp_heap_caps.h"
+#if CONFIG_LWIP_STATS
+#include "lwip/stats.h"
+#include "lwip/memp.h"
+#endif
+
+static const char *TAG = "SYS";
+
+#if configUSE_TRACE_FACILITY
+// 上次查询的各任务累计运行时间，用于计算区间 CPU 占用
+typedef struct {
+    TaskHandle_t handle;
+    uint32_t runtime;
+} task_prev_t;
+
+static TaskStatus_t s_status[SYS_STATS_MAX_TASKS];
+static task_prev_t s_prev[SYS_STATS_MAX_TASKS];
+static int s_prev_count = 0;
+static uint32_t s_prev_total = 0;
+static SemaphoreHandle_t s_lock = NULL;   // 快照缓冲与上次运行时间由 HTTP 与 dump 任务共用
+
+static uint32_t prev_runtime(TaskHandle_t h) {
+    for (int i = 0; i < s_prev_count; i++) {
+        if (s_prev[i].handle == h) return s_prev[i].runtime;
+    }
+    return 0;
+}
+
+static const char *state_name(eTaskState st) {
+    switch (st) {
+    case eRunning:   return "run";
+    case eReady:     return "ready";
+    case eBlocked:   return "blocked";
+    case eSuspended: return "suspended";
+    case eDeleted:   return "deleted";
+    default:         return "?";
+    }
+}
+
+static int tasks_to_json(char *buf, size_t len) {
+    uint32_t total = 0;
+    if (s_lock) xSemaphoreTake(s_lock, portMAX_DELAY);
+    UBaseType_t n = uxTaskGetSystemState(s_status, SYS_STATS_MAX_TASKS, &total);
+#if configGENERATE_RUN_TIME_STATS
+    uint32_t dt_total = total - s_prev_total;
+#endif
+    int w = snprintf(buf, len, "\"tasks\":[");
+    for (UBaseType_t i = 0; i < n && w > 0 && (size_t)w < len; i++) {
+        const TaskStatus_t *t = &s_status[i];
+        float cpu = 0.0f;
+#if configGENERATE_RUN_TIME_STATS
+        if (dt_total) cpu = 100.0f * (float)(t->ulRunTimeCounter - prev_runtime(t->xHandle)) / (float)dt_total;
+#endif
+        w += snprintf(buf + w, len - w,
+                      "%s{\"name\":\"%s\",\"prio\":%u,\"state\":\"%s\",\"cpu\":%.1f,\"stack_free\":%u}",
+                      i ? "," : "", t->pcTaskName, (unsigned)t->uxCurrentPriority, state_name(t->eCurrentState),
+                      cpu, (unsigned)t->usStackHighWaterMark);
+    }
+    // 记录本次快照
+    s_prev_count = (int)n;
+    for (UBaseType_t i = 0; i < n; i++) {
+        s_prev[i].handle = s_status[i].xHandle;
+#if configGENERATE_RUN_TIME_STATS
+        s_prev[i].runtime = s_status[i].ulRunTimeCounter;
+#endif
+    }
+    s_prev_total = total;
+    if (s_lock) xSemaphoreGive(s_lock);
+    if (w > 0 && (size_t)w < len) w += snprintf(buf + w, len - w, "],");
+    return w;
+}
+#endif
+
+static int heap_to_json(char *buf, size_t len, const char *name, uint32_t caps, bool comma) {
+    multi_heap_info_t info;
+    heap_caps_get_info(&info, caps);
+    size_t free_b = info.total_free_bytes;
+    // 碎片率：1 - 最大块/总空闲
+    float frag = free_b ? 100.0f * (1.0f - (float)info.largest_free_block / (float)free_b) : 0.0f;
+    return snprintf(buf, len, "%s\"%s\":{\"free\":%u,\"min_free\":%u,\"largest\":%u,\"frag\":%.1f}",
+                    comma ? "," : "", name, (unsigned)free_b, (unsigned)info.minimum_free_bytes,
+                    (unsigned)info.largest_free_block, frag);
+}
+
+int sys_stats_to_json(char *buf, size_t len) {
+    int w = snprintf(buf, len, "{\"uptime_ms\":%lu,", (unsigned long)(hal_time_us() / 1000));
+#if configUSE_TRACE_FACILITY
+    if (w > 0 && (size_t)w < len) w += tasks_to_json(buf + w, len - w);
+#endif
+    if (w > 0 && (size_t)w < len) w += snprintf(buf + w, len - w, "\"heap\":{");
+    if (w > 0 && (size_t)w < len) w += heap_to_json(buf + w, len - w, "8bit", MALLOC_CAP_8BIT, false);
+    if (w > 0 && (size_t)w < len) w += heap_to_json(buf + w, len - w, "internal", MALLOC_CAP_INTERNAL, true);
+    if (w > 0 && (size_t)w < len) w += heap_to_json(buf + w, len - w, "dma", MALLOC_CAP_DMA, true);
+    if (w > 0 && (size_t)w < len) w += snprintf(buf + w, len - w, "},");
+    // Wi-Fi 驱动不公开缓冲占用，这里给出配置值；实际压力体现在 internal 堆的 min_free 上
+    if (w > 0 && (size_t)w < len) {
+        w += snprintf(buf + w, len - w, "\"wifi_buf\":{\"static_rx\":%d,\"dynamic_rx\":%d,\"dynamic_tx\":%d},",
+                      CONFIG_ESP32_WIFI_STATIC_RX_BUFFER_NUM, CONFIG_ESP32_WIFI_DYNAMIC_RX_BUFFER_NUM,
+                      CONFIG_ESP32_WIFI_DYNAMIC_TX_BUFFER_NUM);
+    }
+#if CONFIG_LWIP_STATS
+    static const struct { const char *name; int idx; } POOLS[] = {
+        { "tcp_pcb", MEMP_TCP_PCB }, { "tcp_seg", MEMP_TCP_SEG }, { "udp_pcb", MEMP_UDP_PCB },
+        { "netconn", MEMP_NETCONN }, { "netbuf", MEMP_NETBUF }, { "pbuf", MEMP_PBUF },
+    };
+    if (w > 0 && (size_t)w < len) w += snprintf(buf + w, len - w, "\"lwip\":{");
+    for (size_t i = 0; i < sizeof(POOLS) / sizeof(POOLS[0]) && w > 0 && (size_t)w < len; i++) {
+        const struct stats_mem *m = lwip_stats.memp[POOLS[i].idx];
+        w += snprintf(buf + w, len - w, "%s\"%s\":{\"used\":%u,\"max\":%u,\"err\":%u}", i ? "," : "",
+                      POOLS[i].name, m ? (unsigned)m->used : 0u, m ? (unsigned)m->max : 0u, m ? (unsigned)m->err : 0u);
+    }
+    if (w > 0 && (size_t)w < len) w += snprintf(buf + w, len - w, "},");
+#endif
+    if (w > 0 && (size_t)w < len) {
+        // 去掉末尾逗号
+        if (buf[w - 1] == ',') w--;
+        w += snprintf(buf + w, len - w, "}");
+    }
+    return w;
+}
+
+static uint32_t s_dump_ms = 0;
+static TaskHandle_t s_dump_task = NULL;
+
+static void sys_dump_task(void *arg) {
+    static char buf[2048];
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(s_dump_ms ? s_dump_ms : 1000));
+        if (!s_dump_ms) continue;
+        sys_stats_to_json(buf, sizeof(buf));
+        ESP_LOGI(TAG, "%s", buf);
+    }
+}
+
+void sys_stats_init(uint32_t dump_interval_ms) {
+#if configUSE_TRACE_FACILITY
+    if (!s_lock) s_lock = xSemaphoreCreateMutex();
+#endif
+    sys_stats_start_dump(dump_interval_ms);
+}
+
+void sys_stats_start_dump(uint32_t interval_ms) {
+    s_dump_ms = interval_ms;
+    if (interval_ms && !s_dump_task) {
+        xTaskCreate(sys_dump_task, "sys_dump", 3072, NULL, 1, &s_dump_task);
+    }
+}
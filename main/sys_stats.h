@@ -0,0 +1,20 @@
+#ifndef SYS_STATS_H
+#define SYS_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// 系统运行状态：各任务 CPU 占用（两次查询之间的区间）、栈余量，各能力堆的空闲/历史最低/最大块，
+// lwIP 内存池占用。只在查询时遍历，平时无额外开销（依赖 sdkconfig 打开 trace facility 与 run-time stats）
+#define SYS_STATS_MAX_TASKS 24
+
+// 启动时调用一次；dump_interval_ms > 0 时同时开启周期输出
+void sys_stats_init(uint32_t dump_interval_ms);
+
+// 输出 JSON，返回写入长度；CPU 占用为与上一次查询（任意调用方）之间的区间值
+int sys_stats_to_json(char *buf, size_t len);
+
+// 周期性把摘要输出到控制台（UART0）；interval_ms = 0 关闭
+void sys_stats_start_dump(uint32_t interval_ms);
+
+#endif
@@ -0,0 +1,103 @@
+#include "telemetry.h"
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "../Hardware/hal.h"
+#include "../Hardware/uart.h"
+#include "../Hardware/sensors.h"
+#include "../Hardware/temperature.h"
+#include "telemetry_frame.h"
+#include "zone_bank.h"
+
+static const char *TAG = "TELEM";
+
+static TaskHandle_t s_task = NULL;
+static hal_timer_t s_timer = NULL;
+static volatile uint32_t s_rate_hz = 0;
+static uint16_t s_seq = 0;
+static uint32_t s_sent = 0;
+static uint32_t s_dropped = 0;
+static uint32_t s_bytes = 0;
+
+// 定时器回调只做通知，采样与编码在发送任务中完成
+static void telemetry_tick(void *arg) {
+    (void)arg;
+    if (s_task) xTaskNotifyGive(s_task);
+}
+
+static void telemetry_task(void *arg) {
+    uint8_t pkt[TELEM_MAX_PACKET];
+    uint8_t frame[TELEM_MAX_FRAME];
+    for (;;) {
+        uint32_t ticks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!s_rate_hz || ticks == 0) continue;
+        // 积压的通知说明上一帧期间错过了采样点：计入丢弃，seq 跳过以便接收端发现
+        s_dropped += ticks - 1;
+        s_seq += (uint16_t)(ticks - 1);
+
+        int nz = zone_bank_count();
+        if (nz > TELEM_MAX_ZONES) nz = TELEM_MAX_ZONES;
+        telem_hdr_t hdr = {
+            .type = TELEM_TYPE_SAMPLE,
+            .nzones = (uint8_t)nz,
+            .seq = s_seq++,
+            .ts_us = (uint32_t)hal_time_us(),
+        };
+        memcpy(pkt, &hdr, sizeof(hdr));
+        size_t len = sizeof(hdr);
+        for (int z = 0; z < nz; z++) {
+            zone_status_t st;
+            sensor_reading_t r;
+            zone_bank_get_status(z, &st);
+            // 温度取采集缓存（比控制周期更新更快）；遥测不直接访问 ADC
+            bool ok = sensors_get(zone_bank_adc_channel(z), &r) && temperature_valid(r.value);
+            telem_zone_t zs;
+            telem_zone_fill(&zs, r.raw, r.value, ok, st.output, st.running);
+            memcpy(pkt + len, &zs, sizeof(zs));
+            len += sizeof(zs);
+        }
+        size_t flen = telem_frame_encode(pkt, len, frame);
+        int w = uart_write(frame, flen);
+        if (w == (int)flen) {
+            s_sent++;
+            s_bytes += flen;
+        } else {
+            s_dropped++;
+        }
+    }
+}
+
+void telemetry_start(uint32_t rate_hz, int baud) {
+    if (rate_hz > TELEMETRY_MAX_HZ) rate_hz = TELEMETRY_MAX_HZ;
+    if (baud > 0 && baud != uart_get_baud()) uart_set_baud(baud);
+    if (!s_task) {
+        xTaskCreate(telemetry_task, "telemetry", 3072, NULL, 4, &s_task);
+    }
+    if (!s_timer) {
+        if (hal_timer_start_periodic("telemetry", 0, telemetry_tick, NULL, &s_timer) != ESP_OK) {
+            ESP_LOGE(TAG, "timer create failed");
+            return;
+        }
+    }
+    s_rate_hz = rate_hz;
+    hal_timer_set_period(s_timer, rate_hz ? 1000000u / rate_hz : 0);
+    // 按 10 bit/字节、COBS 最坏开销估算链路占用，超出波特率时提示会丢帧
+    size_t pkt = sizeof(telem_hdr_t) + (size_t)zone_bank_count() * sizeof(telem_zone_t) + 2;
+    uint32_t need_bps = rate_hz * (uint32_t)(pkt + pkt / 254 + 2) * 10u;
+    if (rate_hz && need_bps > (uint32_t)uart_get_baud()) {
+        ESP_LOGW(TAG, "%lu Hz may exceed %d baud (worst case %lu bps)", (unsigned long)rate_hz, uart_get_baud(), (unsigned long)need_bps);
+    }
+    ESP_LOGI(TAG, "telemetry %lu Hz @ %d baud", (unsigned long)rate_hz, uart_get_baud());
+}
+
+void telemetry_stop(void) { telemetry_start(0, 0); }
+
+void telemetry_get_stats(telemetry_stats_t *out) {
+    out->rate_hz = s_rate_hz;
+    out->baud = uart_get_baud();
+    out->sent = s_sent;
+    out->dropped = s_dropped;
+    out->bytes = s_bytes;
+}
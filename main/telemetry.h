@@ -0,0 +1,23 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+// UART1 高速二进制遥测：定时器按 rate_hz 唤醒发送任务，每个采样点一帧（格式见 telemetry_frame.h）
+// 帧写入 UART 驱动 TX 环形缓冲后立即返回；发送任务来不及处理的采样点计为丢弃（seq 仍递增）
+#define TELEMETRY_MAX_HZ  2000
+
+typedef struct {
+    uint32_t rate_hz;       // 0 = 停止
+    int baud;
+    uint32_t sent;          // 已发送帧数
+    uint32_t dropped;       // 丢弃的采样点
+    uint32_t bytes;         // 已发送字节
+} telemetry_stats_t;
+
+// 启动/调整遥测；rate_hz = 0 停止，baud <= 0 保持当前波特率
+void telemetry_start(uint32_t rate_hz, int baud);
+void telemetry_stop(void);
+void telemetry_get_stats(telemetry_stats_t *out);
+
+#endif
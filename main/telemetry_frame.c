@@ -0,0 +1,91 @@
+// 遥测帧编解码：COBS + CRC16，纯 C，不依赖 ESP-IDF
+#include "telemetry_frame.h"
+#include <math.h>
+#include <string.h>
+
+// 四舍五入并饱和到 [lo, hi]；浮点超出目标整型范围时直接转换是未定义行为
+static long fixed_sat(float v, float scale, long lo, long hi) {
+    if (isnan(v)) return 0;
+    float x = v * scale;
+    if (x <= (float)lo) return lo;
+    if (x >= (float)hi) return hi;
+    return (long)(x < 0.0f ? x - 0.5f : x + 0.5f);
+}
+
+void telem_zone_fill(telem_zone_t *zs, int adc_raw, float temp, bool temp_valid, float output, bool running) {
+    zs->adc_raw = (uint16_t)adc_raw;
+    zs->temp_c10 = temp_valid ? (int16_t)fixed_sat(temp, 10.0f, INT16_MIN, INT16_MAX) : 0;
+    zs->output_c100 = (uint16_t)fixed_sat(output, 100.0f, 0, UINT16_MAX);
+    zs->flags = (running ? TELEM_ZONE_RUNNING : 0) | (temp_valid ? 0 : TELEM_ZONE_SENSOR_FAULT);
+}
+
+uint16_t telem_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t telem_cobs_encode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t code_pos = 0, o = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] == 0) {
+            out[code_pos] = code;
+            code_pos = o++;
+            code = 1;
+        } else {
+            out[o++] = in[i];
+            if (++code == 0xFF) {
+                out[code_pos] = code;
+                code_pos = o++;
+                code = 1;
+            }
+        }
+    }
+    out[code_pos] = code;
+    out[o++] = 0x00;
+    return o;
+}
+
+size_t telem_cobs_decode(const uint8_t *in, size_t len, uint8_t *out, size_t out_len) {
+    size_t i = 0, o = 0;
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > len) return 0;
+        for (uint8_t k = 1; k < code; k++) {
+            if (o >= out_len || in[i] == 0) return 0;
+            out[o++] = in[i++];
+        }
+        if (code != 0xFF && i < len) {
+            if (o >= out_len) return 0;
+            out[o++] = 0;
+        }
+    }
+    return o;
+}
+
+size_t telem_frame_encode(const uint8_t *pkt, size_t len, uint8_t *frame) {
+    uint8_t buf[TELEM_MAX_PACKET];
+    if (len + 2 > sizeof(buf)) return 0;
+    memcpy(buf, pkt, len);
+    uint16_t crc = telem_crc16(pkt, len);
+    buf[len] = (uint8_t)(crc & 0xFF);
+    buf[len + 1] = (uint8_t)(crc >> 8);
+    return telem_cobs_encode(buf, len + 2, frame);
+}
+
+size_t telem_frame_decode(const uint8_t *frame, size_t len, uint8_t *pkt, size_t pkt_len) {
+    uint8_t buf[TELEM_MAX_PACKET];
+    size_t n = telem_cobs_decode(frame, len, buf, sizeof(buf));
+    if (n < 3) return 0;
+    n -= 2;
+    uint16_t crc = (uint16_t)(buf[n] | (buf[n + 1] << 8));
+    if (crc != telem_crc16(buf, n) || n > pkt_len) return 0;
+    memcpy(pkt, buf, n);
+    return n;
+}
@@ -0,0 +1,77 @@
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// UART 遥测帧（固件与主机接收工具 Tools/telemetry 共用）
+// 线上格式：COBS(包 + CRC16) + 0x00 分隔；包 = 包头 + nzones 个温区样本，均为小端
+#define TELEM_TYPE_SAMPLE    4    // 温区样本（类型 1 为旧格式：温度 x100、无故障位，已停用）
+#define TELEM_TYPE_CAP_TICK  2    // 控制输入捕获（capture.h）：每个控制周期一帧
+#define TELEM_TYPE_CAP_STATE 3    // 控制输入捕获：某温区 PID 参数/状态（开始捕获、参数修改、启动时）
+#define TELEM_MAX_ZONES   8
+
+typedef struct __attribute__((packed)) {
+    uint8_t type;          // TELEM_TYPE_SAMPLE
+    uint8_t nzones;
+    uint16_t seq;          // 每个采样点 +1（含被丢弃的），接收端据此统计丢包
+    uint32_t ts_us;        // 采样时刻（启动以来微秒，32 位回绕）
+} telem_hdr_t;
+
+#define TELEM_ZONE_RUNNING      0x01
+#define TELEM_ZONE_SENSOR_FAULT 0x02    // 采集缓存无效（开路/短路/温度源故障），temp_c10 为 0
+
+typedef struct __attribute__((packed)) {
+    uint16_t adc_raw;      // 采集缓存中的原始值（温度源为原始帧低 16 位）
+    int16_t temp_c10;      // 采集缓存温度 x10 (°C)，饱和到 int16 范围
+    uint16_t output_c100;  // 控制环最近输出 x100 (%)
+    uint8_t flags;         // TELEM_ZONE_*
+} telem_zone_t;
+
+// 捕获帧与样本帧共用 UART 链路；两类捕获帧共用一个 seq，回放端据此发现丢帧
+typedef struct __attribute__((packed)) {
+    uint8_t type;          // TELEM_TYPE_CAP_TICK
+    uint8_t mask;          // 本周期参与计算的温区，其后按位序每个温区一个 telem_cap_zone_t
+    uint16_t seq;
+    uint32_t ts_us;
+    float dt_ratio;        // 传给 pid_compute_bank 的周期折算比例
+} telem_cap_tick_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t adc_raw;      // 采集缓存中的原始值
+    float temp;            // pid_compute_bank 的输入（原样 float，回放逐位一致）
+    float output;          // 固件计算结果 (%)
+} telem_cap_zone_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t type;          // TELEM_TYPE_CAP_STATE
+    uint8_t zone;
+    uint16_t seq;
+    uint32_t ts_us;
+    float kp, ki, kd, setpoint;
+    float out_min, out_max;
+    float integral, last_input;
+} telem_cap_state_t;
+
+#define TELEM_SAMPLE_MAX  (sizeof(telem_hdr_t) + TELEM_MAX_ZONES * sizeof(telem_zone_t))
+#define TELEM_CAP_TICK_MAX (sizeof(telem_cap_tick_t) + TELEM_MAX_ZONES * sizeof(telem_cap_zone_t))
+#define TELEM_MAX_PACKET ((TELEM_CAP_TICK_MAX > TELEM_SAMPLE_MAX ? TELEM_CAP_TICK_MAX : TELEM_SAMPLE_MAX) + 2)
+// COBS 最坏开销：每 254 字节 +1，再加首字节与 0x00 分隔
+#define TELEM_MAX_FRAME  (TELEM_MAX_PACKET + TELEM_MAX_PACKET / 254 + 2)
+
+// 填写温区样本：温度/输出按定点饱和换算（NaN 为 0），temp_valid 为 false 时置故障位
+void telem_zone_fill(telem_zone_t *zs, int adc_raw, float temp, bool temp_valid, float output, bool running);
+
+// CRC-16/CCITT-FALSE（多项式 0x1021，初值 0xFFFF）
+uint16_t telem_crc16(const uint8_t *data, size_t len);
+// COBS 编码并追加 0x00 分隔，返回帧长度；out 至少 len + len/254 + 2 字节
+size_t telem_cobs_encode(const uint8_t *in, size_t len, uint8_t *out);
+// COBS 解码（输入不含 0x00 分隔），格式错误返回 0
+size_t telem_cobs_decode(const uint8_t *in, size_t len, uint8_t *out, size_t out_len);
+// 包 -> 帧：追加 CRC 后编码，返回帧长度
+size_t telem_frame_encode(const uint8_t *pkt, size_t len, uint8_t *frame);
+// 帧（不含分隔）-> 包：解码并校验 CRC，成功返回包长度（不含 CRC），失败返回 0
+size_t telem_frame_decode(const uint8_t *frame, size_t len, uint8_t *pkt, size_t pkt_len);
+
+#endif
@@ -0,0 +1,121 @@
+#include "trace.h"
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "../Hardware/hal.h"
+
+static const char *TAG = "TRACE";
+
+uint8_t g_trace_level[TRACE_MOD_COUNT] = {
+    [TRACE_MOD_TEMP]  = TRACE_LVL_INFO,
+    [TRACE_MOD_PID]   = TRACE_LVL_INFO,
+    [TRACE_MOD_BATT]  = TRACE_LVL_INFO,
+    [TRACE_MOD_RELAY] = TRACE_LVL_INFO,
+    [TRACE_MOD_SYS]   = TRACE_LVL_INFO,
+};
+
+static trace_rec_t s_ring[TRACE_RING_SIZE];
+static uint32_t s_head = 0;        // 累计写入条数（槽位 = s_head % SIZE）
+static uint32_t s_tail = 0;        // drain 已消费位置
+static uint32_t s_dropped = 0;     // 被覆盖、未经 drain 输出的条数
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool s_console = true;
+
+void trace_emit(uint16_t id, const uint32_t *args, uint8_t nargs) {
+    if (nargs > TRACE_MAX_ARGS) nargs = TRACE_MAX_ARGS;
+    uint32_t ts = (uint32_t)hal_time_us();
+    portENTER_CRITICAL(&s_lock);
+    trace_rec_t *r = &s_ring[s_head & (TRACE_RING_SIZE - 1)];
+    r->ts_us = ts;
+    r->id = id;
+    r->nargs = nargs;
+    for (uint8_t i = 0; i < nargs; i++) r->args[i] = args[i];
+    s_head++;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void trace_set_level(int module, int level) {
+    if (level < TRACE_LVL_NONE) level = TRACE_LVL_NONE;
+    if (level > TRACE_LVL_DEBUG) level = TRACE_LVL_DEBUG;
+    for (int m = 0; m < TRACE_MOD_COUNT; m++) {
+        if (module < 0 || module == m) g_trace_level[m] = (uint8_t)level;
+    }
+}
+
+int trace_get_level(int module) {
+    return (module >= 0 && module < TRACE_MOD_COUNT) ? g_trace_level[module] : -1;
+}
+
+void trace_set_console(bool on) { s_console = on; }
+
+size_t trace_dump(uint8_t *buf, size_t len) {
+    uint32_t head, dropped;
+    portENTER_CRITICAL(&s_lock);
+    head = s_head;
+    dropped = s_dropped;
+    portEXIT_CRITICAL(&s_lock);
+    uint32_t count = head < TRACE_RING_SIZE ? head : TRACE_RING_SIZE;
+    size_t need = sizeof(trace_dump_hdr_t) + (size_t)count * sizeof(trace_rec_t);
+    if (!buf) return need;
+    if (len < sizeof(trace_dump_hdr_t)) return 0;
+    uint32_t fit = (uint32_t)((len - sizeof(trace_dump_hdr_t)) / sizeof(trace_rec_t));
+    if (count > fit) count = fit;
+    trace_dump_hdr_t hdr = {
+        .magic = TRACE_DUMP_MAGIC,
+        .rec_size = sizeof(trace_rec_t),
+        .event_count = TRACE_ID_COUNT,
+        .count = count,
+        .dropped = dropped,
+    };
+    memcpy(buf, &hdr, sizeof(hdr));
+    trace_rec_t *out = (trace_rec_t *)(buf + sizeof(hdr));
+    // 逐条加锁拷贝，避免长时间关中断；拷贝期间被覆盖的旧记录会混入新记录，导出仍按时间戳可读
+    for (uint32_t i = 0; i < count; i++) {
+        portENTER_CRITICAL(&s_lock);
+        out[i] = s_ring[(head - count + i) & (TRACE_RING_SIZE - 1)];
+        portEXIT_CRITICAL(&s_lock);
+    }
+    return sizeof(hdr) + (size_t)count * sizeof(trace_rec_t);
+}
+
+// 低优先级 drain：把新记录格式化后交给 ESP_LOG，输出与原 ESP_LOGx 行格式一致
+static void trace_drain_task(void *arg) {
+    char line[160];
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(TRACE_DRAIN_MS));
+        for (;;) {
+            trace_rec_t r;
+            uint32_t lost = 0;
+            portENTER_CRITICAL(&s_lock);
+            if (s_head - s_tail > TRACE_RING_SIZE) {
+                lost = s_head - s_tail - TRACE_RING_SIZE;
+                s_tail = s_head - TRACE_RING_SIZE;
+                s_dropped += lost;
+            }
+            bool have = s_tail != s_head;
+            if (have) r = s_ring[s_tail++ & (TRACE_RING_SIZE - 1)];
+            portEXIT_CRITICAL(&s_lock);
+            if (lost) TRACE(TRACE_DROPPED, lost);
+            if (!have) break;
+            if (!s_console) continue;
+            trace_format(line, sizeof(line), &r);
+            const char *tag = trace_module_name(trace_event_module(r.id));
+            switch (trace_event_level(r.id)) {
+            case TRACE_LVL_ERROR: ESP_LOGE(tag, "[%lu] %s", (unsigned long)r.ts_us, line); break;
+            case TRACE_LVL_WARN:  ESP_LOGW(tag, "[%lu] %s", (unsigned long)r.ts_us, line); break;
+            case TRACE_LVL_DEBUG: ESP_LOGD(tag, "[%lu] %s", (unsigned long)r.ts_us, line); break;
+            default:              ESP_LOGI(tag, "[%lu] %s", (unsigned long)r.ts_us, line); break;
+            }
+        }
+    }
+}
+
+void trace_init(void) {
+    static bool started = false;
+    if (started) return;
+    started = true;
+    xTaskCreate(trace_drain_task, "trace_drain", 3072, NULL, 1, NULL);
+    ESP_LOGI(TAG, "trace ring %d records (%u B)", TRACE_RING_SIZE, (unsigned)sizeof(s_ring));
+}
@@ -0,0 +1,53 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include "trace_fmt.h"
+
+// 延迟格式化的二进制 trace：热路径只写入 RAM 环形缓冲（事件编号 + 原始参数），
+// 文本格式化在低优先级 drain 任务中完成，或导出后由主机工具 Tools/trace 解码
+// 置 0 后 TRACE() 展开为空
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1
+#endif
+
+// 环形缓冲记录数（2 的幂；满时覆盖最旧记录并计入 dropped）
+#define TRACE_RING_SIZE 256
+
+// drain 任务轮询周期 (ms)
+#define TRACE_DRAIN_MS 200
+
+// 各模块运行时级别（记录 level <= 模块级别时写入）
+extern uint8_t g_trace_level[TRACE_MOD_COUNT];
+
+// 参数打包：整数与 float 都以 32 位原始值存储
+static inline uint32_t trace_i(int32_t v) { return (uint32_t)v; }
+static inline uint32_t trace_f(float v) { uint32_t u; memcpy(&u, &v, sizeof(u)); return u; }
+
+void trace_emit(uint16_t id, const uint32_t *args, uint8_t nargs);
+
+// 启动 drain 任务（格式化输出到控制台日志）
+void trace_init(void);
+// 设置/读取模块级别；module < 0 表示全部模块
+void trace_set_level(int module, int level);
+int trace_get_level(int module);
+// drain 任务是否把记录格式化打印到控制台（关闭后记录只留在环形缓冲，供导出）
+void trace_set_console(bool on);
+// 导出当前缓冲（头部 + 最旧到最新的记录），返回写入字节数；buf 为 NULL 时返回所需大小
+size_t trace_dump(uint8_t *buf, size_t len);
+
+#if TRACE_ENABLE
+#define TRACE(ev, ...) do { \
+        if (g_trace_level[TRACE_MOD_OF_##ev] >= TRACE_LVL_OF_##ev) { \
+            const uint32_t trace_args_[] = { __VA_ARGS__ }; \
+            trace_emit(TRACE_ID_##ev, trace_args_, (uint8_t)(sizeof(trace_args_) / sizeof(trace_args_[0]))); \
+        } \
+    } while (0)
+#else
+#define TRACE(ev, ...) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef TRACE_EVENTS_H
+#define TRACE_EVENTS_H
+
+// 二进制 trace 事件表（固件与主机解码器 Tools/trace 共用，新增事件只追加到末尾以保持编号稳定）
+// X(名称, 模块, 级别, 格式)：参数按格式中的转换符依次解释，%d/%u/%x 为 32 位整数，%f 为 float 位模式
+
+typedef enum {
+    TRACE_MOD_TEMP = 0,
+    TRACE_MOD_PID,
+    TRACE_MOD_BATT,
+    TRACE_MOD_RELAY,
+    TRACE_MOD_SYS,
+    TRACE_MOD_COUNT
+} trace_module_t;
+
+typedef enum {
+    TRACE_LVL_NONE = 0,
+    TRACE_LVL_ERROR,
+    TRACE_LVL_WARN,
+    TRACE_LVL_INFO,
+    TRACE_LVL_DEBUG,
+} trace_level_t;
+
+#define TRACE_EVENTS(X) \
+    X(TEMP_SAMPLE,   TRACE_MOD_TEMP, TRACE_LVL_DEBUG, "ADC=%d, 电压=%dmV, 阻值=%.0fΩ, 温度=%.1f°C") \
+    X(TEMP_OPEN,     TRACE_MOD_TEMP, TRACE_LVL_WARN,  "电压过高，可能传感器开路 ADC=%d") \
+    X(TEMP_SHORT,    TRACE_MOD_TEMP, TRACE_LVL_WARN,  "电压过低，可能传感器短路 ADC=%d") \
+    X(PID_LOOP,      TRACE_MOD_PID,  TRACE_LVL_INFO,  "PID loop: zone=%d set=%.1f temp=%.1f out=%.1f%%") \
+    X(BATT_SAMPLE,   TRACE_MOD_BATT, TRACE_LVL_INFO,  "电池电压: %.2fV, 电量: %.0f%%, ADC: %d") \
+    X(BATT_LOW,      TRACE_MOD_BATT, TRACE_LVL_WARN,  "电池电量偏低 %.0f%%") \
+    X(BATT_CRITICAL, TRACE_MOD_BATT, TRACE_LVL_ERROR, "电池电量严重不足！请立即充电 %.0f%%") \
+    X(TRACE_DROPPED, TRACE_MOD_SYS,  TRACE_LVL_WARN,  "trace ring overrun, %u records dropped")
+
+#define TRACE_EV_ID(name, mod, lvl, fmt) TRACE_ID_##name,
+typedef enum { TRACE_EVENTS(TRACE_EV_ID) TRACE_ID_COUNT } trace_id_t;
+#undef TRACE_EV_ID
+
+// 每个事件的模块/级别编译期常量，供 TRACE() 做零开销的级别判断
+#define TRACE_EV_META(name, mod, lvl, fmt) TRACE_MOD_OF_##name = mod, TRACE_LVL_OF_##name = lvl,
+enum { TRACE_EVENTS(TRACE_EV_META) };
+#undef TRACE_EV_META
+
+#endif
@@ -0,0 +1,69 @@
+// trace 记录的文本格式化：固件 drain 任务与主机解码器共用，不依赖 ESP-IDF
+#include "trace_fmt.h"
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    const char *fmt;
+    uint8_t module;
+    uint8_t level;
+} trace_event_meta_t;
+
+#define TRACE_EV_META(name, mod, lvl, fmt) { #name, fmt, mod, lvl },
+static const trace_event_meta_t EVENTS[TRACE_ID_COUNT] = { TRACE_EVENTS(TRACE_EV_META) };
+#undef TRACE_EV_META
+
+static const char *const MODULE_NAMES[TRACE_MOD_COUNT] = { "temp", "pid", "batt", "relay", "sys" };
+static const char *const LEVEL_NAMES[] = { "N", "E", "W", "I", "D" };
+
+const char *trace_module_name(int module) {
+    return (module >= 0 && module < TRACE_MOD_COUNT) ? MODULE_NAMES[module] : "?";
+}
+
+const char *trace_level_name(int level) {
+    return (level >= 0 && level <= TRACE_LVL_DEBUG) ? LEVEL_NAMES[level] : "?";
+}
+
+const char *trace_event_fmt(int id) { return (id >= 0 && id < TRACE_ID_COUNT) ? EVENTS[id].fmt : NULL; }
+const char *trace_event_name(int id) { return (id >= 0 && id < TRACE_ID_COUNT) ? EVENTS[id].name : NULL; }
+int trace_event_module(int id) { return (id >= 0 && id < TRACE_ID_COUNT) ? EVENTS[id].module : -1; }
+int trace_event_level(int id) { return (id >= 0 && id < TRACE_ID_COUNT) ? EVENTS[id].level : -1; }
+
+int trace_format(char *buf, size_t len, const trace_rec_t *rec) {
+    const char *f = trace_event_fmt(rec->id);
+    if (!f) return snprintf(buf, len, "<unknown event %u>", (unsigned)rec->id);
+    size_t n = 0;
+    int arg = 0;
+    if (len == 0) return 0;
+    while (*f && n + 1 < len) {
+        if (*f != '%') { buf[n++] = *f++; continue; }
+        if (f[1] == '%') { buf[n++] = '%'; f += 2; continue; }
+        // 截取一个转换说明（标志/宽度/精度 + 转换符）
+        const char *s = f++;
+        while (*f && strchr("-+ #0123456789.", *f)) f++;
+        if (!*f) break;
+        char spec[16];
+        size_t sl = (size_t)(f - s) + 1;
+        if (sl >= sizeof(spec)) sl = sizeof(spec) - 1;
+        memcpy(spec, s, sl);
+        spec[sl] = 0;
+        char conv = *f++;
+        uint32_t v = arg < rec->nargs ? rec->args[arg] : 0;
+        arg++;
+        int w;
+        if (conv == 'f' || conv == 'e' || conv == 'g') {
+            float fv;
+            memcpy(&fv, &v, sizeof(fv));
+            w = snprintf(buf + n, len - n, spec, (double)fv);
+        } else if (conv == 'd' || conv == 'i') {
+            w = snprintf(buf + n, len - n, spec, (int)(int32_t)v);
+        } else {
+            w = snprintf(buf + n, len - n, spec, (unsigned)v);
+        }
+        if (w < 0) break;
+        n += (size_t)w < len - n ? (size_t)w : len - n - 1;
+    }
+    buf[n] = 0;
+    return (int)n;
+}
@@ -0,0 +1,40 @@
+#ifndef TRACE_FMT_H
+#define TRACE_FMT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "trace_events.h"
+
+// 单条记录：时间戳 + 事件编号 + 原始 32 位参数（float 存位模式）
+#define TRACE_MAX_ARGS 4
+
+typedef struct {
+    uint32_t ts_us;                 // 启动以来微秒（32 位回绕，约 71 分钟）
+    uint16_t id;                    // trace_id_t
+    uint8_t  nargs;
+    uint8_t  rsv;
+    uint32_t args[TRACE_MAX_ARGS];
+} trace_rec_t;
+
+// 二进制导出格式：头部 + count 条 trace_rec_t（小端）
+#define TRACE_DUMP_MAGIC 0x31435254u  // "TRC1"
+
+typedef struct {
+    uint32_t magic;
+    uint16_t rec_size;
+    uint16_t event_count;           // 导出方事件表长度，解码方据此检查版本
+    uint32_t count;
+    uint32_t dropped;
+} trace_dump_hdr_t;
+
+const char *trace_module_name(int module);
+const char *trace_level_name(int level);
+// 事件元数据（未知编号返回 NULL / -1）
+const char *trace_event_fmt(int id);
+const char *trace_event_name(int id);
+int trace_event_module(int id);
+int trace_event_level(int id);
+// 按事件格式把记录格式化为文本（不含时间戳/模块前缀），返回写入长度
+int trace_format(char *buf, size_t len, const trace_rec_t *rec);
+
+#endif
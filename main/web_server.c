@@ -1,9 +1,11 @@
 #include "web_server.h"
 #include "esp_http_server.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "cJSON.h"
 #include <string.h>
-#include <ctype.h>
 
 #include "../Hardware/buzzer.h"
 #include "../Hardware/rgb.h"
@@ -11,33 +13,41 @@
 #include "../Hardware/relay.h"
 #include "../Hardware/temperature.h"
 #include "../Hardware/battery_monitor.h"
+#include "../Hardware/sensors.h"
+#include "../Hardware/uart.h"
 #include "pid_controller.h"
+#include "zone_bank.h"
+#include "../Hardware/hal.h"
+#include "perf_stats.h"
+#include "trace.h"
+#include "telemetry.h"
+#include "capture.h"
+#include "safety.h"
+#include "sys_stats.h"
+#include "boot_prof.h"
+#include "ota_update.h"
+#include "api_json.h"
+#include "hw_bench.h"
 
 // 若未使用 EMBED_TXTFILES，改用 SPIFFS/LittleFS 或内置最小页面
 static const char INDEX_FALLBACK[] = "<!doctype html><meta charset=utf-8><title>ESP32</title><p>前端未嵌入，请访问 /api 接口或开启嵌入文件</p>";
 
 static const char *TAG = "WEB";
 static httpd_handle_t s_server = NULL;
-static PID_t s_pid;
-static bool s_pid_running = false;
-static TaskHandle_t s_pid_task = NULL;
-static float s_pid_last_temp = 0.0f;
-static float s_pid_last_output = 0.0f;
-static float s_pid_max_temp = 80.0f; // 温度上限，超过则告警（红灯+蜂鸣）
+static uint16_t s_port = 0;
 
 static esp_err_t serve_text(httpd_req_t *req, const char *start, const char *end, const char *ctype){
     httpd_resp_set_type(req, ctype);
     return httpd_resp_send(req, start, end - start);
 }
 
-// CORS 支持
+// CORS 支持（由路由分发统一设置）
 static inline void set_cors(httpd_req_t *req){
     httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
     httpd_resp_set_hdr(req, "Access-Control-Allow-Headers", "Content-Type");
     httpd_resp_set_hdr(req, "Access-Control-Allow-Methods", "POST, GET, OPTIONS");
     httpd_resp_set_hdr(req, "Connection", "close");
 }
-static esp_err_t api_options(httpd_req_t *req){ set_cors(req); return httpd_resp_sendstr(req, ""); }
 
 // 静态文件
 static esp_err_t on_index(httpd_req_t *req){ return httpd_resp_send(req, INDEX_FALLBACK, HTTPD_RESP_USE_STRLEN); }
@@ -65,12 +75,92 @@ static cJSON* read_json(httpd_req_t *req){
     return j;
 }
 
+// ===== 异步路由：服务任务读完请求体后入队，工作任务执行并经会话套接字回复 =====
+// 服务任务在会话套接字上 select，处理函数返回后其它任务不能再读该连接，因此请求体先由服务任务读入堆；
+// 工作任务生成完整响应后经 httpd_queue_work 交回服务任务用 httpd_socket_send 发送，随后关闭连接
+typedef struct web_job {
+    int fd;
+    uint32_t gen;               // 入队时的会话代号，回复前核对（连接已关闭或套接字被复用时丢弃）
+    int method;
+    char query[160];            // URL 查询串，无则为空
+    char *body;                 // 以 0 结尾；无请求体时为 NULL
+    size_t body_len;
+    void (*handler)(struct web_job *job);
+    int64_t t_enq_us;
+    bool replied;
+} web_job_t;
+
+typedef struct { uint32_t gen; } web_sess_t;
+
+static portMUX_TYPE s_http_lock = portMUX_INITIALIZER_UNLOCKED;
+static size_t s_async_body_bytes = 0;   // 排队/执行中的请求体字节数
+
+// 释放请求体并归还预算（可重复调用）
+static void web_job_release(web_job_t *job){
+    free(job->body);
+    job->body = NULL;
+    portENTER_CRITICAL(&s_http_lock);
+    s_async_body_bytes -= job->body_len;
+    portEXIT_CRITICAL(&s_http_lock);
+    job->body_len = 0;
+}
+
+typedef struct {
+    int fd;
+    uint32_t gen;
+    size_t len;
+    char data[];
+} web_reply_t;
+
+// 在服务任务上执行：会话仍是入队时那个才发送（响应均带 Connection: close，发完即关闭）
+static void web_reply_work(void *arg){
+    web_reply_t *r = (web_reply_t*)arg;
+    web_sess_t *sess = (web_sess_t*)httpd_sess_get_ctx(s_server, r->fd);
+    if (sess && sess->gen == r->gen) {
+        size_t off = 0;
+        while (off < r->len) {
+            int n = httpd_socket_send(s_server, r->fd, r->data + off, r->len - off, 0);
+            if (n <= 0) break;
+            off += n;
+        }
+        httpd_sess_trigger_close(s_server, r->fd);
+    }
+    free(r);
+}
+
+// 生成完整 HTTP 响应（含 CORS 头）交给服务任务发送；每个请求只回复一次，回复后处理函数不再访问请求体
+// 先归还请求体预算：工作任务优先级低于服务任务，回复发出后客户端的下一段（OTA 续传）可能在工作任务返回前到达
+static void web_job_reply(web_job_t *job, const char *status, const char *body){
+    if (job->replied) return;
+    job->replied = true;
+    web_job_release(job);
+    size_t blen = strlen(body);
+    char head[320];
+    int hn = snprintf(head, sizeof(head),
+                      "HTTP/1.1 %s\r\nContent-Type: application/json\r\nContent-Length: %u\r\n"
+                      "Access-Control-Allow-Origin: *\r\nAccess-Control-Allow-Headers: Content-Type\r\n"
+                      "Access-Control-Allow-Methods: POST, GET, OPTIONS\r\nConnection: close\r\n\r\n",
+                      status ? status : "200 OK", (unsigned)blen);
+    web_reply_t *r = (web_reply_t*)malloc(sizeof(*r) + hn + blen);
+    if (!r) { ESP_LOGW(TAG, "no memory for reply (fd %d)", job->fd); return; }
+    r->fd = job->fd;
+    r->gen = job->gen;
+    r->len = hn + blen;
+    memcpy(r->data, head, hn);
+    memcpy(r->data + hn, body, blen);
+    if (httpd_queue_work(s_server, web_reply_work, r) != ESP_OK) free(r);
+}
+
+static cJSON* job_json(const web_job_t *job){
+    cJSON *j = job->body_len ? cJSON_Parse(job->body) : NULL;
+    return j ? j : cJSON_CreateObject();
+}
+
 // /api/beep
-static esp_err_t api_beep(httpd_req_t *req){ set_cors(req); ESP_LOGI(TAG, "API /beep"); buzzer_alarm(); httpd_resp_sendstr(req, "{\"ok\":true}"); return ESP_OK; }
+static void api_beep(web_job_t *job){ ESP_LOGI(TAG, "API /beep"); buzzer_alarm(); web_job_reply(job, NULL, "{\"ok\":true}"); }
 
 // /api/led
 static esp_err_t api_led(httpd_req_t *req){
-    set_cors(req);
     cJSON *j = read_json(req); if(!j){ httpd_resp_send_500(req); return ESP_FAIL; }
     cJSON *r=cJSON_GetObjectItem(j,"r"), *g=cJSON_GetObjectItem(j,"g");
     // 这里简单切换：若传入 toggle 就在 0/255 间切换；实际可存状态
@@ -86,40 +176,45 @@ static esp_err_t api_led(httpd_req_t *req){
     return ESP_OK;
 }
 
-// /api/oled
-static esp_err_t api_oled(httpd_req_t *req){
-    set_cors(req);
-    cJSON *j = read_json(req); if(!j){ httpd_resp_send_500(req); return ESP_FAIL; }
+// /api/oled：在工作任务执行，多个请求可能同时到达；重绘与控制任务仪表盘的互斥由显示模块负责
+static void api_oled(web_job_t *job){
+    cJSON *j = job_json(job); if(!j){ web_job_reply(job, "500 Internal Server Error", "{}"); return; }
     const char *text = cJSON_GetStringValue(cJSON_GetObjectItem(j,"text"));
     if(!text) text = "";
-    // 简单兼容：仅显示 ASCII，可见字符转大写，超过宽度自动分行
-    char l1[32]={0}, l2[32]={0}, l3[32]={0};
+    // 按屏宽（21 个 5x7 字符）自动分行；支持 ASCII 可见字符与 UTF-8 '°'，其余字符由显示模块替换为 '?'
+    char l1[64]={0}, l2[64]={0}, l3[64]={0};
+    char *lines[3] = { l1, l2, l3 };
     const int maxw = 21; // 128/6 ≈ 21 字符
-    const char *p = text; int line=0, col=0;
+    const char *p = text; int line=0, col=0, len=0;
     while (*p && line<3) {
-        char ch = *p++;
+        unsigned char ch = (unsigned char)*p++;
         if (ch=='\r') continue;
-        if (ch=='\n') { line++; col=0; continue; }
-        if ((unsigned char)ch < 32 || (unsigned char)ch > 126) ch = ' ';
-        ch = (char)toupper((unsigned char)ch);
-        if (col>=maxw) { line++; col=0; if(line>=3) break; }
-        if (line==0) l1[col++] = ch;
-        else if (line==1) l2[col++] = ch;
-        else l3[col++] = ch;
+        if (ch=='\n') { line++; col=0; len=0; continue; }
+        if (ch < 32) ch = ' ';
+        // UTF-8 后续字节跟随首字节，不占列
+        if ((ch & 0xC0) != 0x80) {
+            if (col>=maxw) { line++; col=0; len=0; if(line>=3) break; }
+            col++;
+        }
+        if (len < (int)sizeof(l1) - 1) lines[line][len++] = (char)ch;
     }
     ESP_LOGI(TAG, "API /oled len=%d", (int)strlen(text));
     display_show_text(l1, l2, l3);
     cJSON_Delete(j);
-    httpd_resp_sendstr(req, "{\"ok\":true}");
-    return ESP_OK;
+    web_job_reply(job, NULL, "{\"ok\":true}");
 }
 
 // /api/relay
 static esp_err_t api_relay(httpd_req_t *req){
-    set_cors(req);
+    // 安全故障锁存期间拒绝手动输出（同温区启动），避免确认故障后加热器直接跳到锁存期间写入的目标
+    if (safety_latched()) {
+        httpd_resp_set_status(req, "409 Conflict");
+        httpd_resp_set_type(req, "application/json");
+        return httpd_resp_sendstr(req, "{\"ok\":false,\"error\":\"safety fault latched\"}");
+    }
     bool want_toggle = true; // 默认 toggle
     int want_on = -1;        // -1 表示未指定，0/1 表示强制关/开
-    bool stop_pid = true;    // 手动控制时默认停止 PID，避免被覆盖
+    bool stop_pid = true;    // 手动控制时默认把 PID 切到手动（只跟踪不输出），避免被覆盖
 
     // 读取 JSON 体
     cJSON *j = read_json(req);
@@ -145,7 +240,8 @@ static esp_err_t api_relay(httpd_req_t *req){
         }
     }
 
-    if (stop_pid && s_pid_running) { s_pid_running = false; ESP_LOGI(TAG, "API /relay: stop PID for manual control"); }
+    // 切到手动而非停止：积分继续跟踪手动输出，/api/pid/start 切回自动时无扰
+    if (stop_pid && zone_bank_running(0)) { zone_bank_set_manual(0); ESP_LOGI(TAG, "API /relay: PID -> manual"); }
 
     if (cJSON_HasObjectItem(j, "pwm")) {
         int pct = cJSON_GetObjectItem(j, "pwm")->valueint;
@@ -158,19 +254,18 @@ static esp_err_t api_relay(httpd_req_t *req){
     ESP_LOGI(TAG, "API /relay -> %s", now?"ON":"OFF");
     httpd_resp_set_type(req, "application/json");
     char buf[64];
-    snprintf(buf, sizeof(buf), "{\"ok\":true,\"relay\":%s,\"pid_running\":%s}", now?"true":"false", s_pid_running?"true":"false");
+    api_json_relay(buf, sizeof(buf), now, zone_bank_running(0));
     httpd_resp_sendstr(req, buf);
     if (j) cJSON_Delete(j);
     return ESP_OK;
 }
 
-// /api/battery
+// /api/battery：采集缓存
 static esp_err_t api_battery(httpd_req_t *req){
-    set_cors(req);
     float v = battery_read_voltage();
     float p = battery_voltage_to_percentage(v);
     char buf[64];
-    snprintf(buf,sizeof(buf),"{\"voltage\":%.2f,\"percent\":%.0f}", v, p);
+    api_json_battery(buf, sizeof(buf), v, p);
     httpd_resp_set_type(req, "application/json");
     static int last_pct = -1;
     int ipct = (int)(p + 0.5f);
@@ -184,187 +279,686 @@ static esp_err_t api_battery(httpd_req_t *req){
     return ESP_OK;
 }
 
-// /api/temp
+// /api/temp：温区 0 通道的采集缓存，不触发 ADC
 static esp_err_t api_temp(httpd_req_t *req){
-    set_cors(req);
-    float t = temperature_read();
+    float t = sensors_value(zone_bank_adc_channel(0));
     char buf[64];
-    snprintf(buf,sizeof(buf),"{\"value\":%.2f}", t);
+    api_json_temp(buf, sizeof(buf), t);
     httpd_resp_set_type(req, "application/json");
     // 不在串口打印温度数据，避免刷屏
     httpd_resp_sendstr(req, buf);
     return ESP_OK;
 }
 
-// ===== PID 控制 =====
-static void pid_control_task(void *arg){
-    TickType_t windowStart = xTaskGetTickCount();
-    const TickType_t windowTicks = pdMS_TO_TICKS(WINDOW_SIZE);
-    while (s_pid_running) {
-        float current = temperature_read();
-        float output = pid_compute(&s_pid, current); // 0~100
-        s_pid_last_temp = current;
-        s_pid_last_output = output;
-        // 直接以 PID 输出映射 PWM 占空（0~100%）
-        relay_set_pwm_percent((int)(output + 0.5f));
-
-        // 超温告警：红灯+蜂鸣；未超温：绿灯，蜂鸣关闭（有源蜂鸣，静默即拉低，已在蜂鸣函数内部处理）
-        static TickType_t last_beep = 0;
-        if (current > s_pid_max_temp) {
-            set_rgb(255, 0, 0);
-            TickType_t now2 = xTaskGetTickCount();
-            if (now2 - last_beep > pdMS_TO_TICKS(1000)) {
-                last_beep = now2;
-                // 简化处理：阻塞 1s 蜂鸣；如需非阻塞可改为定时器或独立任务
-                buzzer_alarm();
-            }
-        } else {
-            set_rgb(0, 255, 0);
-        }
-
-        // OLED 显示当前温度/设定与 PID 参数（两行参数避免过长）
-        {
-            char l1[28], l2[28], l3[28];
-            snprintf(l1, sizeof(l1), "T:%.1f S:%.1f Max:%.1f", current, s_pid.setpoint, s_pid_max_temp);
-            snprintf(l2, sizeof(l2), "KP:%.2f KI:%.3f", s_pid.Kp, s_pid.Ki);
-            snprintf(l3, sizeof(l3), "KD:%.2f OUT:%3.0f%%", s_pid.Kd, output);
-            display_show_text(l1, l2, l3);
-        }
-
-        ESP_LOGI(TAG, "PID loop: set=%.1f temp=%.1f out=%.0f%% (PWM)", s_pid.setpoint, current, output);
-        vTaskDelay(pdMS_TO_TICKS(200));
-    }
-    relay_set(false);
-    vTaskDelete(NULL);
+// ===== PID 控制（温区 0 兼容 /api/pid/*，其余温区走 /api/zone/<id>/...） =====
+static void zone_fill_status(int z, api_pid_status_t *st, PID_t *pid, PID_t *inner){
+    zone_status_t zs;
+    zone_bank_get_status(z, &zs);
+    zone_bank_get_pid(z, pid);
+    zone_bank_get_inner(z, inner);
+    st->running = zs.running; st->manual = zs.manual; st->pid = pid; st->max_temp = zs.max_temp;
+    st->ctl = zs.ctl == ZONE_CTL_MPC ? "mpc" : "pid";
+    st->temp = zs.temp; st->output = zs.output;
+    // 最近一次温度 ADC 原始与等效电压(mV)
+    // 外部温度源（热电偶）的 raw 为原始帧，无等效电压
+    st->adc = zs.adc_raw; st->mv = zone_bank_adc_channel(z) >= SENSOR_SRC_ID(0) ? 0 : hal_adc_raw_to_mv(zs.adc_raw);
+    st->pwm = zs.output_percent;
+    // 级联：kp/ki/kd 为外环，内环与元件温度另附
+    st->cascade = zs.cascade; st->element_temp = zs.element_temp; st->element_sp = zs.element_sp; st->inner = inner;
 }
 
-static esp_err_t api_pid_params(httpd_req_t *req){
-    set_cors(req);
+static esp_err_t zone_params(httpd_req_t *req, int z){
     cJSON *j = read_json(req); if(!j){ httpd_resp_send_500(req); return ESP_FAIL; }
-    double sp = cJSON_GetObjectItem(j, "setpoint") ? cJSON_GetObjectItem(j, "setpoint")->valuedouble : s_pid.setpoint;
-    double kp = cJSON_GetObjectItem(j, "kp") ? cJSON_GetObjectItem(j, "kp")->valuedouble : s_pid.Kp;
-    double ki = cJSON_GetObjectItem(j, "ki") ? cJSON_GetObjectItem(j, "ki")->valuedouble : s_pid.Ki;
-    double kd = cJSON_GetObjectItem(j, "kd") ? cJSON_GetObjectItem(j, "kd")->valuedouble : s_pid.Kd;
-    if (cJSON_HasObjectItem(j, "max")) s_pid_max_temp = (float)cJSON_GetObjectItem(j, "max")->valuedouble;
-    s_pid.setpoint = (float)sp; s_pid.Kp=(float)kp; s_pid.Ki=(float)ki; s_pid.Kd=(float)kd;
-    // 修改参数时重置积分/误差，避免历史影响
-    s_pid.integral = 0.0f; s_pid.last_error = 0.0f; s_pid.last_input = s_pid_last_temp;
-    ESP_LOGI(TAG, "API /pid/params sp=%.1f Kp=%.2f Ki=%.3f Kd=%.2f", s_pid.setpoint, s_pid.Kp, s_pid.Ki, s_pid.Kd);
+    PID_t pid;
+    zone_bank_get_pid(z, &pid);
+    double sp = cJSON_GetObjectItem(j, "setpoint") ? cJSON_GetObjectItem(j, "setpoint")->valuedouble : pid.setpoint;
+    double kp = cJSON_GetObjectItem(j, "kp") ? cJSON_GetObjectItem(j, "kp")->valuedouble : pid.Kp;
+    double ki = cJSON_GetObjectItem(j, "ki") ? cJSON_GetObjectItem(j, "ki")->valuedouble : pid.Ki;
+    double kd = cJSON_GetObjectItem(j, "kd") ? cJSON_GetObjectItem(j, "kd")->valuedouble : pid.Kd;
+    if (cJSON_HasObjectItem(j, "max")) zone_bank_set_max_temp(z, (float)cJSON_GetObjectItem(j, "max")->valuedouble);
+    // "ctl":"pid"|"mpc" 切换自动控制算法（MPC 使用 mpc_table.c 的对象模型，增益参数不参与）
+    const char *ctl = cJSON_GetStringValue(cJSON_GetObjectItem(j, "ctl"));
+    if (ctl && strcmp(ctl, "mpc") == 0) zone_bank_set_ctl(z, ZONE_CTL_MPC);
+    else if (ctl && strcmp(ctl, "pid") == 0) zone_bank_set_ctl(z, ZONE_CTL_PID);
+    // 级联温区 "inner":{"kp","ki","kd"} 修改内环增益（顶层 kp/ki/kd 为外环）
+    cJSON *in = cJSON_GetObjectItem(j, "inner");
+    if (cJSON_IsObject(in)) {
+        PID_t ip;
+        zone_bank_get_inner(z, &ip);
+        cJSON *v;
+        if ((v = cJSON_GetObjectItem(in, "kp"))) ip.Kp = (float)v->valuedouble;
+        if ((v = cJSON_GetObjectItem(in, "ki"))) ip.Ki = (float)v->valuedouble;
+        if ((v = cJSON_GetObjectItem(in, "kd"))) ip.Kd = (float)v->valuedouble;
+        zone_bank_set_inner(z, ip.Kp, ip.Ki, ip.Kd);
+    }
+    zone_bank_set_params(z, (float)sp, (float)kp, (float)ki, (float)kd);
+    zone_bank_get_pid(z, &pid);
+    zone_status_t zs;
+    zone_bank_get_status(z, &zs);
+    ESP_LOGI(TAG, "API params zone=%d sp=%.1f Kp=%.2f Ki=%.3f Kd=%.2f", z, pid.setpoint, pid.Kp, pid.Ki, pid.Kd);
     cJSON_Delete(j);
     httpd_resp_set_type(req, "application/json");
     char buf[160];
-    snprintf(buf,sizeof(buf),"{\"ok\":true,\"setpoint\":%.1f,\"kp\":%.2f,\"ki\":%.3f,\"kd\":%.2f,\"max\":%.1f}", s_pid.setpoint, s_pid.Kp, s_pid.Ki, s_pid.Kd, s_pid_max_temp);
+    api_json_pid_params(buf, sizeof(buf), &pid, zs.max_temp);
     httpd_resp_sendstr(req, buf);
     return ESP_OK;
 }
 
-static esp_err_t api_pid_start(httpd_req_t *req){
-    set_cors(req);
-    if (!s_pid_running) {
-        s_pid_running = true;
-        if (s_pid.Kp==0 && s_pid.Ki==0 && s_pid.Kd==0) pid_init(&s_pid, 2.0f, 0.1f, 0.5f, 40.0f);
-        xTaskCreate(pid_control_task, "pid_task", 4096, NULL, 5, &s_pid_task);
-        ESP_LOGI(TAG, "API /pid/start -> started");
+static esp_err_t zone_start(httpd_req_t *req, int z){
+    if (!zone_bank_running(z)) {
+        if (!zone_bank_start(z)) {
+            httpd_resp_set_status(req, "409 Conflict");
+            httpd_resp_set_type(req, "application/json");
+            return httpd_resp_sendstr(req, "{\"ok\":false,\"error\":\"safety fault latched\"}");
+        }
+        ESP_LOGI(TAG, "API start zone=%d -> started", z);
     }
+    PID_t pid;
+    zone_bank_get_pid(z, &pid);
     httpd_resp_set_type(req, "application/json");
     char buf[128];
-    snprintf(buf,sizeof(buf),"{\"ok\":true,\"running\":true,\"setpoint\":%.1f,\"kp\":%.2f,\"ki\":%.3f,\"kd\":%.2f}", s_pid.setpoint, s_pid.Kp, s_pid.Ki, s_pid.Kd);
+    api_json_pid_start(buf, sizeof(buf), &pid);
     httpd_resp_sendstr(req, buf);
     return ESP_OK;
 }
 
-static esp_err_t api_pid_stop(httpd_req_t *req){
-    set_cors(req);
-    if (s_pid_running) { s_pid_running = false; ESP_LOGI(TAG, "API /pid/stop -> stopped"); }
+static esp_err_t zone_stop(httpd_req_t *req, int z){
+    if (zone_bank_running(z)) { zone_bank_stop(z); ESP_LOGI(TAG, "API stop zone=%d -> stopped", z); }
     httpd_resp_sendstr(req, "{\"ok\":true}");
     return ESP_OK;
 }
 
+static esp_err_t api_pid_params(httpd_req_t *req){ return zone_params(req, 0); }
+static esp_err_t api_pid_start(httpd_req_t *req){ return zone_start(req, 0); }
+static esp_err_t api_pid_stop(httpd_req_t *req){ return zone_stop(req, 0); }
+
 static esp_err_t api_pid_status(httpd_req_t *req){
-    set_cors(req);
     httpd_resp_set_type(req, "application/json");
-    char buf[160];
-    // 增加最近一次温度 ADC 原始与等效电压(mV)
-    extern int temperature_get_last_raw(void);
-    extern int temperature_get_last_mv(void);
-    int last_raw = temperature_get_last_raw();
-    int last_mv  = temperature_get_last_mv();
-    extern int relay_get_pwm_percent(void);
-    int pwm = relay_get_pwm_percent();
-    snprintf(buf,sizeof(buf),"{\"running\":%s,\"setpoint\":%.1f,\"kp\":%.2f,\"ki\":%.3f,\"kd\":%.2f,\"max\":%.1f,\"temp\":%.2f,\"output\":%.0f,\"adc\":%d,\"mv\":%d,\"pwm\":%d}",
-             s_pid_running?"true":"false", s_pid.setpoint, s_pid.Kp, s_pid.Ki, s_pid.Kd, s_pid_max_temp, s_pid_last_temp, s_pid_last_output, last_raw, last_mv, pwm);
+    char buf[320];
+    api_pid_status_t st; PID_t pid, inner;
+    zone_fill_status(0, &st, &pid, &inner);
+    api_json_pid_status(buf, sizeof(buf), &st);
     httpd_resp_sendstr(req, buf);
     return ESP_OK;
 }
 
-void web_server_start(void){
-    httpd_config_t cfg = HTTPD_DEFAULT_CONFIG();
-    cfg.lru_purge_enable = true;
-    // 默认 max_uri_handlers=8，不足以注册当前所有 API，这里扩大容量
-    cfg.max_uri_handlers = 32;
-    if (httpd_start(&s_server, &cfg) != ESP_OK) {
-        ESP_LOGE(TAG, "httpd_start failed");
+// /api/zones：全部温区状态
+static esp_err_t api_zones(httpd_req_t *req){
+    httpd_resp_set_type(req, "application/json");
+    char buf[320];
+    snprintf(buf, sizeof(buf), "{\"tick_ms\":%d,\"zones\":[", zone_bank_tick_ms());
+    httpd_resp_sendstr_chunk(req, buf);
+    for (int z = 0; z < zone_bank_count(); z++) {
+        api_pid_status_t st; PID_t pid, inner;
+        zone_fill_status(z, &st, &pid, &inner);
+        int n = 0;
+        if (z) buf[n++] = ',';
+        api_json_zone_status(buf + n, sizeof(buf) - n, z, &st);
+        httpd_resp_sendstr_chunk(req, buf);
+    }
+    httpd_resp_sendstr_chunk(req, "]}");
+    return httpd_resp_sendstr_chunk(req, NULL);
+}
+
+// /api/zone/<id>/model：GET 读在线辨识模型与 SIMC 建议参数；POST {"apply":true} 按建议整定（模型无效时 409），{"reset":true} 重新辨识
+static esp_err_t zone_model(httpd_req_t *req, int z){
+    const char *status = NULL;
+    if (req->method == HTTP_POST) {
+        cJSON *j = read_json(req); if(!j){ httpd_resp_send_500(req); return ESP_FAIL; }
+        if (cJSON_IsTrue(cJSON_GetObjectItem(j, "reset"))) zone_bank_reset_model(z);
+        else if (cJSON_IsTrue(cJSON_GetObjectItem(j, "apply")) && !zone_bank_apply_model(z)) status = "409 Conflict";
+        cJSON_Delete(j);
+    }
+    plant_model_t m;
+    zone_bank_get_model(z, &m);
+    char buf[320];
+    snprintf(buf, sizeof(buf),
+             "{\"zone\":%d,\"valid\":%s,\"a\":%.5f,\"b\":%.5f,\"c\":%.4f,\"gain\":%.4f,\"tau_s\":%.1f,\"dead_s\":%.0f,"
+             "\"ambient\":%.1f,\"rmse\":%.3f,\"excitation\":%.2f,\"samples\":%lu,\"updates\":%lu,"
+             "\"suggest\":{\"kp\":%.3f,\"ki\":%.4f,\"kd\":%.3f}}",
+             z, m.valid ? "true" : "false", m.a, m.b, m.c, m.gain, m.tau_s, m.dead_s, m.ambient, m.rmse, m.excitation,
+             (unsigned long)m.samples, (unsigned long)m.updates, m.kp, m.ki, m.kd);
+    if (status) httpd_resp_set_status(req, status);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, buf);
+}
+
+// /api/zone/<id>[/params|/start|/stop|/model]：GET 读状态，POST 执行动作
+static esp_err_t api_zone(httpd_req_t *req){
+    const char *p = req->uri + strlen("/api/zone/");
+    char *end = NULL;
+    long z = strtol(p, &end, 10);
+    if (end == p || z < 0 || z >= zone_bank_count()) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "no such zone");
+        return ESP_FAIL;
+    }
+    size_t alen = strcspn(end, "?");
+    if (alen == 0 || (alen == 1 && *end == '/')) {
+        httpd_resp_set_type(req, "application/json");
+        char buf[320];
+        api_pid_status_t st; PID_t pid, inner;
+        zone_fill_status((int)z, &st, &pid, &inner);
+        api_json_zone_status(buf, sizeof(buf), (int)z, &st);
+        return httpd_resp_sendstr(req, buf);
+    }
+    if (alen == 6 && strncmp(end, "/model", 6) == 0) return zone_model(req, (int)z);
+    if (req->method == HTTP_POST) {
+        if (alen == 7 && strncmp(end, "/params", 7) == 0) return zone_params(req, (int)z);
+        if (alen == 6 && strncmp(end, "/start", 6) == 0) return zone_start(req, (int)z);
+        if (alen == 5 && strncmp(end, "/stop", 5) == 0) return zone_stop(req, (int)z);
+    }
+    httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "unknown zone action");
+    return ESP_FAIL;
+}
+
+#if PERF_STATS_ENABLE
+// /api/perf：GET 读取各阶段耗时直方图摘要；POST {"reset":true} 或 ?reset=1 清零
+static esp_err_t api_perf(httpd_req_t *req){
+    bool reset = false;
+    if (req->method == HTTP_POST) {
+        cJSON *j = read_json(req);
+        if (j) { reset = cJSON_IsTrue(cJSON_GetObjectItem(j, "reset")); cJSON_Delete(j); }
+    }
+    char q[32];
+    char val[8];
+    if (httpd_req_get_url_query_str(req, q, sizeof(q)) == ESP_OK &&
+        httpd_query_key_value(q, "reset", val, sizeof(val)) == ESP_OK) {
+        reset = atoi(val) != 0;
+    }
+    char buf[768];
+    perf_to_json(buf, sizeof(buf));
+    if (reset) { perf_reset(); ESP_LOGI(TAG, "API /perf reset"); }
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_sendstr(req, buf);
+    return ESP_OK;
+}
+#endif
+
+// /api/trace：GET 导出 trace 环形缓冲（二进制，Tools/trace 解码）
+static esp_err_t api_trace(httpd_req_t *req){
+    size_t need = trace_dump(NULL, 0);
+    uint8_t *buf = malloc(need);
+    if (!buf) { httpd_resp_send_500(req); return ESP_FAIL; }
+    size_t n = trace_dump(buf, need);
+    httpd_resp_set_type(req, "application/octet-stream");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"trace.bin\"");
+    esp_err_t err = httpd_resp_send(req, (const char *)buf, n);
+    free(buf);
+    return err;
+}
+
+// /api/trace/level：GET 读取各模块级别；POST {"temp":2,"pid":3,"console":false} 设置（0 关闭 ~ 4 调试，"all" 表示全部模块）
+static esp_err_t api_trace_level(httpd_req_t *req){
+    if (req->method == HTTP_POST) {
+        cJSON *j = read_json(req); if(!j){ httpd_resp_send_500(req); return ESP_FAIL; }
+        cJSON *all = cJSON_GetObjectItem(j, "all");
+        if (cJSON_IsNumber(all)) trace_set_level(-1, all->valueint);
+        for (int m = 0; m < TRACE_MOD_COUNT; m++) {
+            cJSON *it = cJSON_GetObjectItem(j, trace_module_name(m));
+            if (cJSON_IsNumber(it)) trace_set_level(m, it->valueint);
+        }
+        cJSON *con = cJSON_GetObjectItem(j, "console");
+        if (cJSON_IsBool(con)) trace_set_console(cJSON_IsTrue(con));
+        cJSON_Delete(j);
+    }
+    char buf[128];
+    int n = snprintf(buf, sizeof(buf), "{");
+    for (int m = 0; m < TRACE_MOD_COUNT; m++) {
+        n += snprintf(buf + n, sizeof(buf) - n, "%s\"%s\":%d", m ? "," : "", trace_module_name(m), trace_get_level(m));
+    }
+    snprintf(buf + n, sizeof(buf) - n, "}");
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, buf);
+}
+
+// /api/telemetry：GET 读取 UART 遥测状态；POST {"rate":1000,"baud":2000000} 启动/调整，rate 为 0 停止
+static esp_err_t api_telemetry(httpd_req_t *req){
+    if (req->method == HTTP_POST) {
+        cJSON *j = read_json(req); if(!j){ httpd_resp_send_500(req); return ESP_FAIL; }
+        cJSON *rate = cJSON_GetObjectItem(j, "rate");
+        cJSON *baud = cJSON_GetObjectItem(j, "baud");
+        telemetry_stats_t cur;
+        telemetry_get_stats(&cur);
+        telemetry_start(cJSON_IsNumber(rate) ? (uint32_t)rate->valueint : cur.rate_hz,
+                        cJSON_IsNumber(baud) ? baud->valueint : 0);
+        cJSON_Delete(j);
+    }
+    telemetry_stats_t st;
+    telemetry_get_stats(&st);
+    char buf[128];
+    snprintf(buf, sizeof(buf), "{\"rate\":%lu,\"baud\":%d,\"sent\":%lu,\"dropped\":%lu,\"bytes\":%lu}",
+             (unsigned long)st.rate_hz, st.baud, (unsigned long)st.sent, (unsigned long)st.dropped, (unsigned long)st.bytes);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, buf);
+}
+
+// /api/capture：GET 读取控制输入捕获状态；POST {"on":true} 开始（经 UART1 输出，Tools/replay 回放），false 停止
+static esp_err_t api_capture(httpd_req_t *req){
+    if (req->method == HTTP_POST) {
+        cJSON *j = read_json(req); if(!j){ httpd_resp_send_500(req); return ESP_FAIL; }
+        cJSON *on = cJSON_GetObjectItem(j, "on");
+        if (cJSON_IsBool(on)) {
+            if (cJSON_IsTrue(on)) capture_start(); else capture_stop();
+        }
+        cJSON_Delete(j);
+    }
+    capture_stats_t st;
+    capture_get_stats(&st);
+    char buf[128];
+    snprintf(buf, sizeof(buf), "{\"on\":%s,\"baud\":%d,\"frames\":%lu,\"dropped\":%lu,\"bytes\":%lu}",
+             st.active ? "true" : "false", uart_get_baud(), (unsigned long)st.frames, (unsigned long)st.dropped, (unsigned long)st.bytes);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, buf);
+}
+
+// /api/safety：GET 读取安全监控状态；POST {"ack":true} 确认故障（故障仍存在时 409），解除后温区保持停止
+static esp_err_t api_safety(httpd_req_t *req){
+    const char *status = NULL;
+    if (req->method == HTTP_POST) {
+        cJSON *j = read_json(req); if(!j){ httpd_resp_send_500(req); return ESP_FAIL; }
+        if (cJSON_IsTrue(cJSON_GetObjectItem(j, "ack")) && safety_ack() != ESP_OK) status = "409 Conflict";
+        cJSON_Delete(j);
+    }
+    safety_status_t st;
+    safety_get_status(&st);
+    char faults[48] = "", active[48] = "";
+    for (uint32_t b = 1; b <= SAFETY_FAULT_CTRL_STALL; b <<= 1) {
+        if (st.faults & b) snprintf(faults + strlen(faults), sizeof(faults) - strlen(faults), "%s\"%s\"", faults[0] ? "," : "", safety_fault_name(b));
+        if (st.active & b) snprintf(active + strlen(active), sizeof(active) - strlen(active), "%s\"%s\"", active[0] ? "," : "", safety_fault_name(b));
+    }
+    char buf[320];
+    snprintf(buf, sizeof(buf),
+             "{\"latched\":%s,\"faults\":[%s],\"active\":[%s],\"zone\":%d,\"temp\":%.1f,\"trips\":%lu,"
+             "\"latency_us\":%lu,\"max_latency_us\":%lu,\"bound_us\":%d,\"max_check_us\":%lu,\"checks\":%lu}",
+             st.latched ? "true" : "false", faults, active, st.zone, st.temp, (unsigned long)st.trips,
+             (unsigned long)st.last_latency_us, (unsigned long)st.max_latency_us, SAFETY_CUTOFF_BOUND_US,
+             (unsigned long)st.max_check_us, (unsigned long)st.checks);
+    if (status) httpd_resp_set_status(req, status);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, buf);
+}
+
+// /api/boot：启动里程碑时间戳
+static esp_err_t api_boot(httpd_req_t *req){
+    char buf[BOOT_PROF_MAX_MARKS * 48 + 16];
+    boot_prof_to_json(buf, sizeof(buf));
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, buf);
+}
+
+// ===== /api/ota：流式/断点续传固件升级 =====
+// GET 查询进度；POST ?offset=&size=&sha256= 请求体为镜像中 [offset, offset+len) 的数据（不超过 WEB_ASYNC_BODY_MAX）
+// offset=0 开始新会话；续传时 offset 须等于已写入字节数，否则 409 并返回当前进度
+static SemaphoreHandle_t s_ota_lock = NULL;  // 串行化修改 OTA 会话的请求（上传/切换/放弃/flash 自检），冲突时 409
+
+static void ota_status_json(char *buf, size_t len){
+    ota_status_t st;
+    ota_update_get_status(&st);
+    snprintf(buf, len, "{\"state\":\"%s\",\"size\":%lu,\"offset\":%lu,\"sha256\":\"%s\",\"err\":%d,\"elapsed_ms\":%lu}",
+             ota_state_name(st.state), (unsigned long)st.size, (unsigned long)st.written, st.sha256,
+             (int)st.last_err, (unsigned long)st.elapsed_ms);
+}
+
+static esp_err_t ota_reply(httpd_req_t *req, const char *status){
+    char buf[256];
+    ota_status_json(buf, sizeof(buf));
+    if (status) httpd_resp_set_status(req, status);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, buf);
+}
+
+static void ota_job_reply(web_job_t *job, const char *status){
+    char buf[256];
+    ota_status_json(buf, sizeof(buf));
+    web_job_reply(job, status, buf);
+}
+
+static void api_ota(web_job_t *job){
+    if (job->method == HTTP_GET) { ota_job_reply(job, NULL); return; }
+    char val[72];
+    if (httpd_query_key_value(job->query, "offset", val, sizeof(val)) != ESP_OK) {
+        ota_job_reply(job, "400 Bad Request");
+        return;
+    }
+    uint32_t offset = strtoul(val, NULL, 10);
+    char sha[72] = "";
+    uint32_t size = 0;
+    if (offset == 0) {
+        if (httpd_query_key_value(job->query, "size", val, sizeof(val)) == ESP_OK) size = strtoul(val, NULL, 10);
+        httpd_query_key_value(job->query, "sha256", sha, sizeof(sha));
+    }
+    if (xSemaphoreTake(s_ota_lock, 0) != pdTRUE) { ota_job_reply(job, "409 Conflict"); return; }
+    if (offset == 0 && ota_update_begin(size, sha) != ESP_OK) {
+        xSemaphoreGive(s_ota_lock);
+        ota_job_reply(job, "400 Bad Request");
         return;
     }
-    httpd_uri_t u_index = { .uri="/", .method=HTTP_GET, .handler=on_index };
-    httpd_uri_t u_css   = { .uri="/styles.css", .method=HTTP_GET, .handler=on_css };
-    httpd_uri_t u_js    = { .uri="/app.js", .method=HTTP_GET, .handler=on_js };
-    httpd_uri_t u_beep  = { .uri="/api/beep", .method=HTTP_POST, .handler=api_beep };
-    httpd_uri_t u_led   = { .uri="/api/led", .method=HTTP_POST, .handler=api_led };
-    httpd_uri_t g_led   = { .uri="/api/led", .method=HTTP_GET,  .handler=api_led };
-    httpd_uri_t u_oled  = { .uri="/api/oled", .method=HTTP_POST, .handler=api_oled };
-    httpd_uri_t g_oled  = { .uri="/api/oled", .method=HTTP_GET,  .handler=api_oled };
-    httpd_uri_t u_relay = { .uri="/api/relay", .method=HTTP_POST, .handler=api_relay };
-    httpd_uri_t g_relay = { .uri="/api/relay", .method=HTTP_GET,  .handler=api_relay };
-    httpd_uri_t u_batt  = { .uri="/api/battery", .method=HTTP_POST, .handler=api_battery };
-    httpd_uri_t u_temp  = { .uri="/api/temp", .method=HTTP_POST, .handler=api_temp };
-    httpd_uri_t g_batt  = { .uri="/api/battery", .method=HTTP_GET,  .handler=api_battery };
-    httpd_uri_t g_temp  = { .uri="/api/temp",    .method=HTTP_GET,  .handler=api_temp };
-    httpd_uri_t u_pidp  = { .uri="/api/pid/params", .method=HTTP_POST, .handler=api_pid_params };
-    httpd_uri_t u_pids  = { .uri="/api/pid/start",  .method=HTTP_POST, .handler=api_pid_start };
-    httpd_uri_t u_pidx  = { .uri="/api/pid/stop",   .method=HTTP_POST, .handler=api_pid_stop };
-    httpd_uri_t g_pids  = { .uri="/api/pid/status", .method=HTTP_GET,  .handler=api_pid_status };
-    httpd_uri_t o_pidp  = { .uri="/api/pid/params", .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_uri_t o_pids  = { .uri="/api/pid/start",  .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_uri_t o_pidx  = { .uri="/api/pid/stop",   .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_uri_t o_beep  = { .uri="/api/beep", .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_uri_t o_led   = { .uri="/api/led", .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_uri_t o_oled  = { .uri="/api/oled", .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_uri_t o_relay = { .uri="/api/relay", .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_uri_t o_batt  = { .uri="/api/battery", .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_uri_t o_temp  = { .uri="/api/temp", .method=HTTP_OPTIONS, .handler=api_options };
-    httpd_register_uri_handler(s_server, &u_index);
-    httpd_register_uri_handler(s_server, &u_css);
-    httpd_register_uri_handler(s_server, &u_js);
-    httpd_register_uri_handler(s_server, &u_beep);
-    httpd_register_uri_handler(s_server, &u_led);
-    httpd_register_uri_handler(s_server, &g_led);
-    httpd_register_uri_handler(s_server, &u_oled);
-    httpd_register_uri_handler(s_server, &g_oled);
-    httpd_register_uri_handler(s_server, &u_relay);
-    httpd_register_uri_handler(s_server, &g_relay);
-    httpd_register_uri_handler(s_server, &u_batt);
-    httpd_register_uri_handler(s_server, &u_temp);
-    httpd_register_uri_handler(s_server, &g_batt);
-    httpd_register_uri_handler(s_server, &g_temp);
-    httpd_register_uri_handler(s_server, &u_pidp);
-    httpd_register_uri_handler(s_server, &u_pids);
-    httpd_register_uri_handler(s_server, &u_pidx);
-    httpd_register_uri_handler(s_server, &g_pids);
-    httpd_register_uri_handler(s_server, &o_pidp);
-    httpd_register_uri_handler(s_server, &o_pids);
-    httpd_register_uri_handler(s_server, &o_pidx);
-    httpd_register_uri_handler(s_server, &o_beep);
-    httpd_register_uri_handler(s_server, &o_led);
-    httpd_register_uri_handler(s_server, &o_oled);
-    httpd_register_uri_handler(s_server, &o_relay);
-    httpd_register_uri_handler(s_server, &o_batt);
-    httpd_register_uri_handler(s_server, &o_temp);
-    // 若 PID 参数尚未初始化，则给出设备端默认值，供前端首次读取
-    if (s_pid.Kp==0 && s_pid.Ki==0 && s_pid.Kd==0 && s_pid.setpoint==0) {
-        pid_init(&s_pid, 2.0f, 0.1f, 0.5f, 40.0f);
-    }
-    ESP_LOGI(TAG, "web server started");
+    // 按扇区大小分块写入；镜像按请求分段上传，整个镜像不驻留 RAM，失败时已写入部分保留供续传
+    const char *status = NULL;
+    for (size_t done = 0; done < job->body_len; ) {
+        size_t n = job->body_len - done < OTA_CHUNK_SIZE ? job->body_len - done : OTA_CHUNK_SIZE;
+        esp_err_t err = ota_update_write(offset, job->body + done, n);
+        if (err == ESP_ERR_INVALID_STATE) { status = "409 Conflict"; break; }
+        if (err != ESP_OK) { status = "422 Unprocessable Entity"; break; }
+        offset += n;
+        done += n;
+    }
+    xSemaphoreGive(s_ota_lock);
+    ota_job_reply(job, status);
+}
+
+// 切换前关闭全部加热输出，重启期间输出保持关闭
+// 上传在工作任务中进行，切换/放弃须与之互斥：取不到锁即 409，不在服务任务里等待
+static esp_err_t api_ota_apply(httpd_req_t *req){
+    if (xSemaphoreTake(s_ota_lock, 0) != pdTRUE) return ota_reply(req, "409 Conflict");
+    ota_status_t st;
+    ota_update_get_status(&st);
+    const char *status = NULL;
+    if (st.state != OTA_STATE_READY) {
+        status = "409 Conflict";
+    } else {
+        for (int z = 0; z < zone_bank_count(); z++) zone_bank_stop(z);
+        if (ota_update_apply() != ESP_OK) status = "500 Internal Server Error";
+    }
+    xSemaphoreGive(s_ota_lock);
+    return ota_reply(req, status);
+}
+
+static esp_err_t api_ota_abort(httpd_req_t *req){
+    if (xSemaphoreTake(s_ota_lock, 0) != pdTRUE) return ota_reply(req, "409 Conflict");
+    ota_update_abort();
+    xSemaphoreGive(s_ota_lock);
+    return ota_reply(req, NULL);
+}
+
+// /api/sys：任务 CPU 占用/栈余量、堆、lwIP 内存池
+static void api_sys(web_job_t *job){
+    const size_t len = 2048;
+    char *buf = malloc(len);
+    if (!buf) { web_job_reply(job, "500 Internal Server Error", "{}"); return; }
+    sys_stats_to_json(buf, len);
+    web_job_reply(job, NULL, buf);
+    free(buf);
+}
+
+// ===== 工作任务池：耗时/访问硬件的路由（路由表 async 非空）交给工作任务，服务任务只做分发与读请求体 =====
+// 队列满或排队中的请求体超出预算时立即 503，服务任务从不等待工作任务
+// 每个排队/执行中的请求占用一个连接，另留 WEB_SYNC_SOCKETS 个给同步路由（合计不超过 LWIP 10 个套接字减去服务自用 3 个）
+#define WEB_WORKERS       2
+#define WEB_QUEUE_LEN     3
+#define WEB_SYNC_SOCKETS  2
+#define WEB_WORKER_STACK  4096
+#define WEB_WORKER_PRIO   4             // 低于服务任务 (5)：分发与同步路由不被工作任务抢占
+#define WEB_RETRY_AFTER_S "1"
+#define WEB_ASYNC_BODY_MAX    16384     // 单个异步请求体上限（OTA 分段上传的块大小上限）
+#define WEB_ASYNC_BODY_BUDGET (WEB_ASYNC_BODY_MAX + 4096)  // 排队/执行中请求体合计上限
+#define WEB_RECV_RETRIES  5             // 读请求体时连续超时次数上限（视为连接中断）
+
+static QueueHandle_t s_jobs = NULL;
+static uint32_t s_async_done = 0, s_async_busy = 0;
+static uint32_t s_async_max_wait_us = 0, s_async_max_run_us = 0;
+static uint32_t s_sess_gen = 0;         // 只在服务任务中递增
+
+static void web_run(web_job_t *job){
+    job->handler(job);
+    if (!job->replied) web_job_reply(job, "500 Internal Server Error", "{}");
+    web_job_release(job);
+}
+
+static void web_worker(void *arg){
+    web_job_t job;
+    for (;;) {
+        if (xQueueReceive(s_jobs, &job, portMAX_DELAY) != pdTRUE) continue;
+        int64_t t0 = hal_time_us();
+        web_run(&job);
+        uint32_t wait = (uint32_t)(t0 - job.t_enq_us), run = (uint32_t)(hal_time_us() - t0);
+        portENTER_CRITICAL(&s_http_lock);
+        s_async_done++;
+        if (wait > s_async_max_wait_us) s_async_max_wait_us = wait;
+        if (run > s_async_max_run_us) s_async_max_run_us = run;
+        portEXIT_CRITICAL(&s_http_lock);
+    }
+}
+
+static esp_err_t web_busy(httpd_req_t *req){
+    portENTER_CRITICAL(&s_http_lock);
+    s_async_busy++;
+    portEXIT_CRITICAL(&s_http_lock);
+    httpd_resp_set_status(req, "503 Service Unavailable");
+    httpd_resp_set_hdr(req, "Retry-After", WEB_RETRY_AFTER_S);
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_sendstr(req, "{\"error\":\"busy\"}");
+    return ESP_OK;
+}
+
+// 读满请求体；连接中断返回 ESP_FAIL
+static esp_err_t web_recv_body(httpd_req_t *req, char *buf, size_t len){
+    size_t got = 0;
+    int timeouts = 0;
+    while (got < len) {
+        int r = httpd_req_recv(req, buf + got, len - got);
+        if (r == HTTPD_SOCK_ERR_TIMEOUT && ++timeouts < WEB_RECV_RETRIES) continue;
+        if (r <= 0) return ESP_FAIL;
+        timeouts = 0;
+        got += r;
+    }
+    buf[len] = 0;
+    return ESP_OK;
 }
 
+// 只有服务任务入队，检查剩余空间后再读请求体不会与其它生产者竞争
+// 工作任务未能创建时在服务任务内直接执行（响应仍经 httpd_queue_work 在处理函数返回后发送）
+static esp_err_t web_submit(httpd_req_t *req, void (*handler)(web_job_t *job)){
+    size_t body_len = req->content_len;
+    if (s_jobs) {
+        bool ok = uxQueueSpacesAvailable(s_jobs) > 0;
+        portENTER_CRITICAL(&s_http_lock);
+        ok = ok && s_async_body_bytes + body_len <= WEB_ASYNC_BODY_BUDGET;
+        if (ok) s_async_body_bytes += body_len;
+        portEXIT_CRITICAL(&s_http_lock);
+        if (!ok) return web_busy(req);
+    } else {
+        portENTER_CRITICAL(&s_http_lock);
+        s_async_body_bytes += body_len;
+        portEXIT_CRITICAL(&s_http_lock);
+    }
+    web_job_t job = { .fd = httpd_req_to_sockfd(req), .method = req->method, .handler = handler, .body_len = body_len };
+    if (httpd_req_get_url_query_str(req, job.query, sizeof(job.query)) != ESP_OK) job.query[0] = 0;
+    // 会话上下文记录代号，工作任务回复时据此确认连接仍是同一个；随会话关闭由 httpd 释放
+    web_sess_t *sess = (web_sess_t*)req->sess_ctx;
+    if (!sess && (sess = (web_sess_t*)malloc(sizeof(*sess))) != NULL) {
+        req->sess_ctx = sess;
+        req->free_ctx = free;
+    }
+    esp_err_t err = ESP_OK;
+    if (!sess || (body_len && !(job.body = (char*)malloc(body_len + 1)))) {
+        httpd_resp_send_500(req);
+        err = ESP_FAIL;
+    } else if (body_len) {
+        err = web_recv_body(req, job.body, body_len);
+    }
+    if (err != ESP_OK) {
+        free(job.body);
+        portENTER_CRITICAL(&s_http_lock);
+        s_async_body_bytes -= body_len;
+        portEXIT_CRITICAL(&s_http_lock);
+        return err;
+    }
+    sess->gen = job.gen = ++s_sess_gen;
+    job.t_enq_us = hal_time_us();
+    if (s_jobs) xQueueSend(s_jobs, &job, 0);
+    else web_run(&job);
+    return ESP_OK;
+}
+
+// /api/http：异步处理统计
+static esp_err_t api_http(httpd_req_t *req){
+    portENTER_CRITICAL(&s_http_lock);
+    uint32_t done = s_async_done, busy = s_async_busy, wait = s_async_max_wait_us, run = s_async_max_run_us;
+    size_t body = s_async_body_bytes;
+    portEXIT_CRITICAL(&s_http_lock);
+    char buf[256];
+    snprintf(buf, sizeof(buf), "{\"async\":%s,\"workers\":%d,\"queue\":%d,\"queued\":%d,\"done\":%lu,\"busy\":%lu,"
+             "\"max_wait_us\":%lu,\"max_run_us\":%lu,\"body_bytes\":%u}",
+             s_jobs ? "true" : "false", WEB_WORKERS, WEB_QUEUE_LEN,
+             s_jobs ? (int)uxQueueMessagesWaiting(s_jobs) : 0, (unsigned long)done, (unsigned long)busy,
+             (unsigned long)wait, (unsigned long)run, (unsigned)body);
+    httpd_resp_set_type(req, "application/json");
+    return httpd_resp_sendstr(req, buf);
+}
+
+// /api/selftest：外设基准（约 1 s，不操作加热输出），报告同时输出到控制台
+// 回环 HTTP 只在工作任务上测（服务任务内发起会等待自身）；flash 只在无 OTA 会话/待切换镜像时测
+static void api_selftest(web_job_t *job){
+    bool flash = false;
+    if (xSemaphoreTake(s_ota_lock, 0) == pdTRUE) {
+        ota_status_t st;
+        ota_update_get_status(&st);
+        flash = st.state == OTA_STATE_IDLE || st.state == OTA_STATE_FAILED;
+        if (!flash) xSemaphoreGive(s_ota_lock);
+    }
+    hw_bench_cfg_t cfg = {
+        .http_port = s_jobs ? s_port : 0,
+        .flash_bytes = flash ? HW_BENCH_FLASH_BYTES : 0,
+    };
+    char *buf = malloc(HW_BENCH_REPORT_MAX);
+    esp_err_t err = buf ? hw_bench_run(&cfg, buf, HW_BENCH_REPORT_MAX) : ESP_ERR_NO_MEM;
+    if (flash) xSemaphoreGive(s_ota_lock);
+    if (err == ESP_ERR_INVALID_STATE) web_job_reply(job, "409 Conflict", "{\"error\":\"busy\"}");
+    else if (err != ESP_OK) web_job_reply(job, "500 Internal Server Error", "{}");
+    else web_job_reply(job, NULL, buf);
+    free(buf);
+}
+
+// ===== 路由表：按 path 字典序排列，二分查找；以 '*' 结尾的为前缀路由 =====
+#define RT_GET   0x01
+#define RT_POST  0x02
+
+typedef struct {
+    const char *path;
+    uint8_t methods;        // RT_GET | RT_POST
+    uint32_t max_body;      // 允许的最大请求体 (B)，0 表示不接受请求体
+    esp_err_t (*handler)(httpd_req_t *req);   // 在服务任务执行
+    void (*async)(web_job_t *job);            // 非空时交给工作任务执行（阻塞/访问慢速硬件）
+} api_route_t;
+
+static const api_route_t ROUTES[] = {
+    { "/",                RT_GET,            0,   on_index },
+    { "/api/battery",     RT_GET | RT_POST,  64,  api_battery },
+    { "/api/beep",        RT_POST,           64,  NULL, api_beep },
+    { "/api/boot",        RT_GET,            0,   api_boot },
+    { "/api/capture",     RT_GET | RT_POST,  64,  api_capture },
+    { "/api/http",        RT_GET,            0,   api_http },
+    { "/api/led",         RT_GET | RT_POST,  64,  api_led },
+    { "/api/oled",        RT_GET | RT_POST,  256, NULL, api_oled },
+    { "/api/ota",         RT_GET | RT_POST,  WEB_ASYNC_BODY_MAX, NULL, api_ota },
+    { "/api/ota/abort",   RT_POST,           0,   api_ota_abort },
+    { "/api/ota/apply",   RT_POST,           0,   api_ota_apply },
+#if PERF_STATS_ENABLE
+    { "/api/perf",        RT_GET | RT_POST,  64,  api_perf },
+#endif
+    { "/api/pid/params",  RT_POST,           256, api_pid_params },
+    { "/api/pid/start",   RT_POST,           64,  api_pid_start },
+    { "/api/pid/status",  RT_GET,            0,   api_pid_status },
+    { "/api/pid/stop",    RT_POST,           64,  api_pid_stop },
+    { "/api/relay",       RT_GET | RT_POST,  128, api_relay },
+    { "/api/safety",      RT_GET | RT_POST,  64,  api_safety },
+    { "/api/selftest",    RT_POST,           0,   NULL, api_selftest },
+    { "/api/sys",         RT_GET,            0,   NULL, api_sys },
+    { "/api/telemetry",   RT_GET | RT_POST,  128, api_telemetry },
+    { "/api/temp",        RT_GET | RT_POST,  64,  api_temp },
+    { "/api/trace",       RT_GET,            0,   api_trace },
+    { "/api/trace/level", RT_GET | RT_POST,  256, api_trace_level },
+    { "/api/zone/*",      RT_GET | RT_POST,  256, api_zone },
+    { "/api/zones",       RT_GET,            0,   api_zones },
+    { "/app.js",          RT_GET,            0,   on_js },
+    { "/styles.css",      RT_GET,            0,   on_css },
+};
+#define ROUTE_COUNT (sizeof(ROUTES) / sizeof(ROUTES[0]))
+
+// 比较 path 与长度为 n 的 URI 片段（不要求 URI 以 0 结尾）
+static int route_cmp(const char *path, const char *uri, size_t n){
+    int c = strncmp(path, uri, n);
+    if (c != 0) return c;
+    return path[n] ? 1 : 0;
+}
 
+static const api_route_t *route_find(const char *uri){
+    size_t n = strcspn(uri, "?");
+    int lo = 0, hi = (int)ROUTE_COUNT - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int c = route_cmp(ROUTES[mid].path, uri, n);
+        if (c == 0) return &ROUTES[mid];
+        if (c < 0) lo = mid + 1; else hi = mid - 1;
+    }
+    // 前缀路由很少，顺序匹配即可
+    for (size_t i = 0; i < ROUTE_COUNT; i++) {
+        const char *star = strchr(ROUTES[i].path, '*');
+        if (star && strncmp(ROUTES[i].path, uri, (size_t)(star - ROUTES[i].path)) == 0 &&
+            (size_t)(star - ROUTES[i].path) <= n) return &ROUTES[i];
+    }
+    return NULL;
+}
+
+// 唯一注册的处理函数：统一 CORS、OPTIONS 预检、方法与请求体长度检查后分发
+// 异步路由的响应由工作任务自行拼出 CORS 头（见 web_job_reply）
+static esp_err_t api_dispatch(httpd_req_t *req){
+    const api_route_t *rt = route_find(req->uri);
+    uint8_t m = req->method == HTTP_GET ? RT_GET : req->method == HTTP_POST ? RT_POST : 0;
+    set_cors(req);
+    if (!rt) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "no such endpoint");
+        return ESP_FAIL;
+    }
+    if (req->method == HTTP_OPTIONS) return httpd_resp_sendstr(req, "");
+    if (!(rt->methods & m)) {
+        httpd_resp_send_err(req, HTTPD_405_METHOD_NOT_ALLOWED, "method not allowed");
+        return ESP_FAIL;
+    }
+    if (req->content_len > rt->max_body) {
+        httpd_resp_set_status(req, "413 Payload Too Large");
+        httpd_resp_sendstr(req, "{\"error\":\"body too large\"}");
+        return ESP_FAIL;
+    }
+    if (rt->async) return web_submit(req, rt->async);
+    return rt->handler(req);
+}
+
+uint16_t web_server_port(void){ return s_port; }
+
+esp_err_t web_server_start(void){
+    // 启动时校验路由表有序（新增路由需按字典序插入）
+    for (size_t i = 1; i < ROUTE_COUNT; i++) {
+        if (strcmp(ROUTES[i - 1].path, ROUTES[i].path) >= 0) {
+            ESP_LOGE(TAG, "route table not sorted at %s", ROUTES[i].path);
+        }
+    }
+    s_ota_lock = xSemaphoreCreateMutex();
+    s_jobs = xQueueCreate(WEB_QUEUE_LEN, sizeof(web_job_t));
+    for (int i = 0; s_jobs && i < WEB_WORKERS; i++) {
+        char name[12];
+        snprintf(name, sizeof(name), "http_wk%d", i);
+        xTaskCreate(web_worker, name, WEB_WORKER_STACK, NULL, WEB_WORKER_PRIO, NULL);
+    }
+    if (!s_jobs) ESP_LOGW(TAG, "no worker queue, async routes run on the server task");
+    httpd_config_t cfg = HTTPD_DEFAULT_CONFIG();
+    cfg.lru_purge_enable = true;
+    cfg.max_open_sockets = WEB_WORKERS + WEB_QUEUE_LEN + WEB_SYNC_SOCKETS;
+    // 全部路由经 api_dispatch 分发，每种方法只注册一个通配处理函数
+    cfg.max_uri_handlers = 3;
+    cfg.uri_match_fn = httpd_uri_match_wildcard;
+    esp_err_t err = httpd_start(&s_server, &cfg);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "httpd_start failed: %d", err);
+        return err;
+    }
+    s_port = cfg.server_port;
+    static const httpd_method_t methods[] = { HTTP_GET, HTTP_POST, HTTP_OPTIONS };
+    for (size_t i = 0; i < sizeof(methods) / sizeof(methods[0]); i++) {
+        httpd_uri_t u = { .uri = "/*", .method = methods[i], .handler = api_dispatch };
+        httpd_register_uri_handler(s_server, &u);
+    }
+    ESP_LOGI(TAG, "web server started (%d routes)", (int)ROUTE_COUNT);
+    return ESP_OK;
+}
@@ -1,7 +1,13 @@
 #ifndef WEB_SERVER_H
 #define WEB_SERVER_H
 
-void web_server_start(void);
+#include <stdint.h>
+#include "esp_err.h"
+
+// 失败（httpd 未启动）返回错误
+esp_err_t web_server_start(void);
+// 监听端口；未启动返回 0
+uint16_t web_server_port(void);
 
 #endif
 
@@ -0,0 +1,586 @@
+#include "zone_bank.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "../Hardware/temperature.h"
+#include "../Hardware/relay.h"
+#include "../Hardware/rgb.h"
+#include "../Hardware/buzzer.h"
+#include "../Hardware/display.h"
+#include "../Hardware/hal.h"
+#include "../Hardware/sensors.h"
+#include "perf_stats.h"
+#include "trace.h"
+#include "capture.h"
+#include "safety.h"
+
+static const char *TAG = "ZONE";
+
+// ===== 温区组（结构数组：同一字段连续存放，控制循环按字段顺序扫过） =====
+static pid_bank_t s_pid;                    // 增益/设定/限幅/积分/历史
+static int8_t s_adc_ch[ZONE_MAX];
+static int8_t s_out_ch[ZONE_MAX];
+static float s_max_temp[ZONE_MAX];
+static int s_raw[ZONE_MAX];
+static float s_temp[ZONE_MAX];
+static float s_prev_temp[ZONE_MAX];
+static float s_output[ZONE_MAX];
+static int s_count = 0;
+static float s_slope[ZONE_MAX];             // dT/dt 滤波值 (°C/s)
+static volatile uint32_t s_running = 0;     // 运行位图（自动）
+static volatile uint32_t s_manual = 0;      // 手动位图：只采样、告警并跟踪实际输出
+// 运行/手动位图的修改与控制任务的“检查运行位 + 写输出”互斥：停止后写的 0 不会被本周期的旧输出覆盖
+static portMUX_TYPE s_run_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t s_mpc_mask = 0;    // 自动控制用显式 MPC 的温区
+static volatile uint32_t s_mpc_reset = 0;   // 待初始化的 MPC 状态（控制任务中执行，避免与计算并发）
+static mpc_state_t s_mpc[ZONE_MAX];
+
+// 级联温区：s_pid 为外环（输出 = 元件目标 °C），s_inner 为内环（输出 = 加热 %）
+static pid_bank_t s_inner;
+static volatile uint32_t s_cascade_mask = 0;
+static volatile uint32_t s_outer_due = 0;   // 全新起动后首个周期立即计算外环
+static int8_t s_elem_ch[ZONE_MAX];
+static float s_elem_max[ZONE_MAX];
+static float s_elem_temp[ZONE_MAX];
+static float s_elem_sp[ZONE_MAX];
+static int16_t s_inner_ms[ZONE_MAX];
+static int16_t s_outer_ms[ZONE_MAX];
+static float s_outer_acc_s[ZONE_MAX];       // 距上次外环计算的时间 (s)
+
+// 在线辨识：输入按时间积分，每 PLANT_ID_TS_MS 取平均送入 RLS；模型快照供 API 读取
+static plant_id_t s_id[ZONE_MAX];
+static float s_id_uacc[ZONE_MAX];           // Σ 输出 × dt (%·s)
+static float s_id_tacc[ZONE_MAX];           // Σ dt (s)
+static int64_t s_id_next_us = 0;
+static uint32_t s_id_reset = 0;            // 待重置温区位图，由 s_model_lock 保护
+static plant_model_t s_model[ZONE_MAX];
+static portMUX_TYPE s_model_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t s_task = NULL;
+
+// 自适应周期状态
+static volatile bool s_kick = false;        // 启动/设定变化：立即执行一周期并进入快速档
+static int s_tick_ms = ZONE_TICK_MS;
+static int64_t s_last_tick_us = 0;
+static uint32_t s_last_mask = 0;            // 上一周期参与计算的温区
+static volatile int64_t s_heartbeat_us = 0; // 最近一次控制周期开始时间（安全监控判定停滞）
+
+// OLED 趋势图：跟随显示的温区，切换温区时清空
+static int s_trend_zone = -1;
+static int64_t s_trend_us = 0;
+
+static inline bool zone_valid(int z) { return z >= 0 && z < s_count; }
+
+// 采集缓存温度：未注册、尚无首个采样或超过 SAFETY_SRC_STALE_MS 未更新时按开路处理（同安全监控 check_channel）
+static float zone_sensor_temp(int ch, int64_t now_us, int *raw) {
+    sensor_reading_t r;
+    bool ok = sensors_get(ch, &r) && r.seq != 0 && now_us - r.t_us <= SAFETY_SRC_STALE_MS * 1000LL;
+    if (raw) *raw = r.raw;
+    return ok ? r.value : TEMP_OPEN_C;
+}
+
+// 驱动加热器的那一路 PID（级联为内环），执行器限幅取自它
+static inline pid_bank_t *heater_pid(int z) { return (s_cascade_mask & (1u << z)) ? &s_inner : &s_pid; }
+
+// 无扰跟踪实际输出；级联温区外环跟踪当前元件温度，内环跟踪加热输出
+static void zone_track(int z, float output) {
+    if (s_cascade_mask & (1u << z)) {
+        pid_bank_track(&s_pid, z, s_elem_temp[z], s_temp[z]);
+        s_elem_sp[z] = s_inner.setpoint[z] = s_pid.last_output[z];
+        pid_bank_track(&s_inner, z, output, s_elem_temp[z]);
+    } else {
+        pid_bank_track(&s_pid, z, output, s_temp[z]);
+    }
+}
+
+// 级联：外环按各自周期更新元件目标（其间保持），内环每个控制周期跟随
+static void cascade_compute(uint32_t cascm, float dt_s, float dt_ratio) {
+    for (uint32_t m = cascm; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        s_outer_acc_s[z] += dt_s;
+        // 周期抖动留半个最短周期余量，同趋势图
+        if (!(s_outer_due & (1u << z)) && s_outer_acc_s[z] * 1000.0f + ZONE_TICK_MIN_MS / 2 < s_outer_ms[z]) continue;
+        s_outer_due &= ~(1u << z);
+        pid_compute_bank(&s_pid, 1u << z, s_temp, s_elem_sp, s_outer_acc_s[z] * 1000.0f / PID_NOMINAL_DT_MS);
+        s_outer_acc_s[z] = 0.0f;
+        s_inner.setpoint[z] = s_elem_sp[z];
+    }
+    pid_compute_bank(&s_inner, cascm, s_elem_temp, s_output, dt_ratio);
+}
+
+// 单个控制周期：按阶段批量处理 mask 中的所有温区（自动与手动），PID 只计算自动温区
+static void zone_tick(uint32_t mask) {
+    PERF_BEGIN(t_tick);
+    // 实际周期：上一周期无运行温区（刚启动）时按名义周期计
+    int64_t now_us = hal_time_us();
+    s_heartbeat_us = now_us;
+    float dt_s = s_last_mask ? (float)(now_us - s_last_tick_us) * 1e-6f : ZONE_TICK_MS / 1000.0f;
+    s_last_tick_us = now_us;
+
+    // 读取采集服务缓存（采样/换算已在 sensors 任务完成，这里不访问 ADC）
+    PERF_BEGIN(t_adc);
+    for (uint32_t m = mask; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        s_prev_temp[z] = s_temp[z];
+        s_temp[z] = zone_sensor_temp(s_adc_ch[z], now_us, &s_raw[z]);
+        if (s_cascade_mask & (1u << z)) s_elem_temp[z] = zone_sensor_temp(s_elem_ch[z], now_us, NULL);
+    }
+    PERF_END(PERF_STAGE_ADC, t_adc);
+
+    PERF_BEGIN(t_ntc);
+    for (uint32_t m = mask; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        // 上一周期实际驱动的输出在本周期 dt 内保持；新加入的温区历史中断，辨识重新对齐
+        if (s_last_mask & (1u << z)) {
+            s_id_uacc[z] += relay_get_output_percent_f(s_out_ch[z]) * dt_s;
+            s_id_tacc[z] += dt_s;
+        } else {
+            plant_id_resync(&s_id[z]);
+            s_id_uacc[z] = s_id_tacc[z] = 0.0f;
+        }
+        // 升降温速率一阶滤波；新启动的温区没有上一周期数据，从 0 开始
+        if (s_last_mask & (1u << z)) {
+            s_slope[z] = 0.7f * s_slope[z] + 0.3f * (s_temp[z] - s_prev_temp[z]) / dt_s;
+        } else {
+            s_slope[z] = 0.0f;
+        }
+    }
+    s_last_mask = mask;
+    PERF_END(PERF_STAGE_NTC, t_ntc);
+
+    PERF_BEGIN(t_pid);
+    uint32_t autom = mask & s_running;
+    // 传感器开路/短路（999/-999）的自动温区不参与 PID 也不跟踪实际输出，输出置 0，由安全监控判定是否切断；级联温区含元件 NTC
+    uint32_t fault = 0;
+    for (uint32_t m = autom; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        if (!temperature_valid(s_temp[z]) || ((s_cascade_mask & (1u << z)) && !temperature_valid(s_elem_temp[z]))) {
+            fault |= 1u << z;
+            s_output[z] = 0.0f;
+        }
+    }
+    autom &= ~fault;
+    uint32_t mpcm = autom & s_mpc_mask;
+    uint32_t cascm = autom & ~mpcm & s_cascade_mask;
+    uint32_t pidm = autom & ~mpcm & ~cascm;
+    float dt_ratio = dt_s * 1000.0f / PID_NOMINAL_DT_MS;
+    capture_sync_state(&s_pid, s_count);
+    pid_compute_bank(&s_pid, pidm, s_temp, s_output, dt_ratio); // 0~100
+    capture_tick(pidm, dt_ratio, s_raw, s_temp, s_output);
+    cascade_compute(cascm, dt_s, dt_ratio);
+    // MPC 温区：按表的采样周期查表，其间保持；PID 积分跟踪其输出，切回 PID 时无扰
+    for (uint32_t m = mpcm; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        if (s_mpc_reset & (1u << z)) {
+            s_mpc_reset &= ~(1u << z);
+            mpc_reset(&s_mpc[z], &MPC_TABLE, s_temp[z], relay_get_output_percent_f(s_out_ch[z]));
+        }
+        float u = mpc_step(&s_mpc[z], now_us, s_temp[z], s_pid.setpoint[z]);
+        const pid_bank_t *h = heater_pid(z);
+        s_output[z] = u < h->out_min[z] ? h->out_min[z] : (u > h->out_max[z] ? h->out_max[z] : u);
+        zone_track(z, s_output[z]);
+    }
+    // 手动温区：积分跟踪实际输出，切回自动时无扰
+    for (uint32_t m = mask & ~autom & ~fault; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        s_output[z] = relay_get_output_percent_f(s_out_ch[z]);
+        zone_track(z, s_output[z]);
+    }
+    PERF_END(PERF_STAGE_PID, t_pid);
+
+    PERF_BEGIN(t_out);
+    bool over = false;
+    for (uint32_t m = mask; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        // 写出前再确认一次：API/安全监控可能刚把该温区停止或切到手动
+        portENTER_CRITICAL(&s_run_lock);
+        if (s_running & (1u << z)) relay_set_output_percent_f(s_out_ch[z], s_output[z]);
+        portEXIT_CRITICAL(&s_run_lock);
+        if (s_temp[z] > s_max_temp[z] && temperature_valid(s_temp[z])) over = true;
+        if ((s_cascade_mask & (1u << z)) && s_elem_temp[z] > s_elem_max[z] && temperature_valid(s_elem_temp[z])) over = true;
+    }
+
+    // 超温告警：红灯+蜂鸣（非阻塞，按周期开关）；未超温：绿灯，蜂鸣关闭
+    set_rgb(over ? 255 : 0, over ? 0 : 255, 0);
+    buzzer_set(over && (now_us / 500000) % 2 == 0);
+    PERF_END(PERF_STAGE_OUTPUT, t_out);
+
+    // OLED 仪表盘显示编号最小的运行温区：大号实时温度 + 设定/限值、PID 参数、输出
+    int z0 = __builtin_ctz(mask);
+    {
+        PERF_BEGIN(t_oled);
+        if (z0 != s_trend_zone) {
+            display_trend_reset();
+            s_trend_zone = z0;
+            s_trend_us = now_us - ZONE_TREND_PERIOD_MS * 1000LL;
+        }
+        int64_t since = now_us - s_trend_us;
+        if (since + ZONE_TICK_MIN_MS * 500LL >= ZONE_TREND_PERIOD_MS * 1000LL) {
+            // 落后超过一个间隔（控制曾暂停）时重新对齐，否则按固定间隔推进
+            s_trend_us = since >= 2 * ZONE_TREND_PERIOD_MS * 1000LL ? now_us : s_trend_us + ZONE_TREND_PERIOD_MS * 1000LL;
+            display_trend_push(s_temp[z0], s_pid.setpoint[z0]);
+        }
+        char big[16], l1[28], l2[28], l3[28];
+        snprintf(big, sizeof(big), "%.1f\xC2\xB0""C", s_temp[z0]);
+        snprintf(l1, sizeof(l1), "Set %.1f Max %.1f", s_pid.setpoint[z0], s_max_temp[z0]);
+        if (s_mpc_mask & (1u << z0)) {
+            snprintf(l2, sizeof(l2), "MPC Ts%.0fs reg %d", MPC_TABLE.ts_s, s_mpc[z0].last_region);
+        } else if (s_cascade_mask & (1u << z0)) {
+            snprintf(l2, sizeof(l2), "Elem %.1f>%.1f", s_elem_temp[z0], s_elem_sp[z0]);
+        } else {
+            snprintf(l2, sizeof(l2), "Kp%.2f Ki%.3f Kd%.2f", s_pid.Kp[z0], s_pid.Ki[z0], s_pid.Kd[z0]);
+        }
+        snprintf(l3, sizeof(l3), "Out %3.0f%%  Zone %d", s_output[z0], z0);
+        display_dashboard(big, l1, l2, l3);
+        PERF_END(PERF_STAGE_OLED, t_oled);
+    }
+
+    // 在线辨识：固定采样周期，与控制周期无关（周期抖动留半个最短周期余量，同趋势图）
+    if (now_us - s_id_next_us + ZONE_TICK_MIN_MS * 500LL >= 0) {
+        s_id_next_us = now_us - s_id_next_us >= PLANT_ID_TS_MS * 1000LL ? now_us + PLANT_ID_TS_MS * 1000LL
+                                                                         : s_id_next_us + PLANT_ID_TS_MS * 1000LL;
+        for (uint32_t m = mask; m; m &= m - 1) {
+            int z = __builtin_ctz(m);
+            portENTER_CRITICAL(&s_model_lock);
+            bool reset = s_id_reset & (1u << z);
+            s_id_reset &= ~(1u << z);
+            portEXIT_CRITICAL(&s_model_lock);
+            if (reset) {
+                plant_id_reset(&s_id[z]);
+            } else if (s_id_tacc[z] > 0.0f && temperature_valid(s_temp[z])) {
+                plant_id_update(&s_id[z], s_temp[z], s_id_uacc[z] / s_id_tacc[z]);
+            }
+            s_id_uacc[z] = s_id_tacc[z] = 0.0f;
+            plant_model_t pm;
+            plant_id_model(&s_id[z], &pm);
+            // 其间又收到重置请求时不覆盖已清零的模型，下个辨识周期先重置
+            portENTER_CRITICAL(&s_model_lock);
+            if (!(s_id_reset & (1u << z))) s_model[z] = pm;
+            portEXIT_CRITICAL(&s_model_lock);
+        }
+    }
+
+    PERF_BEGIN(t_log);
+    for (uint32_t m = autom; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        TRACE(PID_LOOP, trace_i(z), trace_f(s_pid.setpoint[z]), trace_f(s_temp[z]), trace_f(s_output[z]));
+    }
+    PERF_END(PERF_STAGE_LOG, t_log);
+    PERF_END(PERF_STAGE_TICK, t_tick);
+}
+
+// 下一周期：任一温区处于动态过程则最快；全部稳态则每周期放慢 1.5 倍直至上限；其余为常规周期
+static int next_tick_ms(uint32_t mask, int cur) {
+    bool fast = s_kick, steady = true;
+    s_kick = false;
+    for (uint32_t m = mask; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        float err = fabsf(s_pid.setpoint[z] - s_temp[z]);
+        float slope = fabsf(s_slope[z]);
+        if (err > ZONE_FAST_ERR_C || slope > ZONE_FAST_SLOPE_CPS) fast = true;
+        if (err > ZONE_STEADY_ERR_C || slope > ZONE_STEADY_SLOPE_CPS) steady = false;
+    }
+    int next;
+    if (fast) {
+        next = ZONE_TICK_MIN_MS;
+    } else if (!steady) {
+        next = ZONE_TICK_MS;
+    } else {
+        next = cur < ZONE_TICK_MS ? ZONE_TICK_MS : cur * 3 / 2;
+        if (next > ZONE_TICK_MAX_MS) next = ZONE_TICK_MAX_MS;
+    }
+    // 级联温区：不长于其内环周期
+    for (uint32_t m = mask & s_cascade_mask; m; m &= m - 1) {
+        int z = __builtin_ctz(m);
+        if (next > s_inner_ms[z]) next = s_inner_ms[z];
+    }
+    return next;
+}
+
+// ===== 控制任务：常驻，一个任务服务全部温区；无运行温区时阻塞等待通知 =====
+static void zone_control_task(void *arg) {
+    for (;;) {
+        uint32_t mask = s_running | s_manual;
+        if (!mask) {
+            s_last_mask = 0;
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        zone_tick(mask);
+        s_tick_ms = next_tick_ms(mask, s_tick_ms);
+        // 启动/设定变化的通知会提前结束等待
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(s_tick_ms));
+    }
+}
+
+int zone_bank_add(const zone_config_t *cfg) {
+    if (s_count >= ZONE_MAX) {
+        ESP_LOGE(TAG, "zone bank full (max %d)", ZONE_MAX);
+        return -1;
+    }
+    int z = s_count;
+    // 外部源的周期由采集服务按器件转换时间放宽
+    esp_err_t err;
+    if (cfg->source) {
+        err = sensors_add_source(cfg->adc_channel, cfg->source, SENSOR_NTC_PERIOD_MS);
+    } else {
+        temperature_add_channel(cfg->adc_channel);
+        err = sensors_add_channel(cfg->adc_channel, SENSOR_NTC, SENSOR_NTC_PERIOD_MS);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "zone %d: sensor %d register failed: %d", z, cfg->adc_channel, err);
+        return -1;
+    }
+    const zone_cascade_cfg_t *c = &cfg->cascade;
+    if (c->enable) {
+        if (!(c->element_max > c->element_min)) {
+            ESP_LOGE(TAG, "zone %d: cascade element limits invalid", z);
+            return -1;
+        }
+        // 元件 NTC 与产品 NTC 走同一 ADC 单次转换配置与采集服务
+        temperature_add_channel(c->element_channel);
+        err = sensors_add_channel(c->element_channel, SENSOR_NTC, SENSOR_NTC_PERIOD_MS);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "zone %d: element sensor %d register failed: %d", z, c->element_channel, err);
+            return -1;
+        }
+    }
+    s_adc_ch[z] = (int8_t)cfg->adc_channel;
+    s_out_ch[z] = (int8_t)cfg->output;
+    s_max_temp[z] = cfg->max_temp;
+    pid_bank_init(&s_pid, z, cfg->kp, cfg->ki, cfg->kd, cfg->setpoint);
+    if (cfg->out_max > cfg->out_min) {
+        s_pid.out_min[z] = cfg->out_min;
+        s_pid.out_max[z] = cfg->out_max;
+    }
+    if (c->enable) {
+        // 执行器限幅移到内环，外环输出限为元件目标范围
+        pid_bank_init(&s_inner, z, c->kp, c->ki, c->kd, c->element_min);
+        s_inner.out_min[z] = s_pid.out_min[z];
+        s_inner.out_max[z] = s_pid.out_max[z];
+        s_pid.out_min[z] = c->element_min;
+        s_pid.out_max[z] = c->element_max;
+        s_elem_ch[z] = (int8_t)c->element_channel;
+        s_elem_max[z] = c->element_max;
+        s_elem_temp[z] = sensors_value(c->element_channel);
+        s_elem_sp[z] = c->element_min;
+        int inner = c->inner_ms > 0 ? c->inner_ms : ZONE_CASCADE_INNER_MS;
+        int outer = c->outer_ms > 0 ? c->outer_ms : ZONE_CASCADE_OUTER_MS;
+        s_inner_ms[z] = (int16_t)(inner < ZONE_TICK_MIN_MS ? ZONE_TICK_MIN_MS : inner);
+        s_outer_ms[z] = (int16_t)(outer > 10 * PID_NOMINAL_DT_MS ? 10 * PID_NOMINAL_DT_MS : outer);
+        s_cascade_mask |= 1u << z;
+    }
+    if (cfg->ctl == ZONE_CTL_MPC) s_mpc_mask |= 1u << z;
+    plant_id_reset(&s_id[z]);
+    s_temp[z] = sensors_value(cfg->adc_channel);
+    relay_init_pwm_output(cfg->output, cfg->output_gpio, 1000);
+    if (cfg->modulation.mode != RELAY_MODE_PWM || cfg->modulation.dither) relay_set_output_mode(cfg->output, &cfg->modulation);
+    s_count++;
+    ESP_LOGI(TAG, "zone %d: %s=%d out=%d gpio=%d mode=%d", z, cfg->source ? cfg->source->name : "adc", cfg->adc_channel,
+             cfg->output, cfg->output_gpio, (int)cfg->modulation.mode);
+    if (c->enable) {
+        ESP_LOGI(TAG, "zone %d: cascade element=%d %.0f~%.0fC inner %dms outer %dms", z, c->element_channel,
+                 c->element_min, c->element_max, s_inner_ms[z], s_outer_ms[z]);
+    }
+    return z;
+}
+
+int zone_bank_count(void) { return s_count; }
+
+static void zone_task_wake(void) {
+    s_kick = true;
+    s_heartbeat_us = hal_time_us();
+    if (!s_task) {
+        xTaskCreate(zone_control_task, "pid_task", 4096, NULL, 5, &s_task);
+    } else {
+        xTaskNotifyGive(s_task);
+    }
+}
+
+bool zone_bank_start(int zone) {
+    if (!zone_valid(zone)) return false;
+    if (safety_latched()) {
+        ESP_LOGW(TAG, "zone %d start refused: safety fault latched", zone);
+        return false;
+    }
+    if (s_running & (1u << zone)) return true;
+    if (s_manual & (1u << zone)) {
+        // 手动 -> 自动：从执行器当前输出继续（手动期间积分已在跟踪，这里按最新值再对齐一次）
+        s_output[zone] = relay_get_output_percent_f(s_out_ch[zone]);
+        zone_track(zone, s_output[zone]);
+    } else {
+        // 停止 -> 自动：全新起动，积分清零，微分从当前温度起算（停止期间 s_temp 未更新，取采集缓存）
+        int64_t now_us = hal_time_us();
+        s_temp[zone] = zone_sensor_temp(s_adc_ch[zone], now_us, NULL);
+        s_pid.integral[zone] = 0.0f;
+        s_pid.last_input[zone] = s_temp[zone];
+        if (s_cascade_mask & (1u << zone)) {
+            s_elem_temp[zone] = zone_sensor_temp(s_elem_ch[zone], now_us, NULL);
+            s_inner.integral[zone] = 0.0f;
+            s_inner.last_input[zone] = s_elem_temp[zone];
+            s_outer_acc_s[zone] = 0.0f;
+            s_outer_due |= 1u << zone;
+        }
+    }
+    s_mpc_reset |= 1u << zone;
+    portENTER_CRITICAL(&s_run_lock);
+    s_manual &= ~(1u << zone);
+    s_running |= 1u << zone;
+    portEXIT_CRITICAL(&s_run_lock);
+    capture_mark_dirty(zone);
+    zone_task_wake();
+    return true;
+}
+
+void zone_bank_stop(int zone) {
+    if (!zone_valid(zone)) return;
+    portENTER_CRITICAL(&s_run_lock);
+    s_running &= ~(1u << zone);
+    s_manual &= ~(1u << zone);
+    relay_set_output_percent(s_out_ch[zone], 0);
+    portEXIT_CRITICAL(&s_run_lock);
+}
+
+bool zone_bank_running(int zone) { return zone_valid(zone) && (s_running & (1u << zone)); }
+
+bool zone_bank_set_manual(int zone) {
+    if (!zone_valid(zone) || safety_latched()) return false;
+    if (s_manual & (1u << zone)) return true;
+    portENTER_CRITICAL(&s_run_lock);
+    s_running &= ~(1u << zone);
+    s_manual |= 1u << zone;
+    portEXIT_CRITICAL(&s_run_lock);
+    zone_task_wake();
+    return true;
+}
+
+bool zone_bank_manual(int zone) { return zone_valid(zone) && (s_manual & (1u << zone)); }
+
+void zone_bank_set_ctl(int zone, zone_ctl_t ctl) {
+    if (!zone_valid(zone) || ctl == zone_bank_ctl(zone)) return;
+    if (ctl == ZONE_CTL_MPC) {
+        s_mpc_reset |= 1u << zone;
+        s_mpc_mask |= 1u << zone;
+    } else {
+        s_mpc_mask &= ~(1u << zone);
+    }
+    capture_mark_dirty(zone);
+    ESP_LOGI(TAG, "zone %d control -> %s", zone, ctl == ZONE_CTL_MPC ? "mpc" : "pid");
+    s_kick = true;
+    if (s_task) xTaskNotifyGive(s_task);
+}
+
+zone_ctl_t zone_bank_ctl(int zone) {
+    return (zone_valid(zone) && (s_mpc_mask & (1u << zone))) ? ZONE_CTL_MPC : ZONE_CTL_PID;
+}
+
+void zone_bank_get_pid(int zone, PID_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (!zone_valid(zone)) return;
+    out->Kp = s_pid.Kp[zone];
+    out->Ki = s_pid.Ki[zone];
+    out->Kd = s_pid.Kd[zone];
+    out->setpoint = s_pid.setpoint[zone];
+    out->integral = s_pid.integral[zone];
+    out->last_input = s_pid.last_input[zone];
+    out->last_error = s_pid.setpoint[zone] - s_pid.last_input[zone];
+}
+
+void zone_bank_set_params(int zone, float setpoint, float kp, float ki, float kd) {
+    if (!zone_valid(zone)) return;
+    // 增益变化：按原设定值反推积分，保持当前输出；之后设定值变化照常产生比例响应
+    if (kp != s_pid.Kp[zone] || ki != s_pid.Ki[zone] || kd != s_pid.Kd[zone]) pid_bank_retune(&s_pid, zone, kp, ki, kd);
+    s_pid.setpoint[zone] = setpoint;
+    capture_mark_dirty(zone);
+    s_kick = true;
+    if (s_task) xTaskNotifyGive(s_task);
+}
+
+void zone_bank_set_max_temp(int zone, float max_temp) {
+    if (zone_valid(zone)) s_max_temp[zone] = max_temp;
+}
+
+void zone_bank_get_inner(int zone, PID_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (!zone_valid(zone) || !(s_cascade_mask & (1u << zone))) return;
+    out->Kp = s_inner.Kp[zone];
+    out->Ki = s_inner.Ki[zone];
+    out->Kd = s_inner.Kd[zone];
+    out->setpoint = s_inner.setpoint[zone];
+    out->integral = s_inner.integral[zone];
+    out->last_input = s_inner.last_input[zone];
+    out->last_error = s_inner.setpoint[zone] - s_inner.last_input[zone];
+}
+
+void zone_bank_set_inner(int zone, float kp, float ki, float kd) {
+    if (!zone_valid(zone) || !(s_cascade_mask & (1u << zone))) return;
+    if (kp == s_inner.Kp[zone] && ki == s_inner.Ki[zone] && kd == s_inner.Kd[zone]) return;
+    pid_bank_retune(&s_inner, zone, kp, ki, kd);
+    s_kick = true;
+    if (s_task) xTaskNotifyGive(s_task);
+}
+
+int zone_bank_tick_ms(void) { return s_tick_ms; }
+
+void zone_bank_get_model(int zone, plant_model_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (!zone_valid(zone)) return;
+    portENTER_CRITICAL(&s_model_lock);
+    *out = s_model[zone];
+    portEXIT_CRITICAL(&s_model_lock);
+}
+
+bool zone_bank_apply_model(int zone) {
+    plant_model_t pm;
+    zone_bank_get_model(zone, &pm);
+    if (!pm.valid || (s_cascade_mask & (1u << zone))) return false;
+    ESP_LOGI(TAG, "zone %d retune from model K=%.3f tau=%.0fs dead=%.0fs -> Kp=%.2f Ki=%.4f Kd=%.2f",
+             zone, pm.gain, pm.tau_s, pm.dead_s, pm.kp, pm.ki, pm.kd);
+    zone_bank_set_params(zone, s_pid.setpoint[zone], pm.kp, pm.ki, pm.kd);
+    return true;
+}
+
+void zone_bank_reset_model(int zone) {
+    if (!zone_valid(zone)) return;
+    portENTER_CRITICAL(&s_model_lock);
+    s_id_reset |= 1u << zone;
+    memset(&s_model[zone], 0, sizeof(s_model[zone]));
+    portEXIT_CRITICAL(&s_model_lock);
+}
+
+float zone_bank_max_temp(int zone) { return zone_valid(zone) ? s_max_temp[zone] : 0.0f; }
+
+uint32_t zone_bank_active_mask(void) { return s_running | s_manual; }
+
+int64_t zone_bank_heartbeat_us(void) { return s_heartbeat_us; }
+
+int zone_bank_adc_channel(int zone) { return zone_valid(zone) ? s_adc_ch[zone] : -1; }
+
+int zone_bank_element_channel(int zone) {
+    return (zone_valid(zone) && (s_cascade_mask & (1u << zone))) ? s_elem_ch[zone] : -1;
+}
+
+float zone_bank_element_max(int zone) {
+    return (zone_valid(zone) && (s_cascade_mask & (1u << zone))) ? s_elem_max[zone] : 0.0f;
+}
+
+void zone_bank_get_status(int zone, zone_status_t *out) {
+    memset(out, 0, sizeof(*out));
+    if (!zone_valid(zone)) return;
+    out->running = (s_running & (1u << zone)) != 0;
+    out->manual = (s_manual & (1u << zone)) != 0;
+    out->ctl = zone_bank_ctl(zone);
+    out->temp = s_temp[zone];
+    out->output = s_output[zone];
+    out->adc_raw = s_raw[zone];
+    out->max_temp = s_max_temp[zone];
+    out->output_percent = relay_get_output_percent(s_out_ch[zone]);
+    out->cascade = (s_cascade_mask & (1u << zone)) != 0;
+    if (out->cascade) {
+        out->element_temp = s_elem_temp[zone];
+        out->element_sp = s_elem_sp[zone];
+    }
+}
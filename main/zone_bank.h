@@ -0,0 +1,127 @@
+#ifndef ZONE_BANK_H
+#define ZONE_BANK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pid_controller.h"
+#include "mpc_controller.h"
+#include "plant_id.h"
+#include "../Hardware/relay.h"
+#include "../Hardware/temp_source.h"
+
+// 多温区控制：每个温区 = NTC 通道 + 加热输出 + PID 状态 + 限值
+// 所有温区由同一个控制任务在每个周期内批量更新（结构数组布局）
+#define ZONE_MAX PID_BANK_MAX
+
+// 自适应控制周期 (ms)：大误差/快速升降温/设定变化时加快，稳态逐步放慢
+#define ZONE_TICK_MS      PID_NOMINAL_DT_MS   // 常规
+#define ZONE_TICK_MIN_MS  50                  // 动态过程
+#define ZONE_TICK_MAX_MS  1000                // 稳态保温
+// 判定阈值：|误差| (°C) 与 |dT/dt| (°C/s)，任一运行温区满足“快”即加快，全部满足“稳”才放慢
+#define ZONE_FAST_ERR_C        2.0f
+#define ZONE_FAST_SLOPE_CPS    0.5f
+#define ZONE_STEADY_ERR_C      0.3f
+#define ZONE_STEADY_SLOPE_CPS  0.05f
+
+// OLED 趋势图采样间隔（128 列约 2 分钟）；周期抖动留半个最短周期余量，避免 1s 稳态周期时漏采
+#define ZONE_TREND_PERIOD_MS   1000
+
+// 自动控制算法：PID（pid_compute_bank）或显式 MPC（mpc_table.c 查表，适合超调要求严格的对象）
+typedef enum {
+    ZONE_CTL_PID = 0,
+    ZONE_CTL_MPC,
+} zone_ctl_t;
+
+// 级联控制：外环按产品温度（温区的 kp/ki/kd、setpoint）给出加热元件目标温度，
+// 内环按第二路 NTC（贴在加热元件上）以更短周期把元件调到该目标，输出驱动加热器
+// 元件温度远超前于产品：单回路只能降增益防超调；级联时元件目标被 element_max 限住，
+// 供电波动等元件侧扰动由内环在传到产品之前消除
+#define ZONE_CASCADE_INNER_MS  100    // 内环默认周期上限
+#define ZONE_CASCADE_OUTER_MS  1000   // 外环默认周期（不超过 10 个名义周期，见 pid_compute_bank）
+
+typedef struct {
+    bool enable;
+    int element_channel;        // 元件 NTC 的 ADC 通道（分压参数同产品 NTC）
+    float kp, ki, kd;           // 内环增益：% / 元件 °C，按 PID_NOMINAL_DT_MS 整定
+    float element_min, element_max; // 元件目标限幅 (°C)；element_max 另作元件超温阈值（加安全余量）
+    int inner_ms;               // 0 取 ZONE_CASCADE_INNER_MS
+    int outer_ms;               // 0 取 ZONE_CASCADE_OUTER_MS
+} zone_cascade_cfg_t;
+
+// 温区静态配置（main.c 中按硬件填写）
+typedef struct {
+    int adc_channel;     // NTC ADC 通道；使用外部温度源时为其传感器编号 SENSOR_SRC_ID(n)
+    temp_source_t *source; // 外部温度源（热电偶/模拟源）；NULL 为 NTC
+    int output;          // 继电器输出编号（relay_*_output）
+    int output_gpio;     // 输出 GPIO
+    relay_mod_cfg_t modulation; // 输出调制方式（零值为 1kHz PWM）
+    float kp, ki, kd;
+    float setpoint;      // 设定温度 (°C)
+    float max_temp;      // 超温告警阈值 (°C)
+    float out_min, out_max; // 执行器输出限幅 (%)，抗积分饱和按此计算；均为 0 时取 0~100
+    zone_ctl_t ctl;      // 自动控制算法（零值为 PID）
+    zone_cascade_cfg_t cascade; // 级联（零值为单回路）；启用时 kp/ki/kd 为外环增益（元件 °C / 产品 °C）
+} zone_config_t;
+
+// 温区状态快照（供 API/显示读取）
+typedef struct {
+    bool running;
+    bool manual;
+    zone_ctl_t ctl;
+    float temp;
+    float output;
+    int adc_raw;
+    float max_temp;
+    int output_percent;
+    bool cascade;
+    float element_temp;  // 级联：元件温度与外环给出的元件目标 (°C)
+    float element_sp;
+} zone_status_t;
+
+// 注册温区，返回温区编号（失败返回 -1）；温区 0 即原单路 PID
+int zone_bank_add(const zone_config_t *cfg);
+int zone_bank_count(void);
+
+// 启停单个温区；控制任务首次启动时创建并常驻，无运行温区时阻塞
+// 从手动切回自动时按当前实际输出初始化积分（无扰切换）；从停止状态启动为全新起动
+// 安全故障锁存期间拒绝启动（返回 false）
+bool zone_bank_start(int zone);
+void zone_bank_stop(int zone);
+bool zone_bank_running(int zone);
+// 手动：停止自动计算，输出由调用方直接设置（relay_*）；控制任务继续采样、超温告警，积分跟踪实际输出
+bool zone_bank_set_manual(int zone);
+bool zone_bank_manual(int zone);
+// 切换自动控制算法，运行中也可切换：MPC 按当前温度与实际输出初始化模型，PID 积分在 MPC 期间持续跟踪，双向无扰
+void zone_bank_set_ctl(int zone, zone_ctl_t ctl);
+zone_ctl_t zone_bank_ctl(int zone);
+
+// 在线对象辨识（运行与手动温区，每 PLANT_ID_TS_MS 一次）：读取当前模型与 SIMC 建议参数
+void zone_bank_get_model(int zone, plant_model_t *out);
+// 按建议参数整定（保持设定值，无扰）；模型尚无效时返回 false
+bool zone_bank_apply_model(int zone);
+// 级联温区辨识的是整个对象，SIMC 参数不适用于外环，apply 返回 false
+// 丢弃已辨识模型（对象改装后），下一采样周期重新开始
+void zone_bank_reset_model(int zone);
+
+// 参数读写（PID_t 作为单个温区的视图，积分/历史按 pid_compute 语义）
+// 修改增益时输出保持连续（积分吸收 Kp 变化），修改设定值不清积分
+void zone_bank_get_pid(int zone, PID_t *out);
+void zone_bank_set_params(int zone, float setpoint, float kp, float ki, float kd);
+void zone_bank_set_max_temp(int zone, float max_temp);
+// 级联内环：读写增益（无扰，同 set_params）；非级联温区读出全 0、写入忽略
+void zone_bank_get_inner(int zone, PID_t *out);
+void zone_bank_set_inner(int zone, float kp, float ki, float kd);
+void zone_bank_get_status(int zone, zone_status_t *out);
+int zone_bank_adc_channel(int zone);
+// 级联元件 NTC 通道与超温阈值；非级联温区返回 -1 / 0
+int zone_bank_element_channel(int zone);
+float zone_bank_element_max(int zone);
+// 当前控制周期 (ms)
+int zone_bank_tick_ms(void);
+float zone_bank_max_temp(int zone);
+
+// 供安全监控：运行+手动温区位图、最近一次控制周期开始时间 (hal_time_us)
+uint32_t zone_bank_active_mask(void);
+int64_t zone_bank_heartbeat_us(void);
+
+#endif